@@ -10,6 +10,9 @@
 #include <random>
 #include <chrono>
 #include <assert.h>
+#include <algorithm>
+
+const int Level::UNREACHED;
 
 Level::Level() : _currentLevel(1), gameSystem(nullptr) {
 }
@@ -87,6 +90,7 @@ bool Level::load(int num) {
   }
   _currentLevel = num;
   shuffleArmies();
+  initEnemyDistances();
   return true;
 }
 
@@ -105,6 +109,9 @@ void Level::shuffleArmies() {
       _armies[i][j] = _armies[i][rand];
       _armies[i][rand] = tmp;
     }
+    for (int j = 0; j < _armies[i].size(); j++) {
+      _armies[i][j]->setArmyIndex(j);
+    }
   }
 }
 
@@ -198,10 +205,11 @@ void Level::update() {
     anyMoved = false;
     updateCount++;
 
+    buildEnemyDistances();
     for (int j = 0; j < NUM_ARMIES; j++) {
       for (size_t i = 0; i < _armies[j].size(); i++) {
         updateOpenMoves(_armies[j][i]);
-        char move = _armies[j][i]->getMove(_armies, NUM_ARMIES);
+        char move = _armies[j][i]->getMove(*this);
         if (move != '.') {
           processSoldierMove(move, _armies[j][i]);
           anyMoved = true;
@@ -209,23 +217,6 @@ void Level::update() {
       }
     }
 
-    // Remove dead soldiers and update the board
-    for (int j = 0; j < NUM_ARMIES; j++) {
-      for (size_t i = 0; i < _armies[j].size(); ) {
-        if (_armies[j][i]->getHealth() <= 0) {
-          int x, y;
-          _armies[j][i]->getPosition(x, y);
-          setTile(x, y, '.', nullptr);
-          delete _armies[j][i];
-          _armies[j][i] = _armies[j].back();
-          _armies[j].pop_back();
-        }
-        else {
-          i++;
-        }
-      }
-    }
-
     // Update the visual representation
     for (int y = 0; y < levelHeight; y++) {
       for (int x = 0; x < levelWidth; x++) {
@@ -309,12 +300,82 @@ void Level::battle(Soldier* soldier, int targetX, int targetY) {
 
   int result = targetSoldier->takeDamage(soldier->attack());
   if (result == 1) {
-    for (int i = 0; i < _armies[enemyArmy].size(); i++) {
-      if (_armies[enemyArmy][i] == targetSoldier) {
-        _armies[enemyArmy][i] = _armies[enemyArmy].back();
-        _armies[enemyArmy].pop_back();
-        setTile(targetX, targetY, '.', nullptr);
-        break;
+    removeSoldier(targetSoldier);
+  }
+}
+
+void Level::removeSoldier(Soldier* soldier) {
+  // Swap the last soldier into the dead one's slot instead of searching the army
+  std::vector<Soldier*>& army = _armies[soldier->getTeam()];
+  int index = soldier->getArmyIndex();
+  army[index] = army.back();
+  army[index]->setArmyIndex(index);
+  army.pop_back();
+
+  int x, y;
+  soldier->getPosition(x, y);
+  setTile(x, y, '.', nullptr);
+  delete soldier;
+}
+
+void Level::initEnemyDistances() {
+  _fieldHeight = _levelData.size();
+  _fieldWidth = 0;
+  for (int y = 0; y < _fieldHeight; y++) {
+    _fieldWidth = std::max(_fieldWidth, (int)_levelData[y].size());
+  }
+
+  // Walls never move, so only the soldiers have to be looked at each turn
+  _walkable.assign(_fieldWidth * _fieldHeight, false);
+  for (int y = 0; y < _fieldHeight; y++) {
+    for (int x = 0; x < _fieldWidth; x++) {
+      char tile = getTile(x, y);
+      _walkable[y * _fieldWidth + x] = (tile != '#' && tile != '\n');
+    }
+  }
+  _bfsQueue.reserve(_fieldWidth * _fieldHeight);
+}
+
+void Level::buildEnemyDistances() {
+  const int numTiles = _fieldWidth * _fieldHeight;
+
+  // One multi source BFS per army, seeded with every enemy soldier. Walls block it but
+  // soldiers don't, they move out of the way over the turn.
+  for (int army = 0; army < NUM_ARMIES; army++) {
+    std::vector<int>& distances = _enemyDistances[army];
+    distances.assign(numTiles, UNREACHED);
+    _bfsQueue.clear();
+
+    for (int enemyArmy = 0; enemyArmy < NUM_ARMIES; enemyArmy++) {
+      if (enemyArmy == army) {
+        continue;
+      }
+      for (int i = 0; i < _armies[enemyArmy].size(); i++) {
+        int x, y;
+        _armies[enemyArmy][i]->getPosition(x, y);
+        distances[y * _fieldWidth + x] = 0;
+        _bfsQueue.push_back(y * _fieldWidth + x);
+      }
+    }
+
+    for (size_t head = 0; head < _bfsQueue.size(); head++) {
+      const int tile = _bfsQueue[head];
+      const int x = tile % _fieldWidth;
+      const int y = tile / _fieldWidth;
+      const int nextDistance = distances[tile] + 1;
+      const int neighbours[4] = {
+        y > 0 ? tile - _fieldWidth : -1,
+        x > 0 ? tile - 1 : -1,
+        y < _fieldHeight - 1 ? tile + _fieldWidth : -1,
+        x < _fieldWidth - 1 ? tile + 1 : -1
+      };
+      for (int n = 0; n < 4; n++) {
+        const int neighbour = neighbours[n];
+        if (neighbour == -1 || !_walkable[neighbour] || distances[neighbour] != UNREACHED) {
+          continue;
+        }
+        distances[neighbour] = nextDistance;
+        _bfsQueue.push_back(neighbour);
       }
     }
   }
@@ -28,6 +28,15 @@ public:
   void update();
   void updateOpenMoves(Soldier* soldier);
 
+  static const int UNREACHED = -1;
+  // Steps from (x, y) to the nearest soldier of another army, as of the start of the turn
+  int getEnemyDistance(int army, int x, int y) const {
+    if (x < 0 || x >= _fieldWidth || y < 0 || y >= _fieldHeight) {
+      return UNREACHED;
+    }
+    return _enemyDistances[army][y * _fieldWidth + x];
+  }
+
   // getters
   char getTile(int x, int y) const;
   Soldier* getSoldier(int x, int y) const;
@@ -47,12 +56,20 @@ private:
   void battle(Soldier* soldier, int targetX, int targetY);
   void moveSoldier(Soldier* soldier, int targetX, int targetY);
   void shuffleArmies();
+  void initEnemyDistances();
+  void buildEnemyDistances();
+  void removeSoldier(Soldier* soldier);
   GameSystem* gameSystem;
   bool _armiesCanMove = true;
   std::vector<std::string> _levelData;
   std::vector<std::vector <Soldier*> > _soldierGrid;
   std::vector<int> _levelGrid;
   std::vector<Soldier*> _armies[NUM_ARMIES];
+  std::vector<int> _enemyDistances[NUM_ARMIES]; // BFS distance field per army, row by row
+  std::vector<bool> _walkable;
+  std::vector<int> _bfsQueue;
+  int _fieldWidth = 0;
+  int _fieldHeight = 0;
   int _currentLevel = 1;
   const int levelWidth = 80;
   const int levelHeight = 25;
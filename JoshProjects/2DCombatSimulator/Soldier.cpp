@@ -1,4 +1,5 @@
 #include "Soldier.h"
+#include "Level.h"
 #include <random>
 #include <ctime>
 
@@ -37,67 +38,32 @@ void Soldier::setPosition(int x, int y) {
   _y = y;
 }
 
-char Soldier::getMove(std::vector<Soldier*> armies[], int numArmies) {
-  Soldier* closestSoldier = getClosestEnemy(armies, numArmies);
-  if (closestSoldier == nullptr) {
+char Soldier::getMove(const Level& level) const {
+  const int distance = level.getEnemyDistance(_army, _x, _y);
+  if (distance == Level::UNREACHED) {
     return '.';
   }
 
-  int soldierX, soldierY;
-  closestSoldier->getPosition(soldierX, soldierY);
+  // Take the open step that gets closest to an enemy. Sidestepping is still allowed
+  // when friends block the way, so the front line can spread out around them.
+  const char MOVES[4] = { 'w', 'a', 's', 'd' };
+  const int STEP_X[4] = { 0, -1, 0, 1 };
+  const int STEP_Y[4] = { -1, 0, 1, 0 };
+  const bool blocked[4] = { _upBlocked, _leftBlocked, _downBlocked, _rightBlocked };
 
-  int dx = soldierX - _x;
-  int dy = soldierY - _y;
-  int adx = std::abs(dx);
-  int ady = std::abs(dy);
-
-  // attempt preferred move
-  if (adx > ady) {
-    if (dx > 0 && !_rightBlocked) return 'd';
-    if (dx < 0 && !_leftBlocked) return 'a';
-  }
-  else {
-    if (dy > 0 && !_downBlocked) return 's';
-    if (dy < 0 && !_upBlocked) return 'w';
-  }
-
-  // try other directions
-  if (adx > ady) {
-    if (!_downBlocked) return 's';
-    if (!_upBlocked) return 'w';
-    if (dx > 0 && !_leftBlocked) return 'a';
-    if (dx < 0 && !_rightBlocked) return 'd';
-  }
-  else {
-    if (!_rightBlocked) return 'd';
-    if (!_leftBlocked) return 'a';
-    if (dy > 0 && !_upBlocked) return 'w';
-    if (dy < 0 && !_downBlocked) return 's';
-  }
-
-  return '.';
-}
-
-Soldier* Soldier::getClosestEnemy(std::vector <Soldier*> armies[], int numArmies) {
-  Soldier* closestSoldier = nullptr;
-  int closestDistance = INT_MAX;
-  int enemyX, enemyY;
-  int distance;
-
-  for (int i = 0; i < numArmies; i++) {
-    if (i != _army) {
-      for (int j = 0; j < armies[i].size(); j++) {
-        armies[i][j]->getPosition(enemyX, enemyY);
-        distance = abs(enemyX - _x) + abs(enemyY - _y);
-        if (distance < closestDistance) {
-          closestSoldier = armies[i][j];
-          closestDistance = distance;
-        }
-      }
+  char bestMove = '.';
+  int bestDistance = Level::UNREACHED;
+  for (int i = 0; i < 4; i++) {
+    if (blocked[i]) {
+      continue;
+    }
+    int stepDistance = level.getEnemyDistance(_army, _x + STEP_X[i], _y + STEP_Y[i]);
+    if (stepDistance != Level::UNREACHED && (bestMove == '.' || stepDistance < bestDistance)) {
+      bestMove = MOVES[i];
+      bestDistance = stepDistance;
     }
   }
-
-  return closestSoldier;
+  return bestMove;
 }
 
 void Soldier::setMoves(bool left, bool right, bool up, bool down) {
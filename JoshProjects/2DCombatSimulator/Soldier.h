@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 
+class Level;
+
 class Soldier
 {
 public:
@@ -11,6 +13,7 @@ public:
   int defenseRoll() const;
   void setPosition(int x, int y);
   void setMoves(bool left, bool right, bool up, bool down);
+  void setArmyIndex(int index) { _armyIndex = index; }
 
   void getPosition(int& x, int& y) const { x = _x; y = _y; }
   int getDefense() const { return _defense; }
@@ -19,11 +22,12 @@ public:
   int getTeam() const { return _army; }
   int getGold() const { return _goldValue; }
   int getHealth() const { return _health; }
-  char getMove(std::vector <Soldier*> armies[], int numArmies);
+  int getArmyIndex() const { return _armyIndex; }
+  // Steps down the level's distance field towards the nearest enemy, O(1)
+  char getMove(const Level& level) const;
   bool isMobile() const { return _mobile; }
 
 private:
-  Soldier* getClosestEnemy(std::vector <Soldier*> armies[], int numArmies);
   std::string _name;
   char _tile;
   int _level;
@@ -36,6 +40,7 @@ private:
   bool _mobile;
   int _x;
   int _y;
+  int _armyIndex = -1; // Where this soldier is in its army's vector, for O(1) removal
   bool _leftBlocked;
   bool _rightBlocked;
   bool _upBlocked;
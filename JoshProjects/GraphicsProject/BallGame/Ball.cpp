@@ -12,3 +12,61 @@ Ball::Ball(float radius, float mass, const glm::vec2& pos,
     this->textureId = textureId;
     this->color = color;
 }
+
+void BallData::add(const Ball& ball) {
+    posX.push_back(ball.position.x);
+    posY.push_back(ball.position.y);
+    velX.push_back(ball.velocity.x);
+    velY.push_back(ball.velocity.y);
+    radius.push_back(ball.radius);
+    mass.push_back(ball.mass);
+    textureId.push_back(ball.textureId);
+    color.push_back(ball.color);
+}
+
+void BallData::clear() {
+    posX.clear();
+    posY.clear();
+    velX.clear();
+    velY.clear();
+    radius.clear();
+    mass.clear();
+    textureId.clear();
+    color.clear();
+}
+
+void BallData::reserve(size_t count) {
+    posX.reserve(count);
+    posY.reserve(count);
+    velX.reserve(count);
+    velY.reserve(count);
+    radius.reserve(count);
+    mass.reserve(count);
+    textureId.reserve(count);
+    color.reserve(count);
+}
+
+Ball BallData::operator[](size_t i) const {
+    return Ball(radius[i], mass[i], getPosition(i), getVelocity(i), textureId[i], color[i]);
+}
+
+void BallData::reorder(const std::vector<int>& order) {
+    reorderArray(posX, m_floatScratch, order);
+    reorderArray(posY, m_floatScratch, order);
+    reorderArray(velX, m_floatScratch, order);
+    reorderArray(velY, m_floatScratch, order);
+    reorderArray(radius, m_floatScratch, order);
+    reorderArray(mass, m_floatScratch, order);
+    reorderArray(textureId, m_textureScratch, order);
+    reorderArray(color, m_colorScratch, order);
+}
+
+template <typename T>
+void BallData::reorderArray(std::vector<T>& values, std::vector<T>& scratch, const std::vector<int>& order) {
+    scratch.resize(values.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        scratch[i] = values[order[i]];
+    }
+    // The old array becomes the next call's scratch
+    values.swap(scratch);
+}
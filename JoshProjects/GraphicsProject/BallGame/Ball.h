@@ -2,21 +2,67 @@
 
 #include <glm/glm.hpp>
 #include <JAGEngine/Vertex.h>
+#include <vector>
 
-struct Cell;
-
-// POD
+// POD, a copy of one ball's state
 struct Ball {
     Ball(float radius, float mass, const glm::vec2& pos,
          const glm::vec2& vel, unsigned int textureId,
          const JAGEngine::ColorRGBA8& color);
 
-    float radius; 
-    float mass; 
+    float radius;
+    float mass;
     glm::vec2 velocity;
     glm::vec2 position;
     unsigned int textureId = 0;
     JAGEngine::ColorRGBA8 color;
-    Cell* ownerCell = nullptr;
-    int cellVectorIndex = -1;
+};
+
+// All the balls, one array per field so the simulation can stream through positions
+// and velocities with SIMD loads. Indexing or iterating hands out Ball copies.
+struct BallData {
+    class ConstIterator {
+    public:
+        ConstIterator(const BallData* data, size_t index) : m_data(data), m_index(index) {}
+        Ball operator*() const { return (*m_data)[m_index]; }
+        ConstIterator& operator++() { m_index++; return *this; }
+        bool operator!=(const ConstIterator& other) const { return m_index != other.m_index; }
+    private:
+        const BallData* m_data;
+        size_t m_index;
+    };
+
+    void add(const Ball& ball);
+    void clear();
+    void reserve(size_t count);
+    /// Reorders every array so the ball at order[k] ends up at k
+    void reorder(const std::vector<int>& order);
+
+    size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+    Ball operator[](size_t i) const;
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size()); }
+
+    glm::vec2 getPosition(size_t i) const { return glm::vec2(posX[i], posY[i]); }
+    glm::vec2 getVelocity(size_t i) const { return glm::vec2(velX[i], velY[i]); }
+    void setPosition(size_t i, const glm::vec2& pos) { posX[i] = pos.x; posY[i] = pos.y; }
+    void setVelocity(size_t i, const glm::vec2& vel) { velX[i] = vel.x; velY[i] = vel.y; }
+
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> radius;
+    std::vector<float> mass;
+    std::vector<unsigned int> textureId;
+    std::vector<JAGEngine::ColorRGBA8> color;
+
+private:
+    template <typename T>
+    void reorderArray(std::vector<T>& values, std::vector<T>& scratch, const std::vector<int>& order);
+
+    std::vector<float> m_floatScratch;
+    std::vector<unsigned int> m_textureScratch;
+    std::vector<JAGEngine::ColorRGBA8> m_colorScratch;
 };
@@ -1,50 +1,71 @@
 //BallController.cpp
 
 #include "BallController.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include "Grid.h"
+#include "Broadphase.h"
+#include <JAGEngine/JobSystem.h>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
 #include <glm/gtx/vector_angle.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-void BallController::updateBalls(std::vector<Ball>& balls, Grid* grid, float deltaTime, int maxX, int maxY) {
-  //glm::vec2 gravity = getGravityAccel();
-
-  for (size_t i = 0; i < balls.size(); i++) {
-    Ball& ball = balls[i];
-
-    if (i != m_grabbedBall) {
-      // Apply gravity
-      ball.velocity += m_gravity * deltaTime;
-
-      // Apply friction
-      float frictionFactor = std::pow(1.0f - m_friction, deltaTime * 60.0f); // Adjust for 60 FPS
-      ball.velocity *= frictionFactor;
+namespace {
+  // Fewest balls worth handing to another thread for integration
+  const uint32_t INTEGRATE_GRAIN = 8192;
+}
 
-      // Update position
-      ball.position += ball.velocity * deltaTime * m_speedMultiplier;
+void BallController::updateBalls(BallData& balls, Broadphase* broadphase, float deltaTime, int maxX, int maxY) {
+  // The grabbed ball follows the mouse, keep the integration from moving it
+  glm::vec2 grabbedPosition, grabbedVelocity;
+  if (m_grabbedBall != -1) {
+    grabbedPosition = balls.getPosition(m_grabbedBall);
+    grabbedVelocity = balls.getVelocity(m_grabbedBall);
+  }
 
-      // Apply maximum speed limit
-      float speed = glm::length(ball.velocity);
-      if (speed > m_multipliedMaxSpeed) {
-        ball.velocity = glm::normalize(ball.velocity) * m_multipliedMaxSpeed;
-      }
+  integrate(balls, deltaTime, maxX, maxY);
 
-      // Wall collisions
-      handleWallCollision(ball, maxX, maxY);
-    }
+  if (m_grabbedBall != -1) {
+    balls.setPosition(m_grabbedBall, grabbedPosition);
+    balls.setVelocity(m_grabbedBall, grabbedVelocity);
+  }
 
-    // Update grid
-    Cell* newCell = grid->getCell(ball.position);
-    if (newCell != ball.ownerCell) {
-      grid->removeBallFromCell(&balls[i]);
-      grid->addBall(&balls[i], newCell);
-    }
+  // Store the balls in cell order so every cell is a contiguous range
+  broadphase->rebuild(balls);
+  const std::vector<int>& order = broadphase->getSortOrder();
+  if (m_grabbedBall != -1) {
+    m_grabbedBall = static_cast<int>(std::find(order.begin(), order.end(), m_grabbedBall) - order.begin());
   }
+  balls.reorder(order);
 
   // Handle ball-to-ball collisions
-  updateCollision(grid);
+  updateCollision(balls, broadphase);
+}
+
+void BallController::integrate(BallData& balls, float deltaTime, int maxX, int maxY) {
+  IntegrateParams params;
+  params.gravityX = m_gravity.x * deltaTime;
+  params.gravityY = m_gravity.y * deltaTime;
+  params.friction = std::pow(1.0f - m_friction, deltaTime * 60.0f); // Adjust for 60 FPS
+  params.moveScale = deltaTime * m_speedMultiplier;
+  params.maxSpeed = m_multipliedMaxSpeed;
+  params.maxX = static_cast<float>(maxX);
+  params.maxY = static_cast<float>(maxY);
+
+  // Every ball is independent, so chunks can go to any thread
+  const BallArrays arrays = BallArrays::of(balls);
+  auto integrateChunk = [&](uint32_t begin, uint32_t end) {
+    m_kernels->integrate(arrays, (int)begin, (int)end, params);
+  };
+
+  const uint32_t numBalls = static_cast<uint32_t>(balls.size());
+  if (m_multithreaded) {
+    JAGEngine::JobSystem::getInstance().parallelFor(numBalls, INTEGRATE_GRAIN, integrateChunk);
+  }
+  else {
+    integrateChunk(0, numBalls);
+  }
 }
 
 void BallController::updateMultipliedSpeeds() {
@@ -56,131 +77,132 @@ void BallController::setSpeedMultiplier(float multiplier) {
   updateMultipliedSpeeds();
 }
 
-void BallController::handleWallCollision(Ball& ball, int maxX, int maxY) {
-  if (ball.position.x - ball.radius < 0) {
-    ball.position.x = ball.radius;
-    ball.velocity.x = -ball.velocity.x;
-  }
-  else if (ball.position.x + ball.radius > maxX) {
-    ball.position.x = maxX - ball.radius;
-    ball.velocity.x = -ball.velocity.x;
-  }
-
-  if (ball.position.y - ball.radius < 0) {
-    ball.position.y = ball.radius;
-    ball.velocity.y = -ball.velocity.y;
-  }
-  else if (ball.position.y + ball.radius > maxY) {
-    ball.position.y = maxY - ball.radius;
-    ball.velocity.y = -ball.velocity.y;
-  }
-}
-
-void BallController::onMouseDown(std::vector<Ball>& balls, float mouseX, float mouseY) {
+void BallController::onMouseDown(BallData& balls, float mouseX, float mouseY) {
   for (size_t i = 0; i < balls.size(); i++) {
-    if (isMouseOnBall(balls[i], mouseX, mouseY)) {
-      m_grabbedBall = i;
-      m_grabOffset = glm::vec2(mouseX, mouseY) - balls[i].position;
-      m_prevPos = balls[i].position;
-      balls[i].velocity = glm::vec2(0.0f);
+    if (isMouseOnBall(balls, static_cast<int>(i), mouseX, mouseY)) {
+      m_grabbedBall = static_cast<int>(i);
+      m_grabOffset = glm::vec2(mouseX, mouseY) - balls.getPosition(i);
+      m_prevPos = balls.getPosition(i);
+      balls.setVelocity(i, glm::vec2(0.0f));
       break;
     }
   }
 }
 
-void BallController::onMouseUp(std::vector<Ball>& balls) {
+void BallController::onMouseUp(BallData& balls) {
   if (m_grabbedBall != -1) {
     // Calculate velocity based on the difference in position and time
     // Assuming a frame time of 1/60 second
-    balls[m_grabbedBall].velocity = (balls[m_grabbedBall].position - m_prevPos) * 60.0f;
+    glm::vec2 velocity = (balls.getPosition(m_grabbedBall) - m_prevPos) * 60.0f;
 
     // Optionally, limit the release velocity
-    float speed = glm::length(balls[m_grabbedBall].velocity);
+    float speed = glm::length(velocity);
     if (speed > m_maxSpeed * 2) {
-      balls[m_grabbedBall].velocity = glm::normalize(balls[m_grabbedBall].velocity) * (m_maxSpeed * 2.0f);
+      velocity = glm::normalize(velocity) * (m_maxSpeed * 2.0f);
     }
+    balls.setVelocity(m_grabbedBall, velocity);
 
     m_grabbedBall = -1;
   }
 }
 
-void BallController::onMouseMove(std::vector<Ball>& balls, float mouseX, float mouseY) {
+void BallController::onMouseMove(BallData& balls, float mouseX, float mouseY) {
   if (m_grabbedBall != -1) {
     glm::vec2 newPosition(mouseX, mouseY);
-    glm::vec2 oldPosition = balls[m_grabbedBall].position;
-    balls[m_grabbedBall].position = newPosition;
+    glm::vec2 oldPosition = balls.getPosition(m_grabbedBall);
+    balls.setPosition(m_grabbedBall, newPosition);
 
     // Calculate velocity based on mouse movement
-    balls[m_grabbedBall].velocity = (newPosition - oldPosition) * 60.0f; // Assuming 60 FPS
+    glm::vec2 velocity = (newPosition - oldPosition) * 60.0f; // Assuming 60 FPS
 
     // Optionally, limit the maximum velocity during dragging
-    float speed = glm::length(balls[m_grabbedBall].velocity);
+    float speed = glm::length(velocity);
     if (speed > m_maxSpeed * 2) { // Allow dragged balls to move faster than the normal max speed
-      balls[m_grabbedBall].velocity = glm::normalize(balls[m_grabbedBall].velocity) * (m_maxSpeed * 2.0f);
+      velocity = glm::normalize(velocity) * (m_maxSpeed * 2.0f);
     }
+    balls.setVelocity(m_grabbedBall, velocity);
   }
-} 
-
-void BallController::updateCollision(Grid* grid) {
-    for (size_t i = 0; i < grid->m_cells.size(); i++) {
-
-        int x = i % grid->m_numXCells;
-        int y = i / grid->m_numXCells;
-
-        Cell& cell = grid->m_cells[i];
-
-        // Loop through all balls in a cell
-        for (size_t j = 0; j < cell.balls.size(); j++) {
-            Ball* ball = cell.balls[j];
-            /// Update with the residing cell
-            checkCollision(ball, cell.balls, j + 1);
-
-            /// Update collision with neighbor cells
-            if (x > 0) {
-                // Left
-                checkCollision(ball, grid->getCell(x - 1, y)->balls, 0);
-                if (y > 0) {
-                    /// Top left
-                    checkCollision(ball, grid->getCell(x - 1, y - 1)->balls, 0);
-                }
-                if (y < grid->m_numYCells - 1) {
-                    // Bottom left
-                    checkCollision(ball, grid->getCell(x - 1, y + 1)->balls, 0);
-                }
-            }
-            // Up cell
-            if (y > 0) {
-                checkCollision(ball, grid->getCell(x, y - 1)->balls, 0);
+}
+
+void BallController::updateCollision(BallData& balls, Broadphase* broadphase) {
+    // Bands two apart never share a ball, so all the even bands run at once, then all
+    // the odd ones. Each band runs its balls in order and the bands don't depend on the
+    // thread count, so the result is the same for any number of threads.
+    const int numBands = broadphase->getNumBands();
+
+    for (int parity = 0; parity < 2; parity++) {
+        auto runBands = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t task = begin; task < end; task++) {
+                updateCollisionBand(balls, broadphase, (int)task * 2 + parity);
             }
+        };
+
+        uint32_t bandCount = (uint32_t)((numBands - parity + 1) / 2);
+        if (m_multithreaded) {
+            JAGEngine::JobSystem::getInstance().parallelFor(bandCount, 1, runBands);
+        }
+        else {
+            runBands(0, bandCount);
         }
     }
 }
 
-void BallController::checkCollision(Ball* ball, std::vector<Ball*>& ballsToCheck, int startingIndex) {
-    for (size_t i = startingIndex; i < ballsToCheck.size(); i++) {
-        checkCollision(*ball, *ballsToCheck[i]);
+void BallController::updateCollisionBand(BallData& balls, const Broadphase* broadphase, int band) {
+    Broadphase::Range ranges[Broadphase::MAX_CANDIDATE_RANGES];
+    const Broadphase::Range bandBalls = broadphase->getBandBalls(band);
+
+    for (int i = bandBalls.begin; i < bandBalls.end; i++) {
+        int numRanges = broadphase->getCandidates(i, ranges);
+        for (int r = 0; r < numRanges; r++) {
+            checkCollision(balls, i, ranges[r].begin, ranges[r].end);
+        }
     }
 }
 
-void BallController::checkCollision(Ball& b1, Ball& b2) {
-  glm::vec2 distVec = b2.position - b1.position;
-  float dist = glm::length(distVec);
-  float totalRadius = b1.radius + b2.radius;
+void BallController::checkCollision(BallData& balls, int ball, int start, int end) {
+    // The SIMD test only picks candidates. Each one is checked again by the exact test,
+    // since resolving an earlier pair can move this ball.
+    const BallArrays arrays = BallArrays::of(balls);
+    const int width = m_kernels->width;
+    int j = start;
+    for (; j + width <= end; j += width) {
+        int bits = m_kernels->overlapBits(arrays, j, balls.posX[ball], balls.posY[ball], balls.radius[ball]);
+        for (int lane = 0; bits != 0; lane++, bits >>= 1) {
+            if (bits & 1) {
+                checkCollision(balls, ball, j + lane);
+            }
+        }
+    }
+    for (; j < end; j++) {
+        checkCollision(balls, ball, j);
+    }
+}
 
-  if (dist < totalRadius) {
-    glm::vec2 collisionNormal = glm::normalize(distVec);
+void BallController::checkCollision(BallData& balls, int b1, int b2) {
+  glm::vec2 distVec = balls.getPosition(b2) - balls.getPosition(b1);
+  float distSq = glm::dot(distVec, distVec);
+  float totalRadius = balls.radius[b1] + balls.radius[b2];
+
+  // Exactly on top of each other has no normal to push along
+  if (distSq < totalRadius * totalRadius && distSq > 0.0f) {
+    float dist = std::sqrt(distSq);
+    glm::vec2 collisionNormal = distVec / dist;
 
     // Move balls apart
     float overlap = totalRadius - dist;
-    float totalMass = b1.mass + b2.mass;
-    float b1Ratio = b1.mass / totalMass;
-    float b2Ratio = b2.mass / totalMass;
+    float mass1 = balls.mass[b1];
+    float mass2 = balls.mass[b2];
+    float totalMass = mass1 + mass2;
+    float b1Ratio = mass1 / totalMass;
+    float b2Ratio = mass2 / totalMass;
 
-    b1.position -= overlap * b2Ratio * collisionNormal;
-    b2.position += overlap * b1Ratio * collisionNormal;
+    balls.setPosition(b1, balls.getPosition(b1) - overlap * b2Ratio * collisionNormal);
+    balls.setPosition(b2, balls.getPosition(b2) + overlap * b1Ratio * collisionNormal);
 
     // Calculate relative velocity
-    glm::vec2 relativeVelocity = b2.velocity - b1.velocity;
+    glm::vec2 velocity1 = balls.getVelocity(b1);
+    glm::vec2 velocity2 = balls.getVelocity(b2);
+    glm::vec2 relativeVelocity = velocity2 - velocity1;
 
     // Calculate impulse
     float impulseStrength = glm::dot(relativeVelocity, collisionNormal);
@@ -192,40 +214,42 @@ void BallController::checkCollision(Ball& b1, Ball& b2) {
 
     float e = 1.0f; // Perfect elasticity
     float j = -(1 + e) * impulseStrength;
-    j /= 1 / b1.mass + 1 / b2.mass;
+    j /= 1 / mass1 + 1 / mass2;
 
     glm::vec2 impulse = j * collisionNormal;
 
     // Apply impulse
-    b1.velocity -= impulse / b1.mass;
-    b2.velocity += impulse / b2.mass;
+    velocity1 -= impulse / mass1;
+    velocity2 += impulse / mass2;
 
     // Apply maximum speed limit
-    float speed1 = glm::length(b1.velocity);
-    float speed2 = glm::length(b2.velocity);
+    float speed1 = glm::length(velocity1);
+    float speed2 = glm::length(velocity2);
 
     if (speed1 > m_multipliedMaxSpeed) {
-      b1.velocity = glm::normalize(b1.velocity) * m_multipliedMaxSpeed;
+      velocity1 = velocity1 / speed1 * m_multipliedMaxSpeed;
+      speed1 = m_multipliedMaxSpeed;
     }
     if (speed2 > m_multipliedMaxSpeed) {
-      b2.velocity = glm::normalize(b2.velocity) * m_multipliedMaxSpeed;
+      velocity2 = velocity2 / speed2 * m_multipliedMaxSpeed;
+      speed2 = m_multipliedMaxSpeed;
     }
+    balls.setVelocity(b1, velocity1);
+    balls.setVelocity(b2, velocity2);
 
     // Transfer color based on relative speed
-    if (glm::length(b1.velocity - b2.velocity) > 0.5f) {
-      bool b1Faster = glm::length(b1.velocity) > glm::length(b2.velocity);
-      if (b1Faster) {
-        b2.color = b1.color;
+    if (glm::length(velocity1 - velocity2) > 0.5f) {
+      if (speed1 > speed2) {
+        balls.color[b2] = balls.color[b1];
       }
       else {
-        b1.color = b2.color;
+        balls.color[b1] = balls.color[b2];
       }
     }
   }
 }
 
 
-bool BallController::isMouseOnBall(const Ball& ball, float mouseX, float mouseY) {
-  return glm::distance(glm::vec2(mouseX, mouseY), ball.position) < ball.radius;
+bool BallController::isMouseOnBall(const BallData& balls, int ball, float mouseX, float mouseY) {
+  return glm::distance(glm::vec2(mouseX, mouseY), balls.getPosition(ball)) < balls.radius[ball];
 }
-
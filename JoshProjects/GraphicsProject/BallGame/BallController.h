@@ -3,19 +3,20 @@
 #include <vector>
 
 #include "Ball.h"
+#include "BallKernels.h"
 
 enum class GravityDirection {NONE, LEFT, UP, RIGHT, DOWN};
 
-class Grid;
+class Broadphase;
 
 class BallController {
 public:
-    /// Updates the balls
-    void updateBalls(std::vector<Ball>& balls, Grid* grid, float deltaTime, int maxX, int maxY);
+    /// Updates the balls. Leaves them in the broadphase's sorted order, so indices change every step.
+    void updateBalls(BallData& balls, Broadphase* broadphase, float deltaTime, int maxX, int maxY);
     /// Some simple event functions
-    void onMouseDown(std::vector <Ball>& balls, float mouseX, float mouseY);
-    void onMouseUp(std::vector <Ball>& balls);
-    void onMouseMove(std::vector <Ball>& balls, float mouseX, float mouseY);
+    void onMouseDown(BallData& balls, float mouseX, float mouseY);
+    void onMouseUp(BallData& balls);
+    void onMouseMove(BallData& balls, float mouseX, float mouseY);
 
     // Getters
     float getMaxSpeed() const { return m_maxSpeed; }
@@ -26,18 +27,24 @@ public:
     void setSpeedMultiplier(float multiplier);
     void setFriction(float friction) { m_friction = friction; }
     void setGravity(const glm::vec2& gravity) { m_gravity = gravity; }
+    /// Spreads integration and collision over the JobSystem. Results are the same either way.
+    void setMultithreaded(bool multithreaded) { m_multithreaded = multithreaded; }
+    bool isMultithreaded() const { return m_multithreaded; }
 
 private:
+    /// Gravity, friction, movement, speed limit and walls for every ball
+    void integrate(BallData& balls, float deltaTime, int maxX, int maxY);
     // Updates collision
-    void updateCollision(Grid* grid);
-    /// Checks collision between a ball and a vector of balls, starting at a specific index
-    void checkCollision(Ball* ball, std::vector<Ball*>& ballsToCheck, int startingIndex);
-    /// Checks collision between two balls
-    void checkCollision(Ball& b1, Ball& b2);
-    /// Returns true if the mouse is hovering over a ball
-    void handleWallCollision(Ball& ball, int maxX, int maxY);
+    void updateCollision(BallData& balls, Broadphase* broadphase);
+    /// Collision for the balls in one broadphase band
+    void updateCollisionBand(BallData& balls, const Broadphase* broadphase, int band);
+    /// Checks collision between a ball and the balls in [start, end)
+    void checkCollision(BallData& balls, int ball, int start, int end);
+    /// Resolves collision between two balls
+    void checkCollision(BallData& balls, int b1, int b2);
     void updateMultipliedSpeeds();
-    bool isMouseOnBall(const Ball& ball, float mouseX, float mouseY);
+    /// Returns true if the mouse is hovering over a ball
+    bool isMouseOnBall(const BallData& balls, int ball, float mouseX, float mouseY);
 
     int m_grabbedBall = -1; ///< The ball we are currently grabbing on to
     glm::vec2 m_prevPos = glm::vec2(0.0f); ///< Previous position of the grabbed ball
@@ -47,6 +54,8 @@ private:
     float m_multipliedMaxSpeed = 10.0f;
     float m_friction = 0.01f;
     glm::vec2 m_gravity = glm::vec2(0.0f, -0.02f);
+    bool m_multithreaded = true;
+    const BallKernels* m_kernels = &getBallKernels(); ///< SIMD width picked from the CPU
 
     GravityDirection m_gravityDirection = GravityDirection::NONE;
 };
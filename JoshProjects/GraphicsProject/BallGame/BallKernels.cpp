@@ -0,0 +1,85 @@
+//BallKernels.cpp
+
+#include "BallKernels.h"
+#include "BallLanes.h"
+#include "Ball.h"
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BALL_SIMD_SSE2
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace {
+#if defined(BALL_SIMD_SSE2)
+  struct Sse2Float {
+    static const int WIDTH = 4;
+    struct Mask { __m128 v; };
+
+    __m128 v;
+
+    static Sse2Float load(const float* p) { return { _mm_loadu_ps(p) }; }
+    static Sse2Float set(float f) { return { _mm_set1_ps(f) }; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    static Sse2Float sqrt(Sse2Float a) { return { _mm_sqrt_ps(a.v) }; }
+    // No blendv before SSE4.1
+    static Sse2Float select(Mask m, Sse2Float a, Sse2Float b) { return { _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)) }; }
+    static int bits(Mask m) { return _mm_movemask_ps(m.v); }
+    static Mask andNot(Mask a, Mask b) { return { _mm_andnot_ps(a.v, b.v) }; }
+
+    friend Sse2Float operator+(Sse2Float a, Sse2Float b) { return { _mm_add_ps(a.v, b.v) }; }
+    friend Sse2Float operator-(Sse2Float a, Sse2Float b) { return { _mm_sub_ps(a.v, b.v) }; }
+    friend Sse2Float operator*(Sse2Float a, Sse2Float b) { return { _mm_mul_ps(a.v, b.v) }; }
+    friend Sse2Float operator/(Sse2Float a, Sse2Float b) { return { _mm_div_ps(a.v, b.v) }; }
+    friend Mask operator<(Sse2Float a, Sse2Float b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+    friend Mask operator>(Sse2Float a, Sse2Float b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+    friend Mask operator|(Mask a, Mask b) { return { _mm_or_ps(a.v, b.v) }; }
+  };
+
+  const BallKernels BASE_KERNELS = { "SSE2", Sse2Float::WIDTH, &integrateRange<Sse2Float>, &overlapLanes<Sse2Float> };
+#else
+  const BallKernels BASE_KERNELS = { "scalar", ScalarFloat::WIDTH, &integrateRange<ScalarFloat>, &overlapLanes<ScalarFloat> };
+#endif
+
+  /// AVX2 needs the instructions and an OS that saves the YMM registers
+  bool cpuSupportsAvx2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    __cpuid(info, 1);
+    const int OSXSAVE = 1 << 27;
+    const int AVX = 1 << 28;
+    if ((info[2] & (OSXSAVE | AVX)) != (OSXSAVE | AVX)) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+  }
+
+  const BallKernels& selectKernels() {
+    const BallKernels* avx2 = getAvx2BallKernels();
+    const BallKernels& kernels = (avx2 && cpuSupportsAvx2()) ? *avx2 : BASE_KERNELS;
+    std::cout << "Ball kernels: " << kernels.name << " (" << kernels.width << " wide)" << std::endl;
+    return kernels;
+  }
+}
+
+BallArrays BallArrays::of(BallData& balls) {
+  return { balls.posX.data(), balls.posY.data(), balls.velX.data(), balls.velY.data(), balls.radius.data() };
+}
+
+const BallKernels& getBallKernels() {
+  static const BallKernels& kernels = selectKernels();
+  return kernels;
+}
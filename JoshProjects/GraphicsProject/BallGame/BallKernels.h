@@ -0,0 +1,42 @@
+#pragma once
+
+// The SIMD parts of the ball update, built once per instruction set. AVX2 lives in its
+// own file that is the only one compiled with /arch:AVX2, and getBallKernels() picks
+// it only when the CPU and OS support it, so the game still runs on SSE2-only machines.
+
+struct BallData;
+
+struct IntegrateParams {
+  float gravityX, gravityY;   ///< Already scaled by deltaTime
+  float friction;             ///< Per step, not per second
+  float moveScale;            ///< deltaTime * speed multiplier
+  float maxSpeed;
+  float maxX, maxY;
+};
+
+/// Raw pointers into BallData's arrays. The kernels only see these, so the AVX2 file
+/// doesn't instantiate any std::vector code the linker could hand to the other files.
+struct BallArrays {
+  float* posX;
+  float* posY;
+  float* velX;
+  float* velY;
+  const float* radius;
+
+  static BallArrays of(BallData& balls);
+};
+
+struct BallKernels {
+  const char* name;
+  int width;  ///< Balls per SIMD step
+  /// Gravity, friction, movement, speed limit and walls for [start, end)
+  void (*integrate)(const BallArrays& balls, int start, int end, const IntegrateParams& params);
+  /// Bit per lane for the balls in [j, j + width) that overlap the given circle
+  int (*overlapBits)(const BallArrays& balls, int j, float x, float y, float radius);
+};
+
+/// The widest kernels this CPU runs. Checked on the first call.
+const BallKernels& getBallKernels();
+
+/// Defined in BallKernelsAVX2.cpp, nullptr when that file wasn't built with AVX2
+const BallKernels* getAvx2BallKernels();
@@ -0,0 +1,46 @@
+//BallKernelsAVX2.cpp
+
+// The only file built with /arch:AVX2. Nothing in here runs unless getBallKernels()
+// found AVX2 on the CPU.
+
+#include "BallKernels.h"
+
+#if defined(__AVX2__)
+#include "BallLanes.h"
+#include <immintrin.h>
+
+namespace {
+  struct Avx2Float {
+    static const int WIDTH = 8;
+    struct Mask { __m256 v; };
+
+    __m256 v;
+
+    static Avx2Float load(const float* p) { return { _mm256_loadu_ps(p) }; }
+    static Avx2Float set(float f) { return { _mm256_set1_ps(f) }; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+    static Avx2Float sqrt(Avx2Float a) { return { _mm256_sqrt_ps(a.v) }; }
+    static Avx2Float select(Mask m, Avx2Float a, Avx2Float b) { return { _mm256_blendv_ps(b.v, a.v, m.v) }; }
+    static int bits(Mask m) { return _mm256_movemask_ps(m.v); }
+    static Mask andNot(Mask a, Mask b) { return { _mm256_andnot_ps(a.v, b.v) }; }
+
+    friend Avx2Float operator+(Avx2Float a, Avx2Float b) { return { _mm256_add_ps(a.v, b.v) }; }
+    friend Avx2Float operator-(Avx2Float a, Avx2Float b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    friend Avx2Float operator*(Avx2Float a, Avx2Float b) { return { _mm256_mul_ps(a.v, b.v) }; }
+    friend Avx2Float operator/(Avx2Float a, Avx2Float b) { return { _mm256_div_ps(a.v, b.v) }; }
+    friend Mask operator<(Avx2Float a, Avx2Float b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+    friend Mask operator>(Avx2Float a, Avx2Float b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+    friend Mask operator|(Mask a, Mask b) { return { _mm256_or_ps(a.v, b.v) }; }
+  };
+
+  const BallKernels AVX2_KERNELS = { "AVX2", Avx2Float::WIDTH, &integrateRange<Avx2Float>, &overlapLanes<Avx2Float> };
+}
+
+const BallKernels* getAvx2BallKernels() {
+  return &AVX2_KERNELS;
+}
+#else
+const BallKernels* getAvx2BallKernels() {
+  return nullptr;
+}
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+
+// Kernel bodies shared by BallKernels.cpp and BallKernelsAVX2.cpp, written once against
+// a lane type F (load, set, store, sqrt, select, bits, andNot and the operators).
+// Everything here has internal linkage. Both files are built with different instruction
+// sets, so the linker must never pick one file's copy for the other.
+
+#include "BallKernels.h"
+#include <cmath>
+
+namespace {
+  /// One float per lane, for the balls left over at the end of a range and for
+  /// targets without SIMD
+  struct ScalarFloat {
+    static const int WIDTH = 1;
+    struct Mask { bool v; };
+
+    float v;
+
+    static ScalarFloat load(const float* p) { return { *p }; }
+    static ScalarFloat set(float f) { return { f }; }
+    void store(float* p) const { *p = v; }
+    static ScalarFloat sqrt(ScalarFloat a) { return { std::sqrt(a.v) }; }
+    static ScalarFloat select(Mask m, ScalarFloat a, ScalarFloat b) { return m.v ? a : b; }
+    static int bits(Mask m) { return m.v ? 1 : 0; }
+    static Mask andNot(Mask a, Mask b) { return { !a.v && b.v }; }
+
+    friend ScalarFloat operator+(ScalarFloat a, ScalarFloat b) { return { a.v + b.v }; }
+    friend ScalarFloat operator-(ScalarFloat a, ScalarFloat b) { return { a.v - b.v }; }
+    friend ScalarFloat operator*(ScalarFloat a, ScalarFloat b) { return { a.v * b.v }; }
+    friend ScalarFloat operator/(ScalarFloat a, ScalarFloat b) { return { a.v / b.v }; }
+    friend Mask operator<(ScalarFloat a, ScalarFloat b) { return { a.v < b.v }; }
+    friend Mask operator>(ScalarFloat a, ScalarFloat b) { return { a.v > b.v }; }
+    friend Mask operator|(Mask a, Mask b) { return { a.v || b.v }; }
+  };
+
+  /// Integrates balls from start until fewer than F::WIDTH are left, returns where it stopped
+  template <typename F>
+  int integrateLanes(const BallArrays& balls, int start, int end, const IntegrateParams& params) {
+    const F zero = F::set(0.0f);
+    const F gravityX = F::set(params.gravityX);
+    const F gravityY = F::set(params.gravityY);
+    const F friction = F::set(params.friction);
+    const F moveScale = F::set(params.moveScale);
+    const F maxSpeed = F::set(params.maxSpeed);
+    const F maxSpeedSq = maxSpeed * maxSpeed;
+    const F maxX = F::set(params.maxX);
+    const F maxY = F::set(params.maxY);
+
+    int i = start;
+    for (; i + F::WIDTH <= end; i += F::WIDTH) {
+      // Apply gravity and friction
+      F velX = (F::load(balls.velX + i) + gravityX) * friction;
+      F velY = (F::load(balls.velY + i) + gravityY) * friction;
+
+      // Update position
+      F posX = F::load(balls.posX + i) + velX * moveScale;
+      F posY = F::load(balls.posY + i) + velY * moveScale;
+
+      // Apply maximum speed limit
+      F speedSq = velX * velX + velY * velY;
+      typename F::Mask tooFast = speedSq > maxSpeedSq;
+      if (F::bits(tooFast)) {
+        F scale = maxSpeed / F::sqrt(speedSq);
+        velX = F::select(tooFast, velX * scale, velX);
+        velY = F::select(tooFast, velY * scale, velY);
+      }
+
+      // Wall collisions
+      F radius = F::load(balls.radius + i);
+      typename F::Mask hitLeft = posX - radius < zero;
+      typename F::Mask hitRight = F::andNot(hitLeft, posX + radius > maxX);
+      posX = F::select(hitLeft, radius, F::select(hitRight, maxX - radius, posX));
+      velX = F::select(hitLeft | hitRight, zero - velX, velX);
+
+      typename F::Mask hitBottom = posY - radius < zero;
+      typename F::Mask hitTop = F::andNot(hitBottom, posY + radius > maxY);
+      posY = F::select(hitBottom, radius, F::select(hitTop, maxY - radius, posY));
+      velY = F::select(hitBottom | hitTop, zero - velY, velY);
+
+      posX.store(balls.posX + i);
+      posY.store(balls.posY + i);
+      velX.store(balls.velX + i);
+      velY.store(balls.velY + i);
+    }
+    return i;
+  }
+
+  /// Full lanes, then one ball at a time for the rest
+  template <typename F>
+  void integrateRange(const BallArrays& balls, int start, int end, const IntegrateParams& params) {
+    int i = integrateLanes<F>(balls, start, end, params);
+    integrateLanes<ScalarFloat>(balls, i, end, params);
+  }
+
+  template <typename F>
+  int overlapLanes(const BallArrays& balls, int j, float x, float y, float radius) {
+    F dx = F::load(balls.posX + j) - F::set(x);
+    F dy = F::load(balls.posY + j) - F::set(y);
+    F totalRadius = F::load(balls.radius + j) + F::set(radius);
+    return F::bits(dx * dx + dy * dy < totalRadius * totalRadius);
+  }
+}
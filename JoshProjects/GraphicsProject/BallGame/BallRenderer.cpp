@@ -4,7 +4,7 @@
 #include <algorithm>
 #include <cmath>
 
-void BallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+void BallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
   const glm::mat4& projectionMatrix) {
 
   // Begin the sprite batch
@@ -24,7 +24,7 @@ void BallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::v
   spriteBatch.renderBatch();
 }
 
-void MomentumBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+void MomentumBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
   const glm::mat4& projectionMatrix) {
 
   if (m_program == nullptr) {
@@ -64,7 +64,7 @@ void MomentumBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, cons
 VelocityBallRenderer::VelocityBallRenderer(int screenWidth, int screenHeight)
   : m_screenWidth(screenWidth), m_screenHeight(screenHeight) {}
 
-void VelocityBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+void VelocityBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
   const glm::mat4& projectionMatrix) {
 
   if (m_program == nullptr) {
@@ -108,7 +108,7 @@ void VelocityBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, cons
 TrippyBallRenderer::TrippyBallRenderer(int screenWidth, int screenHeight)
   : m_screenWidth(screenWidth), m_screenHeight(screenHeight) {}
 
-void TrippyBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+void TrippyBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
   const glm::mat4& projectionMatrix) {
   if (m_program == nullptr) {
     m_program = std::make_unique<JAGEngine::GLSLProgram>();
@@ -223,7 +223,7 @@ JAGEngine::ColorRGBA8 BallRenderer::applyHueShift(const JAGEngine::ColorRGBA8& c
 PulsatingGlowBallRenderer::PulsatingGlowBallRenderer(int screenWidth, int screenHeight)
   : m_screenWidth(screenWidth), m_screenHeight(screenHeight) {}
 
-void PulsatingGlowBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+void PulsatingGlowBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
   const glm::mat4& projectionMatrix) {
   if (m_program == nullptr) {
     m_program = std::make_unique<JAGEngine::GLSLProgram>();
@@ -269,7 +269,7 @@ void PulsatingGlowBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch,
 RippleEffectBallRenderer::RippleEffectBallRenderer(int screenWidth, int screenHeight)
   : m_screenWidth(screenWidth), m_screenHeight(screenHeight) {}
 
-void RippleEffectBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+void RippleEffectBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
   const glm::mat4& projectionMatrix) {
   if (m_program == nullptr) {
     m_program = std::make_unique<JAGEngine::GLSLProgram>();
@@ -315,7 +315,7 @@ void RippleEffectBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch,
 EnergyVortexBallRenderer::EnergyVortexBallRenderer(int screenWidth, int screenHeight)
   : m_screenWidth(screenWidth), m_screenHeight(screenHeight) {}
 
-void EnergyVortexBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+void EnergyVortexBallRenderer::renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
   const glm::mat4& projectionMatrix) {
   if (m_program == nullptr) {
     m_program = std::make_unique<JAGEngine::GLSLProgram>();
@@ -10,7 +10,7 @@
 class BallRenderer {
 public:
   virtual ~BallRenderer() = default;
-  virtual void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+  virtual void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
     const glm::mat4& projectionMatrix);
   virtual void setHueShift(float hueShift) { m_hueShift = hueShift; }
 
@@ -22,14 +22,14 @@ protected:
 
 class MomentumBallRenderer : public BallRenderer {
 public:
-  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
     const glm::mat4& projectionMatrix) override;
 };
 
 class VelocityBallRenderer : public BallRenderer {
 public:
   VelocityBallRenderer(int screenWidth, int screenHeight);
-  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
     const glm::mat4& projectionMatrix) override;
 private:
   int m_screenWidth;
@@ -39,7 +39,7 @@ private:
 class TrippyBallRenderer : public BallRenderer {
 public:
   TrippyBallRenderer(int screenWidth, int screenHeight);
-  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
     const glm::mat4& projectionMatrix) override;
 private:
   int m_screenWidth;
@@ -50,7 +50,7 @@ private:
 class PulsatingGlowBallRenderer : public BallRenderer {
 public:
   PulsatingGlowBallRenderer(int screenWidth, int screenHeight);
-  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
     const glm::mat4& projectionMatrix) override;
 
 private:
@@ -62,7 +62,7 @@ private:
 class RippleEffectBallRenderer : public BallRenderer {
 public:
   RippleEffectBallRenderer(int screenWidth, int screenHeight);
-  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
     const glm::mat4& projectionMatrix) override;
 
 private:
@@ -74,7 +74,7 @@ private:
 class EnergyVortexBallRenderer : public BallRenderer {
 public:
   EnergyVortexBallRenderer(int screenWidth, int screenHeight);
-  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const std::vector<Ball>& balls,
+  void renderBalls(JAGEngine::SpriteBatch& spriteBatch, const BallData& balls,
     const glm::mat4& projectionMatrix) override;
 
 private:
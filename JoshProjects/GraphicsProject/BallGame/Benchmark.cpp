@@ -0,0 +1,144 @@
+//Benchmark.cpp
+
+#include "Benchmark.h"
+#include "BallController.h"
+#include "Grid.h"
+#include "HierarchicalGrid.h"
+#include <JAGEngine/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+
+namespace {
+  const int BALL_COUNTS[] = { 10000, 100000, 1000000 };
+  const int DEFAULT_STEPS = 30;
+  // The game starts with this many balls on a 1920x1080 screen. The world grows with
+  // the ball count so every run sees the same crowding.
+  const float BALLS_PER_SCREEN = 5000.0f;
+  const float DELTA_TIME = 1.0f / 60.0f;
+
+  // A few balls much bigger than the rest, which is where the broadphases differ
+  struct RadiusSet {
+    const char* name;
+    float bigChance;
+    float bigMin;
+    float bigMax;
+  };
+  const RadiusSet RADIUS_SETS[] = {
+    { "uniform", 0.0f, 0.0f, 0.0f },
+    { "skewed", 0.01f, 20.0f, 60.0f },
+    { "outliers", 0.001f, 100.0f, 200.0f },
+  };
+
+  struct BenchmarkResult {
+    double msPerStep;
+    double energy; ///< Sum of m*v^2 afterwards, changes if the simulation does
+  };
+
+  BenchmarkResult runSteps(int numBalls, int steps, bool multithreaded, BroadphaseType broadphaseType, const RadiusSet& radii) {
+    float scale = std::sqrt(numBalls / BALLS_PER_SCREEN);
+    int width = (int)(1920.0f * scale);
+    int height = (int)(1080.0f * scale);
+
+    // Fixed seed so runs can be compared. The balls start moving, or collision would
+    // have nothing to do for the first few hundred steps.
+    std::mt19937 randomEngine(1);
+    std::uniform_real_distribution<float> randX(0.0f, (float)width);
+    std::uniform_real_distribution<float> randY(0.0f, (float)height);
+    std::uniform_real_distribution<float> randSize(2.0f, 6.0f);
+    std::uniform_real_distribution<float> randVel(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> randChance(0.0f, 1.0f);
+
+    BallData balls;
+    balls.reserve(numBalls);
+    float maxRadius = 0.0f;
+    for (int i = 0; i < numBalls; i++) {
+      float radius = randSize(randomEngine);
+      // Only draws when there are big balls, so uniform runs keep the same balls
+      if (radii.bigChance > 0.0f && randChance(randomEngine) < radii.bigChance) {
+        radius = radii.bigMin + randChance(randomEngine) * (radii.bigMax - radii.bigMin);
+      }
+      glm::vec2 pos(randX(randomEngine), randY(randomEngine));
+      glm::vec2 velocity(randVel(randomEngine), randVel(randomEngine));
+      balls.add(Ball(radius, radius * radius, pos, velocity, 0, JAGEngine::ColorRGBA8(255, 255, 255, 255)));
+      maxRadius = std::max(maxRadius, radius);
+    }
+
+    std::unique_ptr<Broadphase> broadphase;
+    if (broadphaseType == BroadphaseType::UNIFORM_GRID) {
+      broadphase = std::make_unique<Grid>(width, height, maxRadius);
+    }
+    else {
+      broadphase = std::make_unique<HierarchicalGrid>();
+    }
+    BallController ballController;
+    ballController.setMultithreaded(multithreaded);
+    ballController.setMaxSpeed(500.0f);
+    ballController.setFriction(0.01f);
+    ballController.setGravity(glm::vec2(0.0f, -50.0f));
+
+    // The first step sorts the balls from random order, which later steps don't pay for
+    ballController.updateBalls(balls, broadphase.get(), DELTA_TIME, width, height);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; i++) {
+      ballController.updateBalls(balls, broadphase.get(), DELTA_TIME, width, height);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    BenchmarkResult result;
+    result.msPerStep = elapsed.count() / steps;
+    result.energy = 0.0;
+    for (size_t i = 0; i < balls.size(); i++) {
+      result.energy += balls.mass[i] * (balls.velX[i] * balls.velX[i] + balls.velY[i] * balls.velY[i]);
+    }
+    return result;
+  }
+}
+
+int runBenchmark(int argc, char** argv) {
+  int steps = argc > 0 ? std::atoi(argv[0]) : DEFAULT_STEPS;
+  int workers = argc > 1 ? std::atoi(argv[1]) : 0;
+  const char* broadphaseName = argc > 2 ? argv[2] : "grid";
+  const char* radiusName = argc > 3 ? argv[3] : RADIUS_SETS[0].name;
+
+  bool runGrid = std::strcmp(broadphaseName, "grid") == 0 || std::strcmp(broadphaseName, "both") == 0;
+  bool runHierarchical = std::strcmp(broadphaseName, "hgrid") == 0 || std::strcmp(broadphaseName, "both") == 0;
+  const RadiusSet* radii = nullptr;
+  for (const RadiusSet& radiusSet : RADIUS_SETS) {
+    if (std::strcmp(radiusName, radiusSet.name) == 0) {
+      radii = &radiusSet;
+    }
+  }
+  if (steps <= 0 || (!runGrid && !runHierarchical) || !radii) {
+    std::printf("Usage: BallGame --benchmark [steps] [workers] [grid|hgrid|both] [uniform|skewed|outliers]\n");
+    return 1;
+  }
+
+  bool multithreaded = workers > 0;
+  if (multithreaded) {
+    JAGEngine::JobSystem::getInstance().init(workers);
+  }
+
+  std::printf("%d steps, %s, %s radii\n", steps, multithreaded ? "multithreaded" : "single thread", radii->name);
+  for (int numBalls : BALL_COUNTS) {
+    if (runGrid) {
+      BenchmarkResult result = runSteps(numBalls, steps, multithreaded, BroadphaseType::UNIFORM_GRID, *radii);
+      std::printf("%8d balls, grid:  %8.2f ms/step  (energy %.6g)\n", numBalls, result.msPerStep, result.energy);
+    }
+    if (runHierarchical) {
+      BenchmarkResult result = runSteps(numBalls, steps, multithreaded, BroadphaseType::HIERARCHICAL_GRID, *radii);
+      std::printf("%8d balls, hgrid: %8.2f ms/step  (energy %.6g)\n", numBalls, result.msPerStep, result.energy);
+    }
+  }
+
+  if (multithreaded) {
+    JAGEngine::JobSystem::getInstance().destroy();
+  }
+  return 0;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// Headless timing run, started with
+//   BallGame --benchmark [steps] [workers] [grid|hgrid|both] [uniform|skewed|outliers]
+// Steps 10k, 100k and 1M balls at the game's default density without opening a window
+// and prints the ms per step for each. With workers > 0 the JobSystem is started with
+// that many worker threads, otherwise everything runs on the main thread.
+// The broadphase is the uniform grid by default; "both" runs the hierarchical grid on
+// the same balls too. Radii are 2-6 by default; "skewed" makes 1% of the balls 20-60
+// and "outliers" makes 0.1% of them 100-200.
+// Returns the exit code for main.
+int runBenchmark(int argc, char** argv);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Ball.h"
+#include <vector>
+
+enum class BroadphaseType { UNIFORM_GRID, HIERARCHICAL_GRID };
+
+// Finds the balls each ball has to be tested against. BallController only talks to
+// this, so the spatial structure can be swapped at runtime.
+class Broadphase {
+public:
+    struct Range {
+        int begin;
+        int end;
+    };
+    static const int MAX_CANDIDATE_RANGES = 64;
+
+    virtual ~Broadphase() {}
+
+    /// Buckets every ball. The balls have to be reordered with getSortOrder() before
+    /// any of the calls below.
+    virtual void rebuild(const BallData& balls) = 0;
+    /// Index the ball at each sorted position had before the last rebuild
+    virtual const std::vector<int>& getSortOrder() const = 0;
+
+    /// The sorted balls are split into bands. Resolving the balls of one band only
+    /// touches that band and the bands next to it, so bands two apart can be collided
+    /// at the same time.
+    virtual int getNumBands() const = 0;
+    virtual Range getBandBalls(int band) const = 0;
+    /// Fills ranges with the sorted balls this ball has to be tested against and
+    /// returns how many there are. Every pair comes up for exactly one of its two balls.
+    virtual int getCandidates(int ball, Range* ranges) const = 0;
+
+    virtual BroadphaseType getType() const = 0;
+};
@@ -2,6 +2,7 @@
 
 #include "Grid.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
@@ -9,59 +10,100 @@ Grid::Grid(int width, int height, float maxBallSize) :
   m_width(width),
   m_height(height),
   m_cellSize(static_cast<int>(maxBallSize * 2.0f)) {
+  m_invCellSize = 1.0f / m_cellSize;
   m_numXCells = static_cast<int>(std::ceil(static_cast<float>(m_width) / m_cellSize));
   m_numYCells = static_cast<int>(std::ceil(static_cast<float>(m_height) / m_cellSize));
 
-  // Allocate all the cells
-  const int BALLS_TO_RESERVE = 20;
-  m_cells.resize(m_numYCells * m_numXCells);
-  for (auto& cell : m_cells) {
-    cell.balls.reserve(BALLS_TO_RESERVE);
-  }
+  m_cellStarts.resize(m_numYCells * m_numXCells + 1, 0);
 }
 
 Grid::~Grid() {
 }
 
-void Grid::addBall(Ball* ball) {
-    Cell* cell = getCell(ball->position);
-    cell->balls.push_back(ball);
-    ball->ownerCell = cell;
-    ball->cellVectorIndex = cell->balls.size() - 1;
+void Grid::rebuild(const BallData& balls) {
+    const int numBalls = static_cast<int>(balls.size());
+    const int numCells = m_numXCells * m_numYCells;
+    m_ballCells.resize(numBalls);
+    m_sortOrder.resize(numBalls);
+    m_sortedCells.resize(numBalls);
+
+    // Count the balls in each cell, shifted by one so the prefix sum below leaves
+    // each cell's start in place
+    std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0);
+    for (int i = 0; i < numBalls; i++) {
+        int cell = getCellIndex(balls.posX[i], balls.posY[i]);
+        m_ballCells[i] = cell;
+        m_cellStarts[cell + 1]++;
+    }
+
+    for (int c = 0; c < numCells; c++) {
+        m_cellStarts[c + 1] += m_cellStarts[c];
+    }
+
+    // Scatter, walking the balls in order so the sort is stable. Balls were already
+    // sorted last step, so this is close to the identity.
+    for (int i = 0; i < numBalls; i++) {
+        int position = m_cellStarts[m_ballCells[i]]++;
+        m_sortOrder[position] = i;
+        m_sortedCells[position] = m_ballCells[i];
+    }
+
+    // The scatter moved every start to the next cell's start, shift them back
+    for (int c = numCells; c > 0; c--) {
+        m_cellStarts[c] = m_cellStarts[c - 1];
+    }
+    m_cellStarts[0] = 0;
+}
+
+int Grid::getNumBands() const {
+    return (m_numYCells + BAND_ROWS - 1) / BAND_ROWS;
 }
 
-void Grid::addBall(Ball* ball, Cell* cell) {
-    cell->balls.push_back(ball);
-    ball->ownerCell = cell;
-    ball->cellVectorIndex = cell->balls.size() - 1;
+Broadphase::Range Grid::getBandBalls(int band) const {
+    // Cells are stored row by row, so a band of rows is one range
+    int firstRow = band * BAND_ROWS;
+    int endRow = std::min(firstRow + BAND_ROWS, m_numYCells);
+    return Range{ m_cellStarts[firstRow * m_numXCells], m_cellStarts[endRow * m_numXCells] };
 }
 
-Cell* Grid::getCell(int x, int y) {
+int Grid::getCandidates(int ball, Range* ranges) const {
+    const int cell = m_sortedCells[ball];
+    const int x = cell % m_numXCells;
+    const int y = cell / m_numXCells;
+    int numRanges = 0;
+
+    // Cells in a row are stored back to back, so a cell and the one left of it
+    // (and the two cells above those) form one contiguous range
+    const int firstX = x > 0 ? x - 1 : x;
+
+    // Left cell, and the balls before this one in the residing cell
+    ranges[numRanges++] = Range{ m_cellStarts[getCellIndex(firstX, y)], ball };
+
+    // Top left and up cells
+    if (y > 0) {
+        ranges[numRanges++] = Range{ m_cellStarts[getCellIndex(firstX, y - 1)],
+                                     m_cellStarts[getCellIndex(x, y - 1) + 1] };
+    }
+    // Bottom left
+    if (x > 0 && y < m_numYCells - 1) {
+        int bottomLeft = getCellIndex(x - 1, y + 1);
+        ranges[numRanges++] = Range{ m_cellStarts[bottomLeft], m_cellStarts[bottomLeft + 1] };
+    }
+    return numRanges;
+}
+
+int Grid::getCellIndex(int x, int y) const {
     if (x < 0) x = 0;
     if (x >= m_numXCells) x = m_numXCells - 1;
     if (y < 0) y = 0;
     if (y >= m_numYCells) y = m_numYCells - 1;
 
-    return &m_cells[y * m_numXCells + x];
+    return y * m_numXCells + x;
 }
 
-Cell* Grid::getCell(const glm::vec2& pos) {
-    int cellX = (int)(pos.x / m_cellSize);
-    int cellY = (int)(pos.y / m_cellSize);
+int Grid::getCellIndex(float x, float y) const {
+    int cellX = (int)(x * m_invCellSize);
+    int cellY = (int)(y * m_invCellSize);
 
-    return getCell(cellX, cellY);
-}
-
-void Grid::removeBallFromCell(Ball* ball) {
-    std::vector<Ball*>& balls = ball->ownerCell->balls;
-    // Normal vector swap
-    balls[ball->cellVectorIndex] = balls.back();
-    balls.pop_back();
-    // Update vector index
-    if ((size_t)ball->cellVectorIndex < balls.size()) {
-        balls[ball->cellVectorIndex]->cellVectorIndex = ball->cellVectorIndex;
-    }
-    // Set the index of ball to -1
-    ball->cellVectorIndex = -1;
-    ball->ownerCell = nullptr;
+    return getCellIndex(cellX, cellY);
 }
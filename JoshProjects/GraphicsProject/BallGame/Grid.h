@@ -1,32 +1,46 @@
 #pragma once
 
-#include "Ball.h"
+#include "Broadphase.h"
 #include <vector>
 
-struct Cell {
-    std::vector<Ball*> balls;
-};
-
-class Grid {
-    friend class BallController;
+// Screen sized grid with cells big enough for the largest ball. Positions off the
+// screen are clamped into the edge cells.
+class Grid : public Broadphase {
 public:
     Grid(int width, int height, float maxBallSize);
     ~Grid();
 
-    /// Adds a ball and determines which cell it belongs to
-    void addBall(Ball* ball);
-    /// Adds a ball to the specified cell
-    void addBall(Ball* ball, Cell* cell);
-    /// Gets cell based on cell coordinates
-    Cell* getCell(int x, int y);
-    /// Gets cell based on window coordinates
-    Cell* getCell(const glm::vec2& pos);
+    /// Buckets every ball by cell with a counting sort. Once the balls are reordered
+    /// with getSortOrder(), the balls in cell c are [getCellStart(c), getCellStart(c + 1)).
+    void rebuild(const BallData& balls) override;
+    /// Gets cell index based on cell coordinates
+    int getCellIndex(int x, int y) const;
+    /// Gets cell index based on window coordinates
+    int getCellIndex(float x, float y) const;
+
+    int getCellStart(int cell) const { return m_cellStarts[cell]; }
+    const std::vector<int>& getSortOrder() const override { return m_sortOrder; }
 
-    void removeBallFromCell(Ball* ball);
+    /// Bands are strips of BAND_ROWS rows
+    int getNumBands() const override;
+    Range getBandBalls(int band) const override;
+    /// The balls before this one in its cell, the left cell, the two cells above
+    /// those and the cell below left
+    int getCandidates(int ball, Range* ranges) const override;
+
+    BroadphaseType getType() const override { return BroadphaseType::UNIFORM_GRID; }
 
 private:
-    std::vector<Cell> m_cells;
+    /// A ball reaches one row up and one row down, so a band needs at least two rows
+    /// for bands two apart to never share a ball
+    static const int BAND_ROWS = 4;
+
+    std::vector<int> m_cellStarts;  ///< One per cell plus an end marker
+    std::vector<int> m_ballCells;   ///< Cell of each ball, scratch for rebuild
+    std::vector<int> m_sortedCells; ///< Cell of each ball in sorted order
+    std::vector<int> m_sortOrder;
     int m_cellSize;
+    float m_invCellSize;
     int m_width;
     int m_height;
     int m_numXCells;
@@ -0,0 +1,250 @@
+//HierarchicalGrid.cpp
+
+#include "HierarchicalGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  // Keeps the row and column under 30 bits each, so with the level they fit in a key
+  const float COORD_LIMIT = static_cast<float>(1 << 28);
+
+  /// Bits needed to store every value up to and including value
+  int bitsFor(uint64_t value) {
+    int bits = 0;
+    while (value >> bits) bits++;
+    return bits;
+  }
+
+  int clampCoord(float coord) {
+    return static_cast<int>(std::min(std::max(coord, -COORD_LIMIT), COORD_LIMIT));
+  }
+}
+
+HierarchicalGrid::HierarchicalGrid() {
+}
+
+HierarchicalGrid::~HierarchicalGrid() {
+}
+
+void HierarchicalGrid::rebuild(const BallData& balls) {
+    const int numBalls = static_cast<int>(balls.size());
+    m_items.resize(numBalls);
+    m_occupiedLevels = 0;
+    if (numBalls == 0) {
+        m_numLevels = 0;
+        buildCells();
+        return;
+    }
+
+    // The top level fits the biggest ball, and levels are halved while the smallest
+    // ball still fits. Every extra level costs each ball below it a 3x3 lookup, so
+    // radii within 2x of each other all share one level.
+    auto radii = std::minmax_element(balls.radius.begin(), balls.radius.end());
+    const float minRadius = *radii.first;
+    const float maxRadius = *radii.second;
+    m_baseCellSize = maxRadius * 2.0f;
+    for (int level = 1; level < MAX_LEVELS && m_baseCellSize * 0.5f >= minRadius * 2.0f; level++) {
+        m_baseCellSize *= 0.5f;
+    }
+    if (m_baseCellSize <= 0.0f) m_baseCellSize = 1.0f;
+    const float invBaseCellSize = 1.0f / m_baseCellSize;
+
+    auto getLevel = [&](float radius) {
+        int level = 0;
+        float cellSize = m_baseCellSize;
+        while (cellSize < radius * 2.0f && level < MAX_LEVELS - 1) {
+            cellSize *= 2.0f;
+            level++;
+        }
+        return level;
+    };
+    const int topLevel = getLevel(maxRadius);
+    m_numLevels = topLevel + 1;
+
+    // Cells are counted from the lowest ball, with a margin so the cells left of and
+    // above the outermost ones still have coordinates on every level. Only as many
+    // key bits as the balls actually cover are used, which keeps the sort short.
+    auto rangeX = std::minmax_element(balls.posX.begin(), balls.posX.end());
+    auto rangeY = std::minmax_element(balls.posY.begin(), balls.posY.end());
+    const int minX = clampCoord(std::floor(*rangeX.first * invBaseCellSize));
+    const int minY = clampCoord(std::floor(*rangeY.first * invBaseCellSize));
+    const int margin = 2 << topLevel;
+    m_xBits = bitsFor(static_cast<uint64_t>(clampCoord(std::floor(*rangeX.second * invBaseCellSize)) - minX + margin + 1));
+    m_yBits = bitsFor(static_cast<uint64_t>(clampCoord(std::floor(*rangeY.second * invBaseCellSize)) - minY + margin + 1));
+
+    for (int i = 0; i < numBalls; i++) {
+        const int level = getLevel(balls.radius[i]);
+        m_occupiedLevels |= 1u << level;
+
+        // Every level works from the same level 0 coordinates, so a coarser cell is
+        // always exactly the finer cells under it
+        int x = clampCoord(std::floor(balls.posX[i] * invBaseCellSize)) - minX + margin;
+        int y = clampCoord(std::floor(balls.posY[i] * invBaseCellSize)) - minY + margin;
+
+        m_items[i].key = makeKey(level, x >> level, y >> level);
+        m_items[i].ball = i;
+    }
+
+    sortItems();
+    buildCells();
+}
+
+Broadphase::Range HierarchicalGrid::getBandBalls(int band) const {
+    // Band 0 is every ball, there are no others
+    if (band != 0) {
+        return Range{ 0, 0 };
+    }
+    return Range{ 0, static_cast<int>(m_sortOrder.size()) };
+}
+
+int HierarchicalGrid::getCandidates(int ball, Range* ranges) const {
+    // Every ball in a cell shares the ranges, except where its own cell stops
+    const int cell = m_sortedCells[ball];
+    const int first = m_cellRangeStarts[cell];
+    const int numRanges = m_cellRangeStarts[cell + 1] - first;
+    std::copy(m_cellRanges.begin() + first, m_cellRanges.begin() + first + numRanges, ranges);
+    ranges[0].end = ball;
+    return numRanges;
+}
+
+uint64_t HierarchicalGrid::makeKey(int level, int x, int y) const {
+    return (static_cast<uint64_t>(level) << (m_xBits + m_yBits)) |
+           (static_cast<uint64_t>(y) << m_xBits) |
+           static_cast<uint64_t>(x);
+}
+
+void HierarchicalGrid::sortItems() {
+    const size_t numItems = m_items.size();
+    m_itemScratch.resize(numItems);
+
+    const int numBytes = (m_xBits + m_yBits + bitsFor(m_numLevels - 1) + 7) / 8;
+    std::vector<size_t> counts(numBytes * 256, 0);
+    for (const SortItem& item : m_items) {
+        for (int b = 0; b < numBytes; b++) {
+            counts[b * 256 + ((item.key >> (b * 8)) & 0xFF)]++;
+        }
+    }
+
+    for (int b = 0; b < numBytes; b++) {
+        size_t* byteCounts = &counts[b * 256];
+        // Skip bytes every key shares
+        if (byteCounts[(m_items[0].key >> (b * 8)) & 0xFF] == numItems) continue;
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            size_t count = byteCounts[digit];
+            byteCounts[digit] = offset;
+            offset += count;
+        }
+        for (const SortItem& item : m_items) {
+            m_itemScratch[byteCounts[(item.key >> (b * 8)) & 0xFF]++] = item;
+        }
+        m_items.swap(m_itemScratch);
+    }
+}
+
+void HierarchicalGrid::buildCells() {
+    const int numBalls = static_cast<int>(m_items.size());
+    m_sortOrder.resize(numBalls);
+    m_sortedCells.resize(numBalls);
+    m_cellKeys.clear();
+    m_cellStarts.clear();
+
+    for (int i = 0; i < numBalls; i++) {
+        if (i == 0 || m_items[i].key != m_items[i - 1].key) {
+            m_cellKeys.push_back(m_items[i].key);
+            m_cellStarts.push_back(i);
+        }
+        m_sortOrder[i] = m_items[i].ball;
+        m_sortedCells[i] = static_cast<int>(m_cellKeys.size()) - 1;
+    }
+    m_cellStarts.push_back(numBalls);
+
+    buildCellRanges();
+}
+
+void HierarchicalGrid::buildCellRanges() {
+    const size_t numCells = m_cellKeys.size();
+    const uint64_t xMask = (1ull << m_xBits) - 1;
+    const uint64_t yMask = (1ull << m_yBits) - 1;
+    m_cellRanges.clear();
+    m_cellRangeStarts.clear();
+
+    // Cells are visited in sorted order, so the rows above and below on the same
+    // level are found by walking forward. The coarse rows only move forward within
+    // one row of cells, so those cursors start over on every new row.
+    size_t upCursor = 0;
+    size_t downCursor = 0;
+    size_t coarseCursors[MAX_LEVELS][3];
+    // Cells next to each other mostly sit under the same coarse cell, whose ranges
+    // can just be copied from the last cell
+    struct CoarseCache {
+        int x;
+        int firstRange;
+        int numRanges;
+    } coarseCaches[MAX_LEVELS];
+
+    for (size_t cell = 0; cell < numCells; cell++) {
+        const uint64_t key = m_cellKeys[cell];
+        const int level = static_cast<int>(key >> (m_xBits + m_yBits));
+        const int x = static_cast<int>(key & xMask);
+        const int y = static_cast<int>((key >> m_xBits) & yMask);
+        const bool newRow = cell == 0 || (m_cellKeys[cell - 1] >> m_xBits) != (key >> m_xBits);
+        m_cellRangeStarts.push_back(static_cast<int>(m_cellRanges.size()));
+
+        // Left cell, and the balls before each ball in the residing cell. Cells in a
+        // row are sorted by column, so the left cell comes right before this one.
+        bool hasLeft = cell > 0 && m_cellKeys[cell - 1] == key - 1;
+        m_cellRanges.push_back(Range{ m_cellStarts[hasLeft ? cell - 1 : cell], m_cellStarts[cell] });
+
+        // Top left and up cells, then bottom left
+        addRowRange(upCursor, makeKey(level, x - 1, y - 1), makeKey(level, x, y - 1));
+        addRowRange(downCursor, makeKey(level, x - 1, y + 1), makeKey(level, x - 1, y + 1));
+
+        // A ball in a coarser level is no wider than that level's cells, so anything
+        // touching a ball here has its centre in the 3x3 cells around it there
+        for (int coarse = level + 1; coarse < m_numLevels; coarse++) {
+            if (!(m_occupiedLevels & (1u << coarse))) continue;
+
+            const int shift = coarse - level;
+            const int coarseX = x >> shift;
+            const int coarseY = y >> shift;
+            CoarseCache& cache = coarseCaches[coarse];
+            if (!newRow && cache.x == coarseX) {
+                for (int i = 0; i < cache.numRanges; i++) {
+                    Range range = m_cellRanges[cache.firstRange + i];
+                    m_cellRanges.push_back(range);
+                }
+                continue;
+            }
+
+            cache.x = coarseX;
+            cache.firstRange = static_cast<int>(m_cellRanges.size());
+            for (int row = 0; row < 3; row++) {
+                uint64_t firstKey = makeKey(coarse, coarseX - 1, coarseY - 1 + row);
+                size_t& cursor = coarseCursors[coarse][row];
+                if (newRow) {
+                    cursor = std::lower_bound(m_cellKeys.begin(), m_cellKeys.end(), firstKey) - m_cellKeys.begin();
+                }
+                addRowRange(cursor, firstKey, makeKey(coarse, coarseX + 1, coarseY - 1 + row));
+            }
+            cache.numRanges = static_cast<int>(m_cellRanges.size()) - cache.firstRange;
+        }
+    }
+    m_cellRangeStarts.push_back(static_cast<int>(m_cellRanges.size()));
+}
+
+void HierarchicalGrid::addRowRange(size_t& cursor, uint64_t firstKey, uint64_t lastKey) {
+    const size_t numCells = m_cellKeys.size();
+    while (cursor < numCells && m_cellKeys[cursor] < firstKey) {
+        cursor++;
+    }
+    size_t end = cursor;
+    while (end < numCells && m_cellKeys[end] <= lastKey) {
+        end++;
+    }
+    if (end > cursor) {
+        m_cellRanges.push_back(Range{ m_cellStarts[cursor], m_cellStarts[end] });
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Broadphase.h"
+#include <cstdint>
+#include <vector>
+
+// A grid per size of ball, each level's cells twice as big as the level below. Every
+// ball goes in the smallest level its diameter fits in, so a few big balls don't make
+// the cells huge for everyone else. Only occupied cells are stored, sorted by their
+// coordinates instead of indexed into a screen sized array, so balls can be anywhere.
+class HierarchicalGrid : public Broadphase {
+public:
+    HierarchicalGrid();
+    ~HierarchicalGrid();
+
+    /// Sorts the balls by level, then cell row, then cell column, and works out the
+    /// neighbour ranges of every occupied cell
+    void rebuild(const BallData& balls) override;
+    const std::vector<int>& getSortOrder() const override { return m_sortOrder; }
+
+    /// Balls are tested against every coarser level, which can be anywhere in the
+    /// sorted order, so it's all one band
+    int getNumBands() const override { return 1; }
+    Range getBandBalls(int band) const override;
+    /// Same stencil as the uniform grid within the ball's own level, plus the 3x3
+    /// cells around it on every coarser level that has balls
+    int getCandidates(int ball, Range* ranges) const override;
+
+    BroadphaseType getType() const override { return BroadphaseType::HIERARCHICAL_GRID; }
+
+    int getNumLevels() const { return m_numLevels; }
+    int getNumOccupiedCells() const { return static_cast<int>(m_cellKeys.size()); }
+
+private:
+    static const int MAX_LEVELS = 15;
+
+    struct SortItem {
+        uint64_t key;
+        int ball;
+    };
+
+    uint64_t makeKey(int level, int x, int y) const;
+    /// Stable LSD radix sort of m_items, one pass per byte the keys use
+    void sortItems();
+    void buildCells();
+    /// Works out the candidate ranges each occupied cell shares between its balls
+    void buildCellRanges();
+    /// Adds the occupied cells with keys in [firstKey, lastKey] to m_cellRanges as one
+    /// range. cursor only moves forward, so calls have to come in increasing key order.
+    void addRowRange(size_t& cursor, uint64_t firstKey, uint64_t lastKey);
+
+    float m_baseCellSize = 1.0f; ///< Cell size of level 0, the top level fits the biggest ball
+    int m_numLevels = 0;
+    unsigned int m_occupiedLevels = 0; ///< Bit per level that has balls
+    int m_xBits = 0; ///< Key bits used by the cell column
+    int m_yBits = 0; ///< Key bits used by the cell row
+
+    std::vector<SortItem> m_items;
+    std::vector<SortItem> m_itemScratch;
+    std::vector<int> m_sortOrder;
+    std::vector<uint64_t> m_cellKeys;   ///< Key of each occupied cell, in sorted order
+    std::vector<int> m_cellStarts;      ///< First ball of each occupied cell plus an end marker
+    std::vector<int> m_sortedCells;     ///< Occupied cell of each ball in sorted order
+    std::vector<Range> m_cellRanges;    ///< Candidate ranges of every cell back to back
+    std::vector<int> m_cellRangeStarts; ///< First of each cell's ranges plus an end marker
+};
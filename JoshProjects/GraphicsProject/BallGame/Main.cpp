@@ -1,9 +1,15 @@
 //Main.cpp
 
 #include "MainGame.h"
+#include "Benchmark.h"
 #include <JAGEngine/IMainGame.h>
+#include <cstring>
 
 int main(int argc, char** argv) {
+    // "--benchmark" times the simulation headless instead of starting the game
+    if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0) {
+        return runBenchmark(argc - 2, argv + 2);
+    }
 
     MainGame mainGame;
     mainGame.run();
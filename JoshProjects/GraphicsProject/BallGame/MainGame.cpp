@@ -8,6 +8,7 @@
 #include "ImGui/imgui_impl_opengl3.h"
 
 #include <JAGEngine/JAGEngine.h>
+#include <JAGEngine/JobSystem.h>
 
 #include <JAGEngine/ResourceManager.h>
 #include <SDL/SDL.h>
@@ -59,6 +60,7 @@ void MainGame::run() {
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
     m_window.swapBuffer();
+    JAGEngine::JobSystem::getInstance().endFrame();
 
     Uint32 frameTime = SDL_GetTicks() - startTime;
     if (frameTime < 16) {  // Cap at ~60 FPS
@@ -70,12 +72,14 @@ void MainGame::run() {
   ImGui_ImplOpenGL3_Shutdown();
   ImGui_ImplSDL2_Shutdown();
   ImGui::DestroyContext();
+  JAGEngine::JobSystem::getInstance().destroy();
 }
 
 // MainGame.cpp
 
 void MainGame::init() {
   JAGEngine::init();
+  JAGEngine::JobSystem::getInstance().init();
 
   // Create the window without specifying size, using SDL_WINDOW_FULLSCREEN_DESKTOP flag
   m_window.create("Ball Game", 0, 0, SDL_WINDOW_FULLSCREEN_DESKTOP);
@@ -172,8 +176,7 @@ struct BallSpawn {
 };
 
 void MainGame::initBalls() {
-  float maxBallSize = std::max<float>(m_ballSizeRange.x, m_ballSizeRange.y);
-  m_grid = std::make_unique<Grid>(m_screenWidth, m_screenHeight, maxBallSize);
+  createBroadphase();
 
   std::mt19937 randomEngine((unsigned int)time(nullptr));
   std::uniform_real_distribution<float> randX(0.0f, (float)m_screenWidth);
@@ -184,6 +187,11 @@ void MainGame::initBalls() {
   m_balls.clear();
   m_balls.reserve(m_numBalls);
 
+  GLuint textureId = JAGEngine::ResourceManager::getTexture("Textures/circle.png").id;
+  if (textureId == 0) {
+    std::cerr << "Failed to load ball texture!" << std::endl;
+  }
+
   for (int i = 0; i < m_numBalls; i++) {
     glm::vec2 pos(randX(randomEngine), randY(randomEngine));
     float radius = randSize(randomEngine);
@@ -193,16 +201,10 @@ void MainGame::initBalls() {
 
     JAGEngine::ColorRGBA8 color(randColor(randomEngine), randColor(randomEngine), randColor(randomEngine), 255);
 
-    GLuint textureId = JAGEngine::ResourceManager::getTexture("Textures/circle.png").id;
-    if (textureId == 0) {
-      std::cerr << "Failed to load ball texture!" << std::endl;
-    }
-
     // Use radius for mass calculation (assuming uniform density)
     float mass = radius * radius;
 
-    m_balls.emplace_back(radius, mass, pos, velocity, textureId, color);
-    m_grid->addBall(&m_balls.back());
+    m_balls.add(Ball(radius, mass, pos, velocity, textureId, color));
   }
 }
 
@@ -249,7 +251,10 @@ void MainGame::update(float deltaTime) {
   m_ballController.setMaxSpeed(m_maxBallSpeed);
   m_ballController.setSpeedMultiplier(m_ballSpeedMultiplier);
   m_ballController.setFriction(m_friction);
-  m_ballController.updateBalls(m_balls, m_grid.get(), deltaTime, m_screenWidth, m_screenHeight);
+
+  Uint64 physicsStart = SDL_GetPerformanceCounter();
+  m_ballController.updateBalls(m_balls, m_broadphase.get(), deltaTime, m_screenWidth, m_screenHeight);
+  m_physicsMs = (float)((SDL_GetPerformanceCounter() - physicsStart) * 1000.0 / SDL_GetPerformanceFrequency());
   updateGravity();
   // Add some debug output
   static int frameCount = 0;
@@ -388,8 +393,16 @@ void MainGame::updateImGui() {
   ImGui::Separator();
 
   // Configuration sliders
-  ImGui::SliderInt("Number of Balls", &m_numBalls, 100, 10000);
-  ImGui::SliderFloat2("Ball Size Range", &m_ballSizeRange.x, 1.0f, 20.0f, "%.1f");
+  ImGui::SliderInt("Number of Balls", &m_numBalls, 100, 500000, "%d", ImGuiSliderFlags_Logarithmic);
+  ImGui::SliderFloat2("Ball Size Range", &m_ballSizeRange.x, 1.0f, 100.0f, "%.1f", ImGuiSliderFlags_Logarithmic);
+
+  // The hierarchical grid copes better with mixed sizes, the uniform one is faster when they're close
+  const char* broadphaseNames[] = { "Uniform Grid", "Hierarchical Grid" };
+  int broadphase = static_cast<int>(m_broadphaseType);
+  if (ImGui::Combo("Broadphase", &broadphase, broadphaseNames, IM_ARRAYSIZE(broadphaseNames))) {
+    m_broadphaseType = static_cast<BroadphaseType>(broadphase);
+    createBroadphase();
+  }
   ImGui::SliderFloat("Hue Shift", &m_hueShift, 0.0f, 360.0f);
 
   ImGui::Text("Speed Controls:");
@@ -429,6 +442,13 @@ void MainGame::updateImGui() {
     reinitializeGame();
   }
 
+  bool multithreaded = m_ballController.isMultithreaded();
+  if (ImGui::Checkbox("Multithreaded Physics", &multithreaded)) {
+    m_ballController.setMultithreaded(multithreaded);
+  }
+  ImGui::Text("Physics: %.2f ms for %d balls on %u threads", m_physicsMs, (int)m_balls.size(),
+              multithreaded ? JAGEngine::JobSystem::getInstance().getNumThreads() : 1u);
+
   ImGui::Text("ImGui Debug Info:");
   ImGui::Text("Window Position: (%.1f, %.1f)", ImGui::GetWindowPos().x, ImGui::GetWindowPos().y);
   ImGui::Text("Window Size: (%.1f, %.1f)", ImGui::GetWindowSize().x, ImGui::GetWindowSize().y);
@@ -453,9 +473,21 @@ void MainGame::updateGravity() {
     << ", Gravity Vector: (" << gravityVec.x << ", " << gravityVec.y << ")" << std::endl;
 }
 
+void MainGame::createBroadphase() {
+  switch (m_broadphaseType) {
+  case BroadphaseType::UNIFORM_GRID: {
+    float maxBallSize = std::max<float>(m_ballSizeRange.x, m_ballSizeRange.y);
+    m_broadphase = std::make_unique<Grid>(m_screenWidth, m_screenHeight, maxBallSize);
+    break;
+  }
+  case BroadphaseType::HIERARCHICAL_GRID:
+    m_broadphase = std::make_unique<HierarchicalGrid>();
+    break;
+  }
+}
+
 void MainGame::reinitializeGame() {
   m_balls.clear();
-  m_grid = std::make_unique<Grid>(m_screenWidth, m_screenHeight, CELL_SIZE);
   initBalls();
   m_ballController.setMaxSpeed(m_maxBallSpeed);
   m_ballController.setSpeedMultiplier(m_ballSpeedMultiplier);
@@ -13,6 +13,7 @@
 #include "BallRenderer.h"
 #include "BallGameCamera.h"
 #include "Grid.h"
+#include "HierarchicalGrid.h"
 
 // TODO:
 // Visualize momentum with color
@@ -44,6 +45,8 @@ private:
     void processInput();
     void updateImGui();
     void updateGravity();
+    /// Makes a new broadphase of m_broadphaseType for the current ball sizes
+    void createBroadphase();
 
     void reinitializeGame();
 
@@ -58,8 +61,9 @@ private:
     int m_screenWidth = 0;
     int m_screenHeight = 0;
 
-    std::vector<Ball> m_balls; ///< All the balls
-    std::unique_ptr<Grid> m_grid; ///< Grid for spatial partitioning for collision
+    BallData m_balls; ///< All the balls
+    std::unique_ptr<Broadphase> m_broadphase; ///< Spatial partitioning for collision
+    BroadphaseType m_broadphaseType = BroadphaseType::UNIFORM_GRID;
 
     int m_currentRenderer = 0;
     std::vector<std::unique_ptr<BallRenderer> > m_ballRenderers;
@@ -75,6 +79,7 @@ private:
 
     JAGEngine::FpsLimiter m_fpsLimiter; ///< Limits and calculates fps
     float m_fps = 0.0f;
+    float m_physicsMs = 0.0f; ///< Time the last updateBalls took
     float m_hueShift = 0.0f;
 
     GameState m_gameState = GameState::RUNNING; ///< The state of the game
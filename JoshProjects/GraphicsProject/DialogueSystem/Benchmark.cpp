@@ -0,0 +1,149 @@
+//Benchmark.cpp
+
+#include "Benchmark.h"
+#include "DialogueProject.h"
+#include "DialogueSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    const int DEFAULT_NODES = 100000;
+    const int NODES_PER_TREE = 100;
+    const int AUTOSAVE_ROUNDS = 10;
+    const char* PROJECT_DIRECTORY = "BenchmarkProject";
+    const char* YAML_PATH = "BenchmarkProject.yaml";
+
+    double msSince(std::chrono::steady_clock::time_point startTime) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    // Each tree is a binary tree of NODES_PER_TREE nodes. Every so often a node gets a
+    // parameter, a condition with a branch, or a response, so the string pool and the
+    // side tables aren't empty. Returns the nodes in creation order.
+    std::vector<std::shared_ptr<DialogueNode>> generateProject(DialogueManager& manager, int numNodes) {
+        manager.createResponse(ResponseType::Greeting, "Hello there!");
+
+        std::vector<std::shared_ptr<DialogueNode>> nodes;
+        nodes.reserve(numNodes);
+        for (int i = 0; i < numNodes; i++) {
+            auto type = static_cast<DialogueNode::NodeType>(i % 5);
+            auto node = manager.createDialogueNode(type, "Line " + std::to_string(i) + " spoken by [NPC1]");
+
+            int treeStart = i - i % NODES_PER_TREE;
+            int local = i - treeStart;
+            if (local > 0) {
+                nodes[treeStart + (local - 1) / 2]->addChildNode(node, local % 2 ? "Yes" : "No");
+            }
+            if (i % 10 == 0) {
+                node->setParameterWithType("NPC1", "Bob", ParameterType::NPCName);
+            }
+            if (i % 50 == 3) {
+                node->setCondition(DialogueCondition::CreateQuestCondition("find_the_map", "Completed"));
+                node->setBranchCondition(0, BranchCondition::CreateInventoryRange("gold", 1, 5));
+            }
+            if (i % 30 == 1) {
+                node->setResponse(manager.getResponse(ResponseType::Greeting));
+            }
+            nodes.push_back(node);
+        }
+        return nodes;
+    }
+}
+
+int runBenchmark(int argc, char** argv) {
+    int numNodes = argc > 0 ? std::atoi(argv[0]) : DEFAULT_NODES;
+    if (numNodes < NODES_PER_TREE) {
+        std::printf("Usage: DialogueSystem --benchmark [nodes], at least %d nodes\n", NODES_PER_TREE);
+        return 1;
+    }
+
+    // The manager and project log every node and tree; keep the output to the timings
+    std::cout.setstate(std::ios::failbit);
+    std::cerr.setstate(std::ios::failbit);
+
+    std::error_code error;
+    std::filesystem::remove_all(PROJECT_DIRECTORY, error);
+
+    DialogueManager manager;
+    auto startTime = std::chrono::steady_clock::now();
+    auto nodes = generateProject(manager, numNodes);
+    double generateMs = msSince(startTime);
+
+    DialogueProject project(PROJECT_DIRECTORY);
+    startTime = std::chrono::steady_clock::now();
+    bool saved = project.saveAll(manager);
+    double saveAllMs = msSince(startTime);
+
+    // What autosave does after one line is edited, averaged over a few trees since the
+    // first write after a full save is slower while the OS flushes it
+    int treesWritten = 0;
+    double saveDirtyMs = 0.0;
+    for (int i = 0; i < AUTOSAVE_ROUNDS; i++) {
+        nodes[(i * 7919 + numNodes / 2) % numNodes]->setText("Edited line " + std::to_string(i));
+        startTime = std::chrono::steady_clock::now();
+        int written = project.saveDirty(manager);
+        saveDirtyMs += msSince(startTime) / AUTOSAVE_ROUNDS;
+        treesWritten = written < 0 ? written : std::max(treesWritten, written);
+    }
+
+    // A response edit touches no tree, only the manifest is rewritten
+    manager.getResponse(ResponseType::Greeting)->setTextForPersonality(PersonalityType::Grumpy, "What.", true);
+    manager.markResponsesChanged();
+    startTime = std::chrono::steady_clock::now();
+    int manifestWritten = project.saveDirty(manager);
+    double saveResponsesMs = msSince(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    bool exported = DialogueProject::exportYaml(manager, YAML_PATH);
+    double exportMs = msSince(startTime);
+
+    DialogueManager reloaded;
+    DialogueProject reloadedProject(PROJECT_DIRECTORY);
+    startTime = std::chrono::steady_clock::now();
+    bool opened = reloadedProject.open(reloaded);
+    double openMs = msSince(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    reloadedProject.loadTree(reloaded, nodes[0]->getId());
+    double loadTreeMs = msSince(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    reloadedProject.loadAllTrees(reloaded);
+    double loadAllMs = msSince(startTime);
+    size_t treesLoaded = reloadedProject.getTrees().size();
+    size_t nodesLoaded = reloaded.getAllNodes().size();
+
+    DialogueManager imported;
+    startTime = std::chrono::steady_clock::now();
+    bool importedOk = DialogueProject::importYaml(imported, YAML_PATH);
+    double importMs = msSince(startTime);
+    size_t nodesImported = imported.getAllNodes().size();
+
+    std::filesystem::remove_all(PROJECT_DIRECTORY, error);
+    std::filesystem::remove(YAML_PATH, error);
+    std::cout.clear();
+    std::cerr.clear();
+
+    if (!saved || treesWritten < 0 || manifestWritten < 0 || !exported || !opened || !importedOk) {
+        std::fprintf(stderr, "Benchmark failed: save %d, autosave %d/%d, export %d, open %d, import %d\n",
+            (int)saved, treesWritten, manifestWritten, (int)exported, (int)opened, (int)importedOk);
+        return 1;
+    }
+
+    std::printf("%d nodes in %d trees (generated in %.0f ms)\n", numNodes, numNodes / NODES_PER_TREE, generateMs);
+    std::printf("  save all           %8.1f ms\n", saveAllMs);
+    std::printf("  autosave 1 tree    %8.2f ms (mean of %d)\n", saveDirtyMs, AUTOSAVE_ROUNDS);
+    std::printf("  autosave responses %8.2f ms\n", saveResponsesMs);
+    std::printf("  open manifest      %8.2f ms\n", openMs);
+    std::printf("  load one tree      %8.2f ms\n", loadTreeMs);
+    std::printf("  load all trees     %8.1f ms (%zu trees, %zu nodes)\n", loadAllMs, treesLoaded, nodesLoaded);
+    std::printf("  YAML export        %8.1f ms\n", exportMs);
+    std::printf("  YAML import        %8.1f ms (%zu nodes)\n", importMs, nodesImported);
+    return 0;
+}
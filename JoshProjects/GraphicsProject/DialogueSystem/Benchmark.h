@@ -0,0 +1,11 @@
+//Benchmark.h
+
+#pragma once
+
+// Headless timing run, started with "DialogueSystem --benchmark [nodes]". Generates a
+// project of 100-node trees (100,000 nodes by default) in a scratch directory without
+// opening a window, then prints how long a full save, an autosave after one edit, opening
+// the manifest, reading one tree, reading every tree, and a YAML export and import take.
+// The scratch directory and export are removed afterwards.
+// Returns the exit code for main.
+int runBenchmark(int argc, char** argv);
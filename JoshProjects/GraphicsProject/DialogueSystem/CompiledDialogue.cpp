@@ -0,0 +1,544 @@
+//CompiledDialogue.cpp
+
+#include "CompiledDialogue.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+namespace DialogueRuntime {
+
+    namespace {
+        const uint32_t BLOB_MAGIC = 0x43474C44; // "DLGC"
+        const uint32_t BLOB_VERSION = 2;
+
+        struct BlobHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t nodeCount;
+            uint32_t edgeCount;
+            uint32_t tokenCount;
+            uint32_t symbolCount;
+            uint32_t rootCount;
+            uint32_t stringSize;
+        };
+
+        static_assert(std::is_trivially_copyable<CompiledNode>::value, "CompiledNode is written as raw bytes");
+        static_assert(std::is_trivially_copyable<CompiledEdge>::value, "CompiledEdge is written as raw bytes");
+        static_assert(std::is_trivially_copyable<TextToken>::value, "TextToken is written as raw bytes");
+
+        template<typename T>
+        void writeArray(std::vector<uint8_t>& blob, const std::vector<T>& values) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+            blob.insert(blob.end(), bytes, bytes + values.size() * sizeof(T));
+        }
+
+        template<typename T>
+        bool readArray(const uint8_t*& cursor, const uint8_t* end, std::vector<T>& values, uint32_t count) {
+            size_t bytes = (size_t)count * sizeof(T);
+            if ((size_t)(end - cursor) < bytes) {
+                return false;
+            }
+            values.resize(count);
+            if (bytes > 0) {
+                memcpy(values.data(), cursor, bytes);
+            }
+            cursor += bytes;
+            return true;
+        }
+
+        bool parseInt(const std::string& text, int32_t& value) {
+            try {
+                value = std::stoi(text);
+                return true;
+            }
+            catch (...) {
+                return false;
+            }
+        }
+    }
+
+    void CompiledDialogue::clear() {
+        m_nodes.clear();
+        m_edges.clear();
+        m_tokens.clear();
+        m_symbols.clear();
+        m_rootNodes.clear();
+        m_strings.clear();
+        m_nodeLookup.clear();
+        m_symbolLookup.clear();
+    }
+
+    void CompiledDialogue::compile(const DialogueManager& manager) {
+        clear();
+
+        // Sorted by id so the same tree always compiles to the same blob
+        auto sourceNodes = manager.getAllNodes();
+        std::sort(sourceNodes.begin(), sourceNodes.end(),
+            [](const std::shared_ptr<DialogueNode>& a, const std::shared_ptr<DialogueNode>& b) {
+                return a->getId() < b->getId();
+            });
+
+        std::unordered_map<int, uint32_t> indexById;
+        for (size_t i = 0; i < sourceNodes.size(); i++) {
+            indexById[sourceNodes[i]->getId()] = (uint32_t)i;
+        }
+
+        m_nodes.resize(sourceNodes.size());
+        for (size_t i = 0; i < sourceNodes.size(); i++) {
+            const auto& source = sourceNodes[i];
+            CompiledNode& node = m_nodes[i];
+            node.sourceId = source->getId();
+            node.type = static_cast<uint32_t>(source->getType());
+            node.condition = compileCondition(source->getCondition());
+
+            int rootId = manager.findRootNodeId(source->getId());
+            compileText(source->getText(), manager.getTreeParameters(rootId), node);
+
+            const auto& children = source->getChildren();
+            node.firstEdge = (uint32_t)m_edges.size();
+            node.edgeCount = (uint32_t)children.size();
+            for (size_t c = 0; c < children.size(); c++) {
+                CompiledEdge edge;
+                auto it = indexById.find(children[c].first->getId());
+                edge.target = it != indexById.end() ? it->second : INVALID_INDEX;
+                edge.label = addString(children[c].second.c_str(), children[c].second.size());
+                edge.condition = compileBranchCondition(source->getBranchCondition((int)c));
+                m_edges.push_back(edge);
+            }
+
+            if (!manager.hasParent(source->getId())) {
+                m_rootNodes.push_back((uint32_t)i);
+            }
+        }
+
+        rebuildLookups();
+    }
+
+    StringRef CompiledDialogue::addString(const char* text, size_t length) {
+        StringRef ref;
+        ref.offset = (uint32_t)m_strings.size();
+        ref.length = (uint32_t)length;
+        m_strings.insert(m_strings.end(), text, text + length);
+        m_strings.push_back('\0');
+        return ref;
+    }
+
+    uint32_t CompiledDialogue::intern(const std::string& name) {
+        auto it = m_symbolLookup.find(name);
+        if (it != m_symbolLookup.end()) {
+            return it->second;
+        }
+        uint32_t symbol = (uint32_t)m_symbols.size();
+        m_symbols.push_back(addString(name.c_str(), name.size()));
+        m_symbolLookup[name] = symbol;
+        return symbol;
+    }
+
+    CompiledCondition CompiledDialogue::compileCondition(const DialogueCondition& condition) {
+        CompiledCondition compiled;
+        compiled.type = static_cast<uint32_t>(condition.type);
+
+        switch (condition.type) {
+        case ConditionType::RelationshipStatus:
+            compiled.minValue = static_cast<int32_t>(condition.relationshipThreshold);
+            break;
+        case ConditionType::QuestStatus:
+            compiled.symbol = intern(condition.parameterName);
+            compiled.value = intern(condition.parameterValue);
+            break;
+        case ConditionType::InventoryCheck:
+        case ConditionType::StatCheck:
+            compiled.symbol = intern(condition.parameterName);
+            // An unparseable amount fails at runtime in the editor, make it unreachable here
+            if (!parseInt(condition.parameterValue, compiled.minValue)) {
+                compiled.minValue = INT_MAX;
+            }
+            break;
+        case ConditionType::TimeOfDay:
+            compiled.value = intern(condition.parameterName);
+            break;
+        default:
+            break;
+        }
+        return compiled;
+    }
+
+    CompiledCondition CompiledDialogue::compileBranchCondition(const BranchCondition& condition) {
+        CompiledCondition compiled;
+        compiled.type = static_cast<uint32_t>(condition.type);
+
+        switch (condition.type) {
+        case ConditionType::RelationshipStatus:
+            compiled.minValue = static_cast<int32_t>(condition.minRelationship);
+            compiled.maxValue = static_cast<int32_t>(condition.maxRelationship);
+            break;
+        case ConditionType::InventoryCheck:
+            compiled.symbol = intern(condition.itemId);
+            compiled.minValue = condition.minQuantity;
+            compiled.maxValue = condition.maxQuantity;
+            break;
+        case ConditionType::StatCheck:
+            compiled.symbol = intern(condition.statName);
+            compiled.minValue = condition.minValue;
+            compiled.maxValue = condition.maxValue;
+            break;
+        case ConditionType::QuestStatus:
+            compiled.symbol = intern(condition.questId);
+            compiled.value = intern(condition.questStatus);
+            break;
+        case ConditionType::TimeOfDay:
+            compiled.value = intern(condition.timeOfDay);
+            break;
+        case ConditionType::Custom:
+            compiled.symbol = intern(condition.parameterName);
+            compiled.maxValue = condition.parameterValue == "True" ? 1 : 0;
+            break;
+        default:
+            break;
+        }
+        return compiled;
+    }
+
+    void CompiledDialogue::compileText(const std::string& text,
+        const std::map<std::string, std::string>& treeParameters, CompiledNode& node) {
+
+        node.firstToken = (uint32_t)m_tokens.size();
+
+        std::string literal;
+        auto flushLiteral = [this, &literal]() {
+            if (literal.empty()) return;
+            TextToken token;
+            token.text = addString(literal.c_str(), literal.size());
+            m_tokens.push_back(token);
+            literal.clear();
+        };
+
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t open = text.find('[', pos);
+            size_t close = open != std::string::npos ? text.find(']', open + 1) : std::string::npos;
+            if (close == std::string::npos) {
+                literal.append(text, pos, std::string::npos);
+                break;
+            }
+
+            literal.append(text, pos, open - pos);
+            std::string name = text.substr(open + 1, close - open - 1);
+
+            // Tree parameters are fixed for a shipped tree, so bake them in
+            auto param = treeParameters.find(name);
+            if (param != treeParameters.end()) {
+                literal += param->second;
+            }
+            else {
+                flushLiteral();
+                TextToken token;
+                token.text = addString(text.c_str() + open, close - open + 1);
+                token.slot = intern(name);
+                m_tokens.push_back(token);
+            }
+            pos = close + 1;
+        }
+        flushLiteral();
+
+        node.tokenCount = (uint32_t)m_tokens.size() - node.firstToken;
+    }
+
+    void CompiledDialogue::rebuildLookups() {
+        m_nodeLookup.clear();
+        m_nodeLookup.reserve(m_nodes.size());
+        for (uint32_t i = 0; i < (uint32_t)m_nodes.size(); i++) {
+            m_nodeLookup.push_back(std::make_pair(m_nodes[i].sourceId, i));
+        }
+        std::sort(m_nodeLookup.begin(), m_nodeLookup.end());
+
+        m_symbolLookup.clear();
+        for (uint32_t i = 0; i < (uint32_t)m_symbols.size(); i++) {
+            m_symbolLookup[getString(m_symbols[i])] = i;
+        }
+    }
+
+    uint32_t CompiledDialogue::findNode(int sourceId) const {
+        auto it = std::lower_bound(m_nodeLookup.begin(), m_nodeLookup.end(), std::make_pair((int32_t)sourceId, 0u));
+        if (it != m_nodeLookup.end() && it->first == sourceId) {
+            return it->second;
+        }
+        return INVALID_INDEX;
+    }
+
+    uint32_t CompiledDialogue::findSymbol(const std::string& name) const {
+        auto it = m_symbolLookup.find(name);
+        return it != m_symbolLookup.end() ? it->second : INVALID_INDEX;
+    }
+
+    const char* CompiledDialogue::getSymbolName(uint32_t symbol) const {
+        return symbol < m_symbols.size() ? getString(m_symbols[symbol]) : "";
+    }
+
+    int32_t CompiledDialogue::getItemCount(uint32_t symbol, const DialogueContext& context) const {
+        return symbol < context.itemCountSize ? context.itemCounts[symbol] : 0;
+    }
+
+    int32_t CompiledDialogue::getStat(uint32_t symbol, const DialogueContext& context) const {
+        return symbol < context.statSize ? context.stats[symbol] : 0;
+    }
+
+    uint32_t CompiledDialogue::getQuestState(uint32_t symbol, const DialogueContext& context) const {
+        if (symbol < context.questStateSize && context.questStates[symbol] != INVALID_INDEX) {
+            return context.questStates[symbol];
+        }
+        // A quest with no state matches no status, like DialogueManager::checkQuestStatus.
+        // Every compiled status is an interned symbol, so INVALID_INDEX never equals one.
+        return INVALID_INDEX;
+    }
+
+    bool CompiledDialogue::evaluateCondition(const CompiledCondition& condition, const DialogueContext& context) const {
+        switch (static_cast<ConditionType>(condition.type)) {
+        case ConditionType::None:
+            return true;
+        case ConditionType::RelationshipStatus:
+            return static_cast<int32_t>(context.relationship) >= condition.minValue;
+        case ConditionType::QuestStatus:
+            return getQuestState(condition.symbol, context) == condition.value;
+        case ConditionType::InventoryCheck:
+            return getItemCount(condition.symbol, context) >= condition.minValue;
+        case ConditionType::StatCheck:
+            return getStat(condition.symbol, context) >= condition.minValue;
+        case ConditionType::TimeOfDay:
+            return context.timeOfDay == condition.value;
+        case ConditionType::Custom:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool CompiledDialogue::evaluateBranchCondition(const CompiledCondition& condition, const DialogueContext& context) const {
+        switch (static_cast<ConditionType>(condition.type)) {
+        case ConditionType::RelationshipStatus: {
+            int32_t relationship = static_cast<int32_t>(context.relationship);
+            return relationship >= condition.minValue && relationship <= condition.maxValue;
+        }
+        case ConditionType::InventoryCheck: {
+            int32_t quantity = getItemCount(condition.symbol, context);
+            return quantity >= condition.minValue && quantity <= condition.maxValue;
+        }
+        case ConditionType::StatCheck: {
+            int32_t value = getStat(condition.symbol, context);
+            return value >= condition.minValue && value <= condition.maxValue;
+        }
+        case ConditionType::QuestStatus:
+            return getQuestState(condition.symbol, context) == condition.value;
+        case ConditionType::TimeOfDay:
+            return context.timeOfDay == condition.value;
+        case ConditionType::Custom:
+            return condition.maxValue != 0;
+        default:
+            return false;
+        }
+    }
+
+    uint32_t CompiledDialogue::findNextNode(uint32_t nodeIndex, const DialogueContext& context) const {
+        if (nodeIndex >= m_nodes.size()) {
+            return INVALID_INDEX;
+        }
+
+        const CompiledNode& node = m_nodes[nodeIndex];
+        if (static_cast<DialogueNode::NodeType>(node.type) != DialogueNode::NodeType::ConditionCheck) {
+            // Everything else lets the caller pick the branch
+            return nodeIndex;
+        }
+        if (node.edgeCount == 0) {
+            return INVALID_INDEX;
+        }
+
+        const CompiledEdge* edges = m_edges.data() + node.firstEdge;
+        for (uint32_t i = 0; i < node.edgeCount; i++) {
+            const CompiledCondition& branch = edges[i].condition;
+            if (static_cast<ConditionType>(branch.type) == ConditionType::None) {
+                // No branch condition, the node's own condition picks success (0) or failure (1)
+                bool passed = evaluateCondition(node.condition, context);
+                if ((passed && i == 0) || (!passed && i == 1)) {
+                    return edges[i].target;
+                }
+            }
+            else if (evaluateBranchCondition(branch, context)) {
+                return edges[i].target;
+            }
+        }
+
+        // If no branch condition is met, use the first branch as default
+        return edges[0].target;
+    }
+
+    size_t CompiledDialogue::renderText(uint32_t nodeIndex, const DialogueContext& context,
+        char* buffer, size_t bufferSize) const {
+
+        if (bufferSize > 0) {
+            buffer[0] = '\0';
+        }
+        if (nodeIndex >= m_nodes.size()) {
+            return 0;
+        }
+
+        const CompiledNode& node = m_nodes[nodeIndex];
+        size_t length = 0;
+        for (uint32_t i = 0; i < node.tokenCount; i++) {
+            const TextToken& token = m_tokens[node.firstToken + i];
+
+            const char* text = getString(token.text);
+            size_t textLength = token.text.length;
+            if (token.slot < context.slotValueSize && context.slotValues[token.slot] != nullptr) {
+                text = context.slotValues[token.slot];
+                textLength = strlen(text);
+            }
+
+            if (length + 1 < bufferSize) {
+                size_t copy = std::min(textLength, bufferSize - 1 - length);
+                memcpy(buffer + length, text, copy);
+                buffer[length + copy] = '\0';
+            }
+            length += textLength;
+        }
+        return length;
+    }
+
+    std::vector<uint8_t> CompiledDialogue::serialize() const {
+        BlobHeader header;
+        header.magic = BLOB_MAGIC;
+        header.version = BLOB_VERSION;
+        header.nodeCount = (uint32_t)m_nodes.size();
+        header.edgeCount = (uint32_t)m_edges.size();
+        header.tokenCount = (uint32_t)m_tokens.size();
+        header.symbolCount = (uint32_t)m_symbols.size();
+        header.rootCount = (uint32_t)m_rootNodes.size();
+        header.stringSize = (uint32_t)m_strings.size();
+
+        std::vector<uint8_t> blob;
+        blob.reserve(sizeof(header) + m_nodes.size() * sizeof(CompiledNode) + m_edges.size() * sizeof(CompiledEdge) +
+            m_tokens.size() * sizeof(TextToken) + m_symbols.size() * sizeof(StringRef) +
+            m_rootNodes.size() * sizeof(uint32_t) + m_strings.size());
+
+        const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+        blob.insert(blob.end(), headerBytes, headerBytes + sizeof(header));
+        writeArray(blob, m_nodes);
+        writeArray(blob, m_edges);
+        writeArray(blob, m_tokens);
+        writeArray(blob, m_symbols);
+        writeArray(blob, m_rootNodes);
+        writeArray(blob, m_strings);
+        return blob;
+    }
+
+    bool CompiledDialogue::deserialize(const uint8_t* data, size_t size) {
+        clear();
+
+        BlobHeader header;
+        if (size < sizeof(header)) {
+            return false;
+        }
+        memcpy(&header, data, sizeof(header));
+        if (header.magic != BLOB_MAGIC || header.version != BLOB_VERSION) {
+            std::cerr << "Compiled dialogue has the wrong magic or version" << std::endl;
+            return false;
+        }
+
+        const uint8_t* cursor = data + sizeof(header);
+        const uint8_t* end = data + size;
+        bool ok = readArray(cursor, end, m_nodes, header.nodeCount) &&
+            readArray(cursor, end, m_edges, header.edgeCount) &&
+            readArray(cursor, end, m_tokens, header.tokenCount) &&
+            readArray(cursor, end, m_symbols, header.symbolCount) &&
+            readArray(cursor, end, m_rootNodes, header.rootCount) &&
+            readArray(cursor, end, m_strings, header.stringSize);
+        if (!ok) {
+            std::cerr << "Compiled dialogue is truncated" << std::endl;
+            clear();
+            return false;
+        }
+        if (!isValid()) {
+            std::cerr << "Compiled dialogue is corrupt" << std::endl;
+            clear();
+            return false;
+        }
+
+        rebuildLookups();
+        return true;
+    }
+
+    bool CompiledDialogue::isValidString(const StringRef& ref) const {
+        // The terminator has to be where the length says, getString hands out bare pointers
+        uint64_t end = (uint64_t)ref.offset + ref.length;
+        return end < m_strings.size() && m_strings[(size_t)end] == '\0';
+    }
+
+    bool CompiledDialogue::isValidSymbol(uint32_t symbol) const {
+        return symbol == INVALID_INDEX || symbol < m_symbols.size();
+    }
+
+    bool CompiledDialogue::isValidCondition(const CompiledCondition& condition) const {
+        return isValidSymbol(condition.symbol) && isValidSymbol(condition.value);
+    }
+
+    bool CompiledDialogue::isValid() const {
+        if (!m_strings.empty() && m_strings.back() != '\0') {
+            return false;
+        }
+        for (const StringRef& symbol : m_symbols) {
+            if (!isValidString(symbol)) {
+                return false;
+            }
+        }
+        for (const TextToken& token : m_tokens) {
+            if (!isValidString(token.text) || !isValidSymbol(token.slot)) {
+                return false;
+            }
+        }
+        for (const CompiledEdge& edge : m_edges) {
+            // Children that weren't compiled are stored as INVALID_INDEX
+            bool validTarget = edge.target == INVALID_INDEX || edge.target < m_nodes.size();
+            if (!validTarget || !isValidString(edge.label) || !isValidCondition(edge.condition)) {
+                return false;
+            }
+        }
+        for (const CompiledNode& node : m_nodes) {
+            if ((uint64_t)node.firstToken + node.tokenCount > m_tokens.size() ||
+                (uint64_t)node.firstEdge + node.edgeCount > m_edges.size() ||
+                !isValidCondition(node.condition)) {
+                return false;
+            }
+        }
+        for (uint32_t root : m_rootNodes) {
+            if (root >= m_nodes.size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool CompiledDialogue::saveToFile(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open " << path << " for writing" << std::endl;
+            return false;
+        }
+        std::vector<uint8_t> blob = serialize();
+        file.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+        return file.good();
+    }
+
+    bool CompiledDialogue::loadFromFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open " << path << std::endl;
+            return false;
+        }
+        std::vector<uint8_t> blob((size_t)file.tellg());
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(blob.data()), blob.size());
+        return file.good() && deserialize(blob.data(), blob.size());
+    }
+}
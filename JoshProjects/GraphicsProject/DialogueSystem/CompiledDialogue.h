@@ -0,0 +1,149 @@
+//CompiledDialogue.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DialogueSystem.h"
+
+// ==========================================================
+// Compiled dialogue runtime
+// ==========================================================
+//
+// DialogueManager is the authoring model: shared_ptr graphs, string maps and
+// placeholder text. CompiledDialogue is what a shipping game walks instead. It is a
+// flat table of nodes and edges addressed by index, every name (item, quest, stat,
+// parameter, quest status, time of day) is interned to a symbol id, and node text is
+// split into literal runs and parameter slots ahead of time. Nothing on the
+// evaluate/render path allocates.
+
+namespace DialogueRuntime {
+
+    const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    // Everything below is plain data so the tables can be written out as-is
+    struct StringRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    struct CompiledCondition {
+        uint32_t type = 0;               // ConditionType
+        uint32_t symbol = INVALID_INDEX; // Item, quest, stat or custom parameter name
+        uint32_t value = INVALID_INDEX;  // Quest status or time of day
+        int32_t minValue = 0;            // Relationship, quantity or stat lower bound
+        int32_t maxValue = 0;            // Upper bound; for custom branches 1 means "True"
+    };
+
+    // Child link. Branch conditions live on the edge because they belong to the
+    // parent's branch slot, not to the child node.
+    struct CompiledEdge {
+        uint32_t target = INVALID_INDEX;
+        StringRef label;
+        CompiledCondition condition;
+    };
+
+    // A run of literal text, or a slot when slot != INVALID_INDEX. Slot tokens keep
+    // their "[NAME]" text so an unset slot renders like the authoring view does.
+    struct TextToken {
+        StringRef text;
+        uint32_t slot = INVALID_INDEX;
+    };
+
+    struct CompiledNode {
+        int32_t sourceId = -1;
+        uint32_t type = 0;          // DialogueNode::NodeType
+        uint32_t firstToken = 0;
+        uint32_t tokenCount = 0;
+        uint32_t firstEdge = 0;
+        uint32_t edgeCount = 0;
+        CompiledCondition condition;
+    };
+
+    // Game state the runtime reads. The arrays are indexed by symbol id (size them with
+    // getSymbolCount() and fill them using findSymbol()); anything past the end counts
+    // as zero / no quest state / unset.
+    struct DialogueContext {
+        RelationshipStatus relationship = RelationshipStatus::Neutral;
+        uint32_t timeOfDay = INVALID_INDEX;
+
+        const int32_t* itemCounts = nullptr;
+        uint32_t itemCountSize = 0;
+        const int32_t* stats = nullptr;
+        uint32_t statSize = 0;
+        const uint32_t* questStates = nullptr; // Status symbol per quest symbol
+        uint32_t questStateSize = 0;
+        const char* const* slotValues = nullptr; // Replacement text per parameter symbol
+        uint32_t slotValueSize = 0;
+    };
+
+    class CompiledDialogue {
+    public:
+        // Flattens every node in the manager. Tree parameters are baked into the text
+        // of their tree; placeholders without one become runtime slots.
+        void compile(const DialogueManager& manager);
+        void clear();
+
+        // Binary blob, native endian. Load returns false on a bad or truncated blob.
+        std::vector<uint8_t> serialize() const;
+        bool deserialize(const uint8_t* data, size_t size);
+        bool saveToFile(const std::string& path) const;
+        bool loadFromFile(const std::string& path);
+
+        // Index of the authored node id, INVALID_INDEX if it wasn't compiled
+        uint32_t findNode(int sourceId) const;
+        // Symbol id for a name, INVALID_INDEX if no node references it
+        uint32_t findSymbol(const std::string& name) const;
+        const char* getSymbolName(uint32_t symbol) const;
+
+        // Same rules as DialogueManager::findNextNode, returns a node index
+        uint32_t findNextNode(uint32_t nodeIndex, const DialogueContext& context) const;
+        bool evaluateCondition(const CompiledCondition& condition, const DialogueContext& context) const;
+        bool evaluateBranchCondition(const CompiledCondition& condition, const DialogueContext& context) const;
+
+        // Writes the node text into buffer (always null terminated, truncated if it
+        // doesn't fit) and returns the full length
+        size_t renderText(uint32_t nodeIndex, const DialogueContext& context, char* buffer, size_t bufferSize) const;
+
+        const CompiledNode& getNode(uint32_t nodeIndex) const { return m_nodes[nodeIndex]; }
+        const CompiledEdge& getEdge(uint32_t edgeIndex) const { return m_edges[edgeIndex]; }
+        const char* getString(const StringRef& ref) const { return m_strings.data() + ref.offset; }
+        const std::vector<uint32_t>& getRootNodes() const { return m_rootNodes; }
+
+        uint32_t getNodeCount() const { return (uint32_t)m_nodes.size(); }
+        uint32_t getSymbolCount() const { return (uint32_t)m_symbols.size(); }
+
+    private:
+        StringRef addString(const char* text, size_t length);
+        uint32_t intern(const std::string& name);
+        CompiledCondition compileCondition(const DialogueCondition& condition);
+        CompiledCondition compileBranchCondition(const BranchCondition& condition);
+        void compileText(const std::string& text, const std::map<std::string, std::string>& treeParameters,
+            CompiledNode& node);
+        void rebuildLookups();
+        // Checks every index and string range in the tables, so a corrupt or stale blob
+        // is rejected instead of being read out of bounds later
+        bool isValid() const;
+        bool isValidString(const StringRef& ref) const;
+        bool isValidSymbol(uint32_t symbol) const;
+        bool isValidCondition(const CompiledCondition& condition) const;
+
+        int32_t getItemCount(uint32_t symbol, const DialogueContext& context) const;
+        int32_t getStat(uint32_t symbol, const DialogueContext& context) const;
+        uint32_t getQuestState(uint32_t symbol, const DialogueContext& context) const;
+
+        std::vector<CompiledNode> m_nodes;
+        std::vector<CompiledEdge> m_edges;
+        std::vector<TextToken> m_tokens;
+        std::vector<StringRef> m_symbols;
+        std::vector<uint32_t> m_rootNodes;
+        std::vector<char> m_strings; // Every string, each one null terminated
+
+        // Load-time lookups, rebuilt after compile/deserialize
+        std::vector<std::pair<int32_t, uint32_t>> m_nodeLookup; // Sorted by source id
+        std::unordered_map<std::string, uint32_t> m_symbolLookup;
+    };
+}
@@ -46,6 +46,17 @@ bool DialogueAudioEngine::init(const std::string& projectName) {
     setVoiceVolume(m_voiceVolume);
     setEffectsVolume(m_effectsVolume);
 
+    // Wwise calls are thread safe, so the voice thread talks to it directly
+    m_voicePlayer.start(
+        [](const VoiceClip& clip) {
+            // In a real implementation, you would post the voice event with the clip as
+            // an in-memory external source. For now, we'll just print a message.
+            std::cout << "Playing voice file: " << clip.path << " (" << clip.data.size() << " bytes)" << std::endl;
+        },
+        [this]() {
+            AK::SoundEngine::StopAll(m_voiceObjectId);
+        });
+
     m_initialized = true;
     return true;
 }
@@ -57,6 +68,9 @@ void DialogueAudioEngine::update() {
 }
 
 void DialogueAudioEngine::cleanup() {
+    // Before Wwise goes away, the voice thread may still be posting to it
+    m_voicePlayer.shutdown();
+
     if (m_audioEngine) {
         // Unregister game objects
         AK::SoundEngine::UnregisterGameObj(m_voiceObjectId);
@@ -71,18 +85,19 @@ void DialogueAudioEngine::cleanup() {
 
 bool DialogueAudioEngine::playVoiceFile(const std::string& filePath) {
     if (!m_initialized) return false;
+    return m_voicePlayer.play(filePath);
+}
 
-    // In a real implementation, you would use AK::SoundEngine::PostEvent with the appropriate
-    // event ID for the voice file. For now, we'll just print a message.
-    std::cout << "Playing voice file: " << filePath << std::endl;
-    return true;
+bool DialogueAudioEngine::prefetchVoiceFile(const std::string& filePath) {
+    if (!m_initialized) return false;
+    return m_voicePlayer.prefetch(filePath);
 }
 
 void DialogueAudioEngine::stopVoicePlayback() {
     if (!m_initialized) return;
 
-    // Stop all events on the voice object
-    AK::SoundEngine::StopAll(m_voiceObjectId);
+    // Stops all events on the voice object, after anything already queued
+    m_voicePlayer.stop();
 }
 
 void DialogueAudioEngine::playUISound(AkUniqueID soundId) {
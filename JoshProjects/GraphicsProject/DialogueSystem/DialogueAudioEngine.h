@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <AK/SoundEngine/Common/AkTypes.h>
+#include "DialogueVoicePlayer.h"
 
 // Forward declarations
 namespace JAGEngine {
@@ -23,9 +24,11 @@ public:
     void update();
     void cleanup();
 
-    // Voice playback
+    // Voice playback. Queued for the voice thread, these never touch the disk.
     bool playVoiceFile(const std::string& filePath);
+    bool prefetchVoiceFile(const std::string& filePath);
     void stopVoicePlayback();
+    DialogueVoicePlayer* getVoicePlayer() { return &m_voicePlayer; }
 
     // Sound effects
     void playUISound(AkUniqueID soundId);
@@ -46,6 +49,7 @@ public:
 
 private:
     std::unique_ptr<JAGEngine::WWiseAudioEngine> m_audioEngine;
+    DialogueVoicePlayer m_voicePlayer;
     bool m_initialized = false;
     float m_masterVolume = 1.0f;
     float m_voiceVolume = 1.0f;
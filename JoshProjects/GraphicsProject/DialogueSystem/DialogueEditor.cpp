@@ -10,7 +10,8 @@
 #include <thread>
 #include <algorithm> // For std::find, std::remove
 #include <iostream>
-#include "yaml-cpp/yaml.h"
+#include "CompiledDialogue.h"
+#include "DialogueProject.h"
 
 
 // Custom filesystem namespace for directory creation
@@ -30,7 +31,8 @@ DialogueEditor::DialogueEditor(DialogueManager* manager)
     m_activeResponseType(ResponseType::EnthusiasticAffirmative),
     m_selectedPersonality(PersonalityType::Bubbly),
     m_selectedVoice(VoiceType::Male1),
-    m_showBatchGenerationWindow(false) {
+    m_showBatchGenerationWindow(false),
+    m_generationQueue(std::make_unique<GenerationQueue>(manager)) {
 
     // Make sure the audio directory exists
     _mkdir("Audio"); // Create parent directory first
@@ -66,11 +68,15 @@ void DialogueEditor::initialize() {
 }
 
 void DialogueEditor::shutdown() {
-    // Save the dialogue data
-    saveDialogue();
+    // Save whatever changed since the last save
+    if (m_project.saveDirty(*m_dialogueManager) < 0) {
+        std::cerr << "Failed to save dialogue project." << std::endl;
+    }
 }
 
 void DialogueEditor::update() {
+    autosave();
+
     // This could be used for any background processing or pending API calls
     // Get the input manager from the game and process inputs
     if (m_inputManager != nullptr && m_inputManager != reinterpret_cast<JAGEngine::InputManager*>(0x40)) {
@@ -79,6 +85,9 @@ void DialogueEditor::update() {
 }
 
 void DialogueEditor::render() {
+    // Finished generation requests are only ever written into responses from here
+    m_generationQueue->applyResults();
+
     renderMenuBar();
     // Main menu bar
     if (ImGui::BeginMainMenuBar()) {
@@ -89,6 +98,12 @@ void DialogueEditor::render() {
             if (ImGui::MenuItem("Load")) {
                 loadSavedDialogue();
             }
+            if (ImGui::MenuItem("Export YAML")) {
+                exportYaml();
+            }
+            if (ImGui::MenuItem("Export Compiled Dialogue")) {
+                exportCompiledDialogue();
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Exit")) {
                 // Handle exit - you'll need to integrate this with your main loop
@@ -237,6 +252,7 @@ void DialogueEditor::renderResponseEditor() {
         std::string responseName = response->getName();
         if (ImGui::InputText("Response Name", &responseName)) {
             response->setName(responseName);
+            m_dialogueManager->markResponsesChanged();
         }
 
         ImGui::Separator();
@@ -287,13 +303,18 @@ void DialogueEditor::renderResponseEditor() {
 
         if (ImGui::InputTextMultiline("##responseText", &text, ImVec2(-1.0f, 100.0f))) {
             response->setTextForPersonality(m_selectedPersonality, text, true);
+            m_dialogueManager->markResponsesChanged();
         }
 
         // Generate button
         if (ImGui::Button("Regenerate with GPT")) {
-            std::string generatedText = m_dialogueManager->generateTextWithGPT(
-                m_activeResponseType, m_selectedPersonality, text);
-            response->setTextForPersonality(m_selectedPersonality, generatedText, false);
+            GenerationRequest request;
+            request.kind = GenerationRequest::Kind::Text;
+            request.type = m_activeResponseType;
+            request.personality = m_selectedPersonality;
+            request.inputText = text;
+            request.forceRefresh = true;
+            m_generationQueue->enqueue(request);
         }
 
         ImGui::SameLine();
@@ -301,6 +322,7 @@ void DialogueEditor::renderResponseEditor() {
         // Accept generated button (marks as edited)
         if (!isEdited && ImGui::Button("Accept Generated")) {
             response->setTextForPersonality(m_selectedPersonality, text, true);
+            m_dialogueManager->markResponsesChanged();
         }
 
         ImGui::Separator();
@@ -321,38 +343,28 @@ void DialogueEditor::renderResponseEditor() {
             ImGui::SameLine();
 
             if (ImGui::Button("Regenerate Voice")) {
-                // Generate output path
-                std::string responseType = std::to_string(static_cast<int>(m_activeResponseType));
-                std::string personalityType = std::to_string(static_cast<int>(m_selectedPersonality));
-                std::string voiceType = std::to_string(static_cast<int>(m_selectedVoice));
-
-                std::string outputPath = "Audio/Dialogue/";
-                outputPath += "response" + responseType + "_";
-                outputPath += "personality" + personalityType + "_";
-                outputPath += "voice" + voiceType + ".mp3";
-
-                if (m_dialogueManager->generateVoiceWithElevenLabs(text, m_selectedPersonality, m_selectedVoice, outputPath)) {
-                    response->setVoiceFilePath(m_selectedPersonality, m_selectedVoice, outputPath);
-                }
+                GenerationRequest request;
+                request.kind = GenerationRequest::Kind::Voice;
+                request.type = m_activeResponseType;
+                request.personality = m_selectedPersonality;
+                request.voice = m_selectedVoice;
+                request.inputText = text;
+                request.forceRefresh = true;
+                m_generationQueue->enqueue(request);
             }
         }
         else {
             ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "No Voice Generated");
 
             if (ImGui::Button("Generate Voice")) {
-                // Generate output path
-                std::string responseType = std::to_string(static_cast<int>(m_activeResponseType));
-                std::string personalityType = std::to_string(static_cast<int>(m_selectedPersonality));
-                std::string voiceType = std::to_string(static_cast<int>(m_selectedVoice));
-
-                std::string outputPath = "Audio/Dialogue/";
-                outputPath += "response" + responseType + "_";
-                outputPath += "personality" + personalityType + "_";
-                outputPath += "voice" + voiceType + ".mp3";
-
-                if (m_dialogueManager->generateVoiceWithElevenLabs(text, m_selectedPersonality, m_selectedVoice, outputPath)) {
-                    response->setVoiceFilePath(m_selectedPersonality, m_selectedVoice, outputPath);
-                }
+                // Reuses a cached clip of the same line and voice if there is one
+                GenerationRequest request;
+                request.kind = GenerationRequest::Kind::Voice;
+                request.type = m_activeResponseType;
+                request.personality = m_selectedPersonality;
+                request.voice = m_selectedVoice;
+                request.inputText = text;
+                m_generationQueue->enqueue(request);
             }
         }
     }
@@ -531,6 +543,12 @@ void DialogueEditor::renderMenuBar() {
             if (ImGui::MenuItem("Load")) {
                 loadSavedDialogue();
             }
+            if (ImGui::MenuItem("Export YAML")) {
+                exportYaml();
+            }
+            if (ImGui::MenuItem("Export Compiled Dialogue")) {
+                exportCompiledDialogue();
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Exit")) {
                 // Handle exit - you'll need to integrate this with your main loop
@@ -686,121 +704,181 @@ void DialogueEditor::renderBatchGenerationWindow() {
 
         ImGui::Separator();
 
+        // Generation settings
+        if (ImGui::CollapsingHeader("Request Settings")) {
+            bool changed = false;
+            changed |= ImGui::SliderInt("Concurrent Requests", &m_generationSettings.maxInFlight, 1, 32);
+            float rate = static_cast<float>(m_generationSettings.requestsPerSecond);
+            if (ImGui::SliderFloat("Requests / Second", &rate, 0.5f, 50.0f, "%.1f")) {
+                m_generationSettings.requestsPerSecond = rate;
+                changed = true;
+            }
+            changed |= ImGui::SliderInt("Burst Size", &m_generationSettings.burstSize, 1, 64);
+            changed |= ImGui::SliderInt("Max Retries", &m_generationSettings.maxRetries, 0, 10);
+            changed |= ImGui::InputText("Text Endpoint", &m_generationSettings.textEndpoint);
+            changed |= ImGui::InputText("Voice Endpoint", &m_generationSettings.voiceEndpoint);
+            if (changed) {
+                m_generationQueue->setSettings(m_generationSettings);
+            }
+        }
+
+        ImGui::Separator();
+
         // Generate buttons
         if (ImGui::Button("Generate Selected Text", ImVec2(200, 0))) {
-            // Start a background thread for text generation
-            std::thread([this]() {
-                for (ResponseType type : m_batchGenerationTypes) {
-                    auto response = m_dialogueManager->getResponse(type);
-                    if (!response) continue;
-
-                    for (PersonalityType personality : m_batchGenerationPersonalities) {
-                        if (!response->isTextEdited(personality)) {
-                            std::string defaultText = response->getTextForPersonality(personality);
-                            std::string generatedText = m_dialogueManager->generateTextWithGPT(type, personality, defaultText);
-                            response->setTextForPersonality(personality, generatedText, false);
+            for (ResponseType type : m_batchGenerationTypes) {
+                auto response = m_dialogueManager->getResponse(type);
+                if (!response) continue;
 
-                            // Sleep briefly to avoid overwhelming the API
-                            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                        }
+                for (PersonalityType personality : m_batchGenerationPersonalities) {
+                    if (!response->isTextEdited(personality)) {
+                        GenerationRequest request;
+                        request.kind = GenerationRequest::Kind::Text;
+                        request.type = type;
+                        request.personality = personality;
+                        request.inputText = response->getTextForPersonality(personality);
+                        m_generationQueue->enqueue(request);
                     }
                 }
-                }).detach();
+            }
         }
 
         ImGui::SameLine();
 
         if (ImGui::Button("Generate Selected Voice", ImVec2(200, 0))) {
-            // Start a background thread for voice generation
-            std::thread([this]() {
-                for (ResponseType type : m_batchGenerationTypes) {
-                    auto response = m_dialogueManager->getResponse(type);
-                    if (!response) continue;
-
-                    for (PersonalityType personality : m_batchGenerationPersonalities) {
-                        std::string text = response->getTextForPersonality(personality);
+            for (ResponseType type : m_batchGenerationTypes) {
+                auto response = m_dialogueManager->getResponse(type);
+                if (!response) continue;
 
-                        for (VoiceType voice : m_batchGenerationVoices) {
-                            // Generate output path
-                            std::string responseType = std::to_string(static_cast<int>(type));
-                            std::string personalityType = std::to_string(static_cast<int>(personality));
-                            std::string voiceType = std::to_string(static_cast<int>(voice));
+                for (PersonalityType personality : m_batchGenerationPersonalities) {
+                    std::string text = response->getTextForPersonality(personality);
 
-                            std::string outputPath = "Audio/Dialogue/";
-                            outputPath += "response" + responseType + "_";
-                            outputPath += "personality" + personalityType + "_";
-                            outputPath += "voice" + voiceType + ".mp3";
-
-                            if (m_dialogueManager->generateVoiceWithElevenLabs(text, personality, voice, outputPath)) {
-                                response->setVoiceFilePath(personality, voice, outputPath);
-                            }
-
-                            // Sleep briefly to avoid overwhelming the API
-                            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                        }
+                    for (VoiceType voice : m_batchGenerationVoices) {
+                        GenerationRequest request;
+                        request.kind = GenerationRequest::Kind::Voice;
+                        request.type = type;
+                        request.personality = personality;
+                        request.voice = voice;
+                        request.inputText = text;
+                        m_generationQueue->enqueue(request);
                     }
                 }
-                }).detach();
+            }
         }
+
+        // Progress
+        GenerationProgress progress = m_generationQueue->getProgress();
+        if (progress.total > 0) {
+            int done = progress.completed + progress.failed;
+            ImGui::ProgressBar(static_cast<float>(done) / progress.total, ImVec2(-1, 0));
+            ImGui::Text("%d / %d done, %d in flight, %d queued, %d retries, %d failed, %d from cache",
+                done, progress.total, progress.inFlight, progress.queued, progress.retries, progress.failed, progress.cached);
+            if (m_generationQueue->isBusy() && ImGui::Button("Cancel")) {
+                m_generationQueue->cancelAll();
+            }
+        }
+
+        GenerationCache& cache = m_generationQueue->getCache();
+        ImGui::TextDisabled("Cache: %d requests, %d unique files (%.1f KB)",
+            (int)cache.getEntryCount(), (int)cache.getBlobCount(), cache.getBlobBytes() / 1024.0);
     }
     ImGui::End();
 }
 
 void DialogueEditor::renderNodeTree()
 {
+    // Only rebuilt when the trees or the open nodes change
+    const auto& rows = m_treeRows.getRows(*m_dialogueManager);
 
-    // Get all root nodes (nodes without parents)
-    auto allNodes = m_dialogueManager->getAllNodes();
-    std::vector<std::shared_ptr<DialogueNode>> rootNodes;
-    for (const auto& node : allNodes)
+    // Trees in the project that haven't been read from disk yet
+    const auto& projectTrees = m_project.getTrees();
+    m_unloadedTrees.clear();
+    for (size_t i = 0; i < projectTrees.size(); i++)
     {
-        if (!m_dialogueManager->hasParent(node->getId()))
-            rootNodes.push_back(node);
+        if (!projectTrees[i].loaded)
+            m_unloadedTrees.push_back(i);
     }
 
     // If no root nodes, show a message
-    if (rootNodes.empty())
+    if (rows.empty() && m_unloadedTrees.empty())
     {
         ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f),
             "No dialogue nodes created yet. Use the buttons above to start.");
         return;
     }
 
-    // Recursive lambda to render a node and its children
-    std::function<void(std::shared_ptr<DialogueNode>, int)> renderNodeRecursive;
-    renderNodeRecursive = [this, &renderNodeRecursive](std::shared_ptr<DialogueNode> node, int depth)
-        {
-            if (!node) return;
+    // Display a special "ROOT" node at the top
+    ImGuiTreeNodeFlags rootFlags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
+    if (m_selectedNodeId == -1)  // Use -1 as the special ID for "ROOT"
+        rootFlags |= ImGuiTreeNodeFlags_Selected;
 
-            // Tree flags
-            ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
-            if (node->getId() == m_selectedNodeId)
-                flags |= ImGuiTreeNodeFlags_Selected;
+    // Display the special root node using a unique style
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 1.0f, 1.0f));  // Blue color
+    bool rootOpen = ImGui::TreeNodeEx("##root", rootFlags, "  [ROOT]");
+    ImGui::PopStyleColor();
 
-            auto children = node->getChildren();
-            if (children.empty())
-                flags |= ImGuiTreeNodeFlags_Leaf;
+    // If the root node is clicked, select it (by setting selected ID to -1)
+    if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
+        m_selectedNodeId = -1;  // Special ID for root
+    }
 
-            // Build display text
-            std::string nodeText = m_dialogueManager->processTextWithTreeParameters(node->getId(), node->getText());
-            if (nodeText.empty())
-                nodeText = "Node " + std::to_string(node->getId());
+    if (!rootOpen)
+        return;
 
-            // Append extra info for ConditionCheck or NPCStatement
-            if (node->getType() == DialogueNode::NodeType::ConditionCheck)
+    // Rows are drawn flat with their depth as an indent, so only the ones on screen
+    // need laying out. Every row is one line high, which the clipper relies on.
+    float indentSpacing = ImGui::GetStyle().IndentSpacing;
+    ImGuiListClipper clipper;
+    clipper.Begin((int)rows.size());
+    while (clipper.Step())
+    {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+        {
+            const auto& row = rows[i];
+
+            // A context menu further up may have deleted this one; the list is rebuilt next frame
+            auto node = m_dialogueManager->getNodeById(row.nodeId);
+            if (!node)
+                continue;
+
+            // Children of a condition are colour-coded by branch
+            ImVec4 branchColor = ImGui::GetStyleColorVec4(ImGuiCol_Text);
+            auto parent = m_dialogueManager->getNodeById(row.parentId);
+            bool conditionBranch = parent && parent->getType() == DialogueNode::NodeType::ConditionCheck;
+            if (conditionBranch)
             {
-                nodeText += " (" + node->getCondition().GetDescription() + ")";
+                if (row.branchCount == 2)
+                {
+                    // Binary condition: green for success, red for failure
+                    branchColor = (row.branchIndex == 0)
+                        ? ImVec4(0.0f, 0.8f, 0.0f, 1.0f)
+                        : ImVec4(0.8f, 0.0f, 0.0f, 1.0f);
+                }
+                else if (row.branchCount > 2)
+                {
+                    // Multi-branch: gradient from green to red
+                    float t = static_cast<float>(row.branchIndex) / (row.branchCount - 1);
+                    branchColor = ImVec4(t * 0.8f, (1.0f - t) * 0.8f, 0.0f, 1.0f);
+                }
             }
-            else if (node->getType() == DialogueNode::NodeType::NPCStatement)
+
+            float indent = row.depth * indentSpacing;
+            if (indent > 0.0f)
+                ImGui::Indent(indent);
+
+            if (row.type == DialogueRowList::RowType::Branch)
             {
-                auto response = node->getResponse();
-                if (response)
-                    nodeText += " ? " + m_dialogueManager->getResponseTypeName(response->getType());
+                // Show branch label
+                ImVec4 labelColor = conditionBranch ? branchColor : ImVec4(0.7f, 0.7f, 0.7f, 1.0f);
+                ImGui::TextColored(labelColor, "?? [%s] ??", row.condition.c_str());
+                if (indent > 0.0f)
+                    ImGui::Unindent(indent);
+                continue;
             }
 
             // Determine color & type label
             ImVec4 nodeColor;
-            std::string typeIndicator;
+            const char* typeIndicator;
             switch (node->getType())
             {
             case DialogueNode::NodeType::NPCStatement:
@@ -825,14 +903,50 @@ void DialogueEditor::renderNodeTree()
                 break;
             }
 
+            // Build display text, kept until the next edit
+            const std::string& label = m_treeRows.getLabel(node->getId(), [&]()
+                {
+                    std::string nodeText = m_dialogueManager->processTextWithTreeParameters(node->getId(), node->getText());
+                    if (nodeText.empty())
+                        nodeText = "Node " + std::to_string(node->getId());
+
+                    // Append extra info for ConditionCheck or NPCStatement
+                    if (node->getType() == DialogueNode::NodeType::ConditionCheck)
+                    {
+                        nodeText += " (" + node->getCondition().GetDescription() + ")";
+                    }
+                    else if (node->getType() == DialogueNode::NodeType::NPCStatement)
+                    {
+                        auto response = node->getResponse();
+                        if (response)
+                            nodeText += " ? " + m_dialogueManager->getResponseTypeName(response->getType());
+                    }
+                    return nodeText + " " + typeIndicator;
+                });
+
+            // Tree flags. The open state lives in m_treeRows, not in ImGui's storage, and
+            // nothing is pushed since the children are separate rows.
+            ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick |
+                ImGuiTreeNodeFlags_NoTreePushOnOpen;
+            if (node->getId() == m_selectedNodeId)
+                flags |= ImGuiTreeNodeFlags_Selected;
+            if (!row.hasChildren)
+                flags |= ImGuiTreeNodeFlags_Leaf;
+
+            // A node linked under two parents shows up twice, so scope its ID by the parent
+            ImGui::PushID(row.parentId);
+
             //
             // 1) Render the tree arrow with a unique ID (pointer-based)
             //
             ImGui::PushStyleColor(ImGuiCol_Text, nodeColor);
-            // Use the pointer as the ID, pass a trivial label format (non-null).
+            ImGui::SetNextItemOpen(m_treeRows.isOpen(node->getId()));
             bool nodeOpen = ImGui::TreeNodeEx((void*)(intptr_t)node->getId(), flags, "%s", " ");
             ImGui::PopStyleColor();
 
+            if (ImGui::IsItemToggledOpen())
+                m_treeRows.setOpen(node->getId(), nodeOpen);
+
             // If arrow area clicked, toggle selection (select if not selected, deselect if already selected)
             if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
                 if (m_selectedNodeId == node->getId()) {
@@ -845,67 +959,39 @@ void DialogueEditor::renderNodeTree()
                 }
             }
 
-            // Same for the text area click handler
-            if (ImGui::IsItemClicked()) {
-                if (m_selectedNodeId == node->getId()) {
-                    // Deselect the node if it's already selected
-                    m_selectedNodeId = -1;
-                }
-                else {
-                    // Otherwise select the node
-                    m_selectedNodeId = node->getId();
-                }
-            }
-
-            ImGui::SameLine();
-            // Push a separate ID for the text so it can be clicked separately
-            ImGui::PushID(node->getId());
-            {
-                // Wrap to the right edge
-                float wrapPos = ImGui::GetCursorPos().x + ImGui::GetContentRegionAvail().x;
-                ImGui::PushTextWrapPos(wrapPos);
-
-                // Show the text (nodeText + typeIndicator)
-                ImGui::TextWrapped("%s %s", nodeText.c_str(), typeIndicator.c_str());
-
-                // If the user clicks on the text, select node
-                if (ImGui::IsItemClicked())
-                    m_selectedNodeId = node->getId();
-
-                ImGui::PopTextWrapPos();
-            }
-            ImGui::PopID();
-
             //
-            // 3) Context menu on the arrow area
+            // 2) Context menu on the arrow area
             //
             if (ImGui::BeginPopupContextItem())
             {
                 if (ImGui::BeginMenu("Add Child Node"))
                 {
+                    std::shared_ptr<DialogueNode> childNode;
                     if (ImGui::MenuItem("NPC Statement"))
                     {
-                        auto childNode = m_dialogueManager->createDialogueNode(
+                        childNode = m_dialogueManager->createDialogueNode(
                             DialogueNode::NodeType::NPCStatement, "New NPC Statement");
-                        node->addChildNode(childNode);
                     }
                     if (ImGui::MenuItem("Player Choice"))
                     {
-                        auto childNode = m_dialogueManager->createDialogueNode(
+                        childNode = m_dialogueManager->createDialogueNode(
                             DialogueNode::NodeType::PlayerChoice, "New Player Choice");
-                        node->addChildNode(childNode);
                     }
                     if (ImGui::MenuItem("Condition Check"))
                     {
-                        auto childNode = m_dialogueManager->createDialogueNode(
+                        childNode = m_dialogueManager->createDialogueNode(
                             DialogueNode::NodeType::ConditionCheck, "New Condition Check");
-                        node->addChildNode(childNode);
                     }
                     if (ImGui::MenuItem("Branch Point"))
                     {
-                        auto childNode = m_dialogueManager->createDialogueNode(
+                        childNode = m_dialogueManager->createDialogueNode(
                             DialogueNode::NodeType::BranchPoint, "New Branch Point");
+                    }
+                    if (childNode)
+                    {
                         node->addChildNode(childNode);
+                        // Open the parent so the new child is visible
+                        m_treeRows.setOpen(node->getId(), true);
                     }
                     ImGui::EndMenu();
                 }
@@ -930,89 +1016,58 @@ void DialogueEditor::renderNodeTree()
                 {
                     m_dialogueManager->deleteNode(node->getId());
                     m_selectedNodeId = -1;
-                    ImGui::EndPopup();
-                    if (nodeOpen)
-                        ImGui::TreePop();
-                    return;
                 }
                 ImGui::EndPopup();
             }
 
             //
-            // 4) Recursively render children if open
+            // 3) The label, clickable separately from the arrow
             //
-            if (nodeOpen)
-            {
-                if (node->getType() == DialogueNode::NodeType::ConditionCheck)
-                {
-                    // Color-code child branches
-                    int branchIndex = 0;
-                    for (auto& childPair : children)
-                    {
-                        ImVec4 branchColor;
-                        if (children.size() == 2)
-                        {
-                            // Binary condition: green for success, red for failure
-                            branchColor = (branchIndex == 0)
-                                ? ImVec4(0.0f, 0.8f, 0.0f, 1.0f)
-                                : ImVec4(0.8f, 0.0f, 0.0f, 1.0f);
-                        }
-                        else
-                        {
-                            // Multi-branch: gradient from green to red
-                            float t = static_cast<float>(branchIndex) / (children.size() - 1);
-                            branchColor = ImVec4(t * 0.8f, (1.0f - t) * 0.8f, 0.0f, 1.0f);
-                        }
-
-                        // Show branch label if any
-                        if (!childPair.second.empty())
-                            ImGui::TextColored(branchColor, "?? [%s] ??", childPair.second.c_str());
-
-                        // Render child
-                        ImGui::PushStyleColor(ImGuiCol_Text, branchColor);
-                        renderNodeRecursive(childPair.first, depth + 1);
-                        ImGui::PopStyleColor();
-
-                        branchIndex++;
-                    }
-                }
-                else
-                {
-                    // Normal children
-                    for (auto& childPair : children)
-                    {
-                        if (!childPair.second.empty())
-                            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
-                                "?? [%s] ??", childPair.second.c_str());
-                        renderNodeRecursive(childPair.first, depth + 1);
-                    }
-                }
-                ImGui::TreePop();
-            }
-        };
+            ImGui::SameLine();
+            if (conditionBranch)
+                ImGui::PushStyleColor(ImGuiCol_Text, branchColor);
+            ImGui::TextUnformatted(label.c_str());
+            if (conditionBranch)
+                ImGui::PopStyleColor();
 
-        // Display a special "ROOT" node at the top
-        ImGuiTreeNodeFlags rootFlags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
-        if (m_selectedNodeId == -1)  // Use -1 as the special ID for "ROOT"
-            rootFlags |= ImGuiTreeNodeFlags_Selected;
+            // If the user clicks on the text, select node
+            if (ImGui::IsItemClicked())
+                m_selectedNodeId = node->getId();
 
-        // Display the special root node using a unique style
-        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 1.0f, 1.0f));  // Blue color
-        bool rootOpen = ImGui::TreeNodeEx("##root", rootFlags, "  [ROOT]");
-        ImGui::PopStyleColor();
+            // Rows don't wrap, show long lines in full on hover
+            if (ImGui::IsItemHovered() && ImGui::GetItemRectMax().x > ImGui::GetWindowPos().x + ImGui::GetWindowWidth())
+                ImGui::SetTooltip("%s", label.c_str());
 
-        // If the root node is clicked, select it (by setting selected ID to -1)
-        if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
-            m_selectedNodeId = -1;  // Special ID for root
+            ImGui::PopID();
+            if (indent > 0.0f)
+                ImGui::Unindent(indent);
         }
+    }
 
-        if (rootOpen) {
-            // Now render all the actual root nodes as children of this special root
-            for (auto& rootNode : rootNodes) {
-                renderNodeRecursive(rootNode, 0);
+    // Clicking one of these reads it (and any tree it links into), after which it shows
+    // up in the rows above like any other
+    if (!m_unloadedTrees.empty())
+    {
+        ImGui::Separator();
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Not loaded (%d trees):", (int)m_unloadedTrees.size());
+
+        ImGuiListClipper treeClipper;
+        treeClipper.Begin((int)m_unloadedTrees.size());
+        while (treeClipper.Step())
+        {
+            for (int i = treeClipper.DisplayStart; i < treeClipper.DisplayEnd; i++)
+            {
+                const auto& tree = projectTrees[m_unloadedTrees[i]];
+                std::string label = "Tree " + std::to_string(tree.rootId) + " (" + std::to_string(tree.nodeCount) + " nodes)";
+                if (ImGui::Selectable(label.c_str()))
+                {
+                    if (m_project.loadTree(*m_dialogueManager, tree.rootId))
+                        m_selectedNodeId = tree.rootId;
+                }
             }
-            ImGui::TreePop();
         }
+    }
+    ImGui::TreePop();
 }
 
 void DialogueEditor::handleKeyPress(unsigned int keyID) {
@@ -1634,7 +1689,7 @@ void DialogueEditor::renderNodeProperties() {
         ImGui::Separator();
         ImGui::TextColored(ImVec4(0.8f, 0.7f, 0.0f, 1.0f), "Branch-Specific Settings:");
 
-        auto children = node->getChildren();
+        const auto& children = node->getChildren();
         for (int i = 0; i < children.size(); i++) {
             ImGui::PushID(i);
 
@@ -2356,91 +2411,42 @@ void DialogueEditor::renderParameterTester() {
 
 
 void DialogueEditor::loadSavedDialogue() {
-    try {
-        YAML::Node rootNode = YAML::LoadFile("dialogue_data.yaml");
-        if (rootNode["nodes"]) {
-            for (const auto& nodeData : rootNode["nodes"]) {
-                int id = nodeData["id"].as<int>();
-                DialogueNode::NodeType type = static_cast<DialogueNode::NodeType>(
-                    nodeData["type"].as<int>());
-                std::string text = nodeData["text"].as<std::string>();
-                auto node = m_dialogueManager->createDialogueNode(type, text);
-
-                // Load parameters
-                if (nodeData["parameters"]) {
-                    const YAML::Node& params = nodeData["parameters"];
-                    for (YAML::const_iterator it = params.begin(); it != params.end(); ++it) {
-                        std::string key = it->first.as<std::string>();
-
-                        if (it->second.IsMap()) {
-                            // New format with type info
-                            std::string value = it->second["value"].as<std::string>();
-                            ParameterType type = static_cast<ParameterType>(it->second["type"].as<int>());
-                            node->setParameterWithType(key, value, type);
-                        }
-                        else {
-                            // Legacy format (just value)
-                            std::string value = it->second.as<std::string>();
-                            // Default to NPCName for NPC parameters, Custom for others
-                            ParameterType type = ParameterType::Custom;
-                            if (key.substr(0, 3) == "NPC") {
-                                type = ParameterType::NPCName;
-                            }
-                            else if (key.substr(0, 4) == "ITEM") {
-                                type = ParameterType::ItemName;
-                            }
-                            else if (key.substr(0, 8) == "LOCATION") {
-                                type = ParameterType::LocationName;
-                            }
-                            node->setParameterWithType(key, value, type);
-                        }
-                    }
-                }
-
-                // Load other node properties like children, response, etc.
-                // ...
-            }
+    if (m_project.exists()) {
+        // Only the manifest is read here, trees are read when picked in the tree pane
+        if (m_project.open(*m_dialogueManager)) {
+            m_selectedNodeId = -1;
+            std::cout << "Opened " << m_project.getDirectory() << " with "
+                << m_project.getTrees().size() << " dialogue trees" << std::endl;
         }
-        std::cout << "Dialogue data loaded successfully." << std::endl;
-    }
-    catch (const YAML::Exception& e) {
-        std::cerr << "Error loading dialogue data: " << e.what() << std::endl;
+        return;
     }
+
+    // No project yet, bring in the old YAML save. Everything it creates is dirty, so the
+    // first save writes the whole project.
+    DialogueProject::importYaml(*m_dialogueManager, LEGACY_YAML_PATH);
 }
 
-void DialogueEditor::saveDialogue() {
-    // Create YAML node
-    YAML::Node rootNode;
-    YAML::Node nodesNode;
-
-    for (const auto& node : m_dialogueManager->getAllNodes()) {
-        YAML::Node nodeData;
-        nodeData["id"] = node->getId();
-        nodeData["type"] = static_cast<int>(node->getType());
-        nodeData["text"] = node->getText();
-
-        // Save parameters with type information
-        YAML::Node paramsNode;
-        for (const auto& param : node->getAllParameters()) {
-            YAML::Node paramData;
-            paramData["value"] = param.second;
-            paramData["type"] = static_cast<int>(node->getParameterType(param.first));
-            paramsNode[param.first] = paramData;
-        }
-        nodeData["parameters"] = paramsNode;
-
-        // Save other node properties
-        // ...
-
-        nodesNode.push_back(nodeData);
+void DialogueEditor::exportYaml() {
+    // Exports cover the whole project, not just what's been opened
+    m_project.loadAllTrees(*m_dialogueManager);
+    if (DialogueProject::exportYaml(*m_dialogueManager, YAML_EXPORT_PATH)) {
+        std::cout << "Exported dialogue to " << YAML_EXPORT_PATH << std::endl;
     }
+}
+
+void DialogueEditor::exportCompiledDialogue() {
+    m_project.loadAllTrees(*m_dialogueManager);
 
-    rootNode["nodes"] = nodesNode;
+    DialogueRuntime::CompiledDialogue compiled;
+    compiled.compile(*m_dialogueManager);
+    if (compiled.saveToFile("dialogue_data.dlgc")) {
+        std::cout << "Exported " << compiled.getNodeCount() << " nodes and "
+            << compiled.getSymbolCount() << " symbols to dialogue_data.dlgc" << std::endl;
+    }
+}
 
-    // Write to file
-    std::ofstream file("dialogue_data.yaml");
-    if (file.is_open()) {
-        file << rootNode;
+void DialogueEditor::saveDialogue() {
+    if (m_project.saveAll(*m_dialogueManager)) {
         std::cout << "Dialogue data saved successfully." << std::endl;
     }
     else {
@@ -2448,6 +2454,22 @@ void DialogueEditor::saveDialogue() {
     }
 }
 
+void DialogueEditor::autosave() {
+    auto now = std::chrono::steady_clock::now();
+    if (now - m_lastAutosave < std::chrono::seconds(AUTOSAVE_INTERVAL_SECONDS)) {
+        return;
+    }
+    m_lastAutosave = now;
+
+    if (!m_dialogueManager->hasUnsavedChanges()) {
+        return;
+    }
+    int written = m_project.saveDirty(*m_dialogueManager);
+    if (written < 0) {
+        std::cerr << "Autosave failed." << std::endl;
+    }
+}
+
 void DialogueEditor::testDialogueNavigation() {
     // Find a root node to start with
     auto nodes = m_dialogueManager->getAllNodes();
@@ -2,6 +2,11 @@
 #pragma once
 
 #include "DialogueSystem.h"
+#include "DialogueProject.h"
+#include "DialogueTreeView.h"
+#include "GenerationQueue.h"
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <string>
 #include "JAGEngine/InputManager.h"
@@ -46,6 +51,8 @@ private:
     bool m_showBatchGenerationWindow;
     bool m_showApiConfigWindow = false;
     int m_selectedNodeId = -1;
+    // Flattened rows and cached labels for the node tree pane
+    DialogueRowList m_treeRows;
  
 
 
@@ -53,6 +60,21 @@ private:
     std::vector<PersonalityType> m_batchGenerationPersonalities;
     std::vector<VoiceType> m_batchGenerationVoices;
 
+    // Runs batch text/voice requests in the background, results are applied in render()
+    std::unique_ptr<GenerationQueue> m_generationQueue;
+    GenerationSettings m_generationSettings;
+
+    // Saved as one file per tree; autosave rewrites only the trees that changed
+    static const int AUTOSAVE_INTERVAL_SECONDS = 30;
+    DialogueProject m_project;
+    // Indices into m_project.getTrees() of trees not read yet, refilled each frame
+    std::vector<size_t> m_unloadedTrees;
+    // The old single-file save, only read when there's no project. Exports go elsewhere
+    // so they can't be mistaken for it.
+    static constexpr const char* LEGACY_YAML_PATH = "dialogue_data.yaml";
+    static constexpr const char* YAML_EXPORT_PATH = "dialogue_export.yaml";
+    std::chrono::steady_clock::time_point m_lastAutosave = std::chrono::steady_clock::now();
+
 
     // ImGui rendering helpers
     
@@ -71,6 +93,10 @@ private:
     // Helper methods
     void loadSavedDialogue();
     void saveDialogue();
+    void autosave();
+    void exportYaml();
+    // Writes the runtime form of every tree for the game to load
+    void exportCompiledDialogue();
     const char* getPersonalityName(PersonalityType type);
     const char* getResponseTypeName(ResponseType type);
     const char* getVoiceTypeName(VoiceType type);
@@ -0,0 +1,1068 @@
+//DialogueProject.cpp
+
+#include "DialogueProject.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include "yaml-cpp/yaml.h"
+
+namespace {
+    const uint32_t MANIFEST_MAGIC = 0x50474C44; // "DLGP"
+    const uint32_t TREE_MAGIC = 0x54474C44;     // "DLGT"
+    const uint32_t PROJECT_VERSION = 1;
+
+    // Everything below is written as raw bytes, native endian
+    struct StringRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    struct ManifestHeader {
+        uint32_t magic;
+        uint32_t version;
+        int32_t nextNodeId;
+        uint32_t treeCount;
+        uint32_t responseCount;
+        uint32_t variantCount;
+        uint32_t voiceCount;
+        uint32_t stringSize;
+    };
+
+    struct TreeRecord {
+        int32_t rootId;
+        uint32_t nodeCount;
+    };
+
+    struct ResponseRecord {
+        uint32_t type;
+        StringRef name;
+        StringRef defaultText;
+        uint32_t firstVariant;
+        uint32_t variantCount;
+        uint32_t firstVoice;
+        uint32_t voiceCount;
+    };
+
+    struct VariantRecord {
+        uint32_t personality;
+        uint32_t edited;
+        StringRef text;
+    };
+
+    struct VoiceRecord {
+        uint32_t personality;
+        uint32_t voice;
+        StringRef path;
+    };
+
+    struct TreeHeader {
+        uint32_t magic;
+        uint32_t version;
+        int32_t rootId;
+        uint32_t nodeCount;
+        uint32_t childCount;
+        uint32_t branchCount;
+        uint32_t parameterCount;
+        uint32_t treeParameterCount;
+        uint32_t stringSize;
+    };
+
+    struct NodeRecord {
+        int32_t id;
+        uint32_t type;
+        StringRef text;
+        int32_t responseType; // -1 for none
+        uint32_t conditionType;
+        uint32_t relationshipThreshold;
+        StringRef conditionName;
+        StringRef conditionValue;
+        uint32_t firstChild;
+        uint32_t childCount;
+        uint32_t firstBranch;
+        uint32_t branchCount;
+        uint32_t firstParameter;
+        uint32_t parameterCount;
+    };
+
+    struct ChildRecord {
+        int32_t childId;
+        int32_t childRoot; // Tree the child is saved in, read first when loading lazily
+        StringRef label;
+    };
+
+    struct BranchRecord {
+        int32_t branchIndex;
+        uint32_t type;
+        uint32_t minRelationship;
+        uint32_t maxRelationship;
+        int32_t minQuantity;
+        int32_t maxQuantity;
+        int32_t minValue;
+        int32_t maxValue;
+        StringRef itemId;
+        StringRef questId;
+        StringRef questStatus;
+        StringRef statName;
+        StringRef timeOfDay;
+        StringRef parameterName;
+        StringRef parameterValue;
+        StringRef description;
+    };
+
+    struct ParameterRecord {
+        StringRef key;
+        StringRef value;
+        uint32_t type;
+    };
+
+    static_assert(std::is_trivially_copyable<NodeRecord>::value, "NodeRecord is written as raw bytes");
+    static_assert(std::is_trivially_copyable<BranchRecord>::value, "BranchRecord is written as raw bytes");
+
+    // Shared strings (labels, parameter names, condition values) are only stored once
+    class StringPool {
+    public:
+        StringRef add(const std::string& text) {
+            auto it = m_lookup.find(text);
+            if (it != m_lookup.end()) {
+                return it->second;
+            }
+            StringRef ref;
+            ref.offset = (uint32_t)m_data.size();
+            ref.length = (uint32_t)text.size();
+            m_data.insert(m_data.end(), text.begin(), text.end());
+            m_lookup.emplace(text, ref);
+            return ref;
+        }
+
+        const std::vector<char>& getData() const { return m_data; }
+
+    private:
+        std::vector<char> m_data;
+        std::unordered_map<std::string, StringRef> m_lookup;
+    };
+
+    template<typename T>
+    void writeValue(std::vector<uint8_t>& blob, const T& value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        blob.insert(blob.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    void writeArray(std::vector<uint8_t>& blob, const std::vector<T>& values) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+        blob.insert(blob.end(), bytes, bytes + values.size() * sizeof(T));
+    }
+
+    template<typename T>
+    bool readArray(const uint8_t*& cursor, const uint8_t* end, std::vector<T>& values, uint32_t count) {
+        size_t bytes = (size_t)count * sizeof(T);
+        if ((size_t)(end - cursor) < bytes) {
+            return false;
+        }
+        values.resize(count);
+        if (bytes > 0) {
+            memcpy(values.data(), cursor, bytes);
+        }
+        cursor += bytes;
+        return true;
+    }
+
+    std::string readString(const std::vector<char>& pool, const StringRef& ref) {
+        if ((size_t)ref.offset + ref.length > pool.size()) {
+            return "";
+        }
+        return std::string(pool.data() + ref.offset, ref.length);
+    }
+
+    bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        data.resize((size_t)file.tellg());
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), data.size());
+        return file.good();
+    }
+
+    // Written beside the target and renamed over it, so a crash mid-save leaves the
+    // previous file intact
+    bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "Failed to open " << tempPath << " for writing" << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(data.data()), data.size());
+            if (!file.good()) {
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error) {
+            std::cerr << "Failed to replace " << path << ": " << error.message() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    const int PERSONALITY_COUNT = static_cast<int>(PersonalityType::Friendly) + 1;
+    const int VOICE_COUNT = static_cast<int>(VoiceType::Robot1) + 1;
+
+    void emitParameters(YAML::Emitter& out, const std::map<std::string, std::string>& values,
+        const std::function<ParameterType(const std::string&)>& getType) {
+        out << YAML::BeginMap;
+        for (const auto& param : values) {
+            out << YAML::Key << param.first << YAML::Value << YAML::BeginMap;
+            out << YAML::Key << "value" << YAML::Value << param.second;
+            out << YAML::Key << "type" << YAML::Value << static_cast<int>(getType(param.first));
+            out << YAML::EndMap;
+        }
+        out << YAML::EndMap;
+    }
+
+    // Reads a parameter map written by emitParameters, or the older value-only form
+    void readParameters(const YAML::Node& params,
+        const std::function<void(const std::string&, const std::string&, ParameterType)>& set) {
+        for (YAML::const_iterator it = params.begin(); it != params.end(); ++it) {
+            std::string key = it->first.as<std::string>();
+
+            if (it->second.IsMap()) {
+                std::string value = it->second["value"].as<std::string>();
+                ParameterType type = static_cast<ParameterType>(it->second["type"].as<int>());
+                set(key, value, type);
+            }
+            else {
+                // Legacy format (just value), guess the type from the name
+                std::string value = it->second.as<std::string>();
+                ParameterType type = ParameterType::Custom;
+                if (key.substr(0, 3) == "NPC") {
+                    type = ParameterType::NPCName;
+                }
+                else if (key.substr(0, 4) == "ITEM") {
+                    type = ParameterType::ItemName;
+                }
+                else if (key.substr(0, 8) == "LOCATION") {
+                    type = ParameterType::LocationName;
+                }
+                set(key, value, type);
+            }
+        }
+    }
+}
+
+DialogueProject::DialogueProject(const std::string& directory) :
+    m_directory(directory) {
+}
+
+bool DialogueProject::exists() const {
+    std::error_code error;
+    return std::filesystem::exists(getManifestPath(), error);
+}
+
+std::string DialogueProject::getTreePath(int rootId) const {
+    return m_directory + "/tree_" + std::to_string(rootId) + ".dlgt";
+}
+
+std::string DialogueProject::getManifestPath() const {
+    return m_directory + "/project.dlgp";
+}
+
+DialogueProject::TreeInfo* DialogueProject::findTree(int rootId) {
+    for (TreeInfo& tree : m_trees) {
+        if (tree.rootId == rootId) {
+            return &tree;
+        }
+    }
+    return nullptr;
+}
+
+bool DialogueProject::open(DialogueManager& manager) {
+    std::vector<uint8_t> data;
+    if (!readFile(getManifestPath(), data)) {
+        std::cerr << "Failed to open " << getManifestPath() << std::endl;
+        return false;
+    }
+
+    ManifestHeader header;
+    if (data.size() < sizeof(header)) {
+        std::cerr << "Dialogue project manifest is truncated" << std::endl;
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != MANIFEST_MAGIC || header.version != PROJECT_VERSION) {
+        std::cerr << "Dialogue project manifest has the wrong magic or version" << std::endl;
+        return false;
+    }
+
+    std::vector<TreeRecord> trees;
+    std::vector<ResponseRecord> responses;
+    std::vector<VariantRecord> variants;
+    std::vector<VoiceRecord> voices;
+    std::vector<char> strings;
+    const uint8_t* cursor = data.data() + sizeof(header);
+    const uint8_t* end = data.data() + data.size();
+    bool ok = readArray(cursor, end, trees, header.treeCount) &&
+        readArray(cursor, end, responses, header.responseCount) &&
+        readArray(cursor, end, variants, header.variantCount) &&
+        readArray(cursor, end, voices, header.voiceCount) &&
+        readArray(cursor, end, strings, header.stringSize);
+    if (!ok) {
+        std::cerr << "Dialogue project manifest is truncated" << std::endl;
+        return false;
+    }
+
+    manager.clearAllNodes();
+    manager.reserveNodeIds(header.nextNodeId);
+
+    for (const ResponseRecord& record : responses) {
+        ResponseType type = static_cast<ResponseType>(record.type);
+        auto response = manager.createResponse(type, readString(strings, record.defaultText));
+        response->setName(readString(strings, record.name));
+
+        for (uint32_t i = 0; i < record.variantCount && record.firstVariant + i < variants.size(); i++) {
+            const VariantRecord& variant = variants[record.firstVariant + i];
+            response->setTextForPersonality(static_cast<PersonalityType>(variant.personality),
+                readString(strings, variant.text), variant.edited != 0);
+        }
+        for (uint32_t i = 0; i < record.voiceCount && record.firstVoice + i < voices.size(); i++) {
+            const VoiceRecord& voice = voices[record.firstVoice + i];
+            response->setVoiceFilePath(static_cast<PersonalityType>(voice.personality),
+                static_cast<VoiceType>(voice.voice), readString(strings, voice.path));
+        }
+    }
+
+    m_trees.clear();
+    for (const TreeRecord& record : trees) {
+        TreeInfo info;
+        info.rootId = record.rootId;
+        info.nodeCount = record.nodeCount;
+        m_trees.push_back(info);
+    }
+
+    // Nothing has been edited yet
+    manager.clearDirtyTrees();
+    return true;
+}
+
+bool DialogueProject::loadTree(DialogueManager& manager, int rootId) {
+    TreeInfo* info = findTree(rootId);
+    if (!info) {
+        return false;
+    }
+    if (info->loaded || m_loading.count(rootId) > 0) {
+        return true;
+    }
+
+    // Reading a tree isn't an edit, put the dirty set back when done
+    std::unordered_set<int> dirtyTrees = manager.getDirtyTrees();
+    m_loading.insert(rootId);
+
+    std::vector<std::pair<int, int>> pendingLinks;
+    bool ok = readTree(manager, rootId, pendingLinks);
+
+    m_loading.erase(rootId);
+    manager.setDirtyTrees(dirtyTrees);
+    return ok;
+}
+
+int DialogueProject::loadAllTrees(DialogueManager& manager) {
+    int loaded = 0;
+    for (size_t i = 0; i < m_trees.size(); i++) {
+        if (!m_trees[i].loaded && loadTree(manager, m_trees[i].rootId)) {
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+bool DialogueProject::readTree(DialogueManager& manager, int rootId, std::vector<std::pair<int, int>>& pendingLinks) {
+    std::vector<uint8_t> data;
+    if (!readFile(getTreePath(rootId), data)) {
+        std::cerr << "Failed to open " << getTreePath(rootId) << std::endl;
+        return false;
+    }
+
+    TreeHeader header;
+    if (data.size() < sizeof(header)) {
+        std::cerr << "Dialogue tree " << rootId << " is truncated" << std::endl;
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != TREE_MAGIC || header.version != PROJECT_VERSION || header.rootId != rootId) {
+        std::cerr << "Dialogue tree " << rootId << " has the wrong magic, version or root" << std::endl;
+        return false;
+    }
+
+    std::vector<NodeRecord> nodes;
+    std::vector<ChildRecord> children;
+    std::vector<BranchRecord> branches;
+    std::vector<ParameterRecord> parameters;
+    std::vector<ParameterRecord> treeParameters;
+    std::vector<char> strings;
+    const uint8_t* cursor = data.data() + sizeof(header);
+    const uint8_t* end = data.data() + data.size();
+    bool ok = readArray(cursor, end, nodes, header.nodeCount) &&
+        readArray(cursor, end, children, header.childCount) &&
+        readArray(cursor, end, branches, header.branchCount) &&
+        readArray(cursor, end, parameters, header.parameterCount) &&
+        readArray(cursor, end, treeParameters, header.treeParameterCount) &&
+        readArray(cursor, end, strings, header.stringSize);
+    if (!ok) {
+        std::cerr << "Dialogue tree " << rootId << " is truncated" << std::endl;
+        return false;
+    }
+
+    // Create every node first so links inside the tree resolve regardless of order
+    std::vector<std::shared_ptr<DialogueNode>> created(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const NodeRecord& record = nodes[i];
+        auto node = manager.restoreDialogueNode(record.id, static_cast<DialogueNode::NodeType>(record.type),
+            readString(strings, record.text));
+        if (!node) {
+            std::cerr << "Node " << record.id << " from tree " << rootId << " is already loaded, skipping it" << std::endl;
+            continue;
+        }
+        created[i] = node;
+
+        if (record.responseType >= 0) {
+            node->setResponse(manager.getResponse(static_cast<ResponseType>(record.responseType)));
+        }
+
+        DialogueCondition condition;
+        condition.type = static_cast<ConditionType>(record.conditionType);
+        condition.parameterName = readString(strings, record.conditionName);
+        condition.parameterValue = readString(strings, record.conditionValue);
+        condition.relationshipThreshold = static_cast<RelationshipStatus>(record.relationshipThreshold);
+        node->setCondition(condition);
+
+        for (uint32_t b = record.firstBranch; b < record.firstBranch + record.branchCount && b < branches.size(); b++) {
+            const BranchRecord& branch = branches[b];
+            BranchCondition branchCondition;
+            branchCondition.type = static_cast<ConditionType>(branch.type);
+            branchCondition.minRelationship = static_cast<RelationshipStatus>(branch.minRelationship);
+            branchCondition.maxRelationship = static_cast<RelationshipStatus>(branch.maxRelationship);
+            branchCondition.itemId = readString(strings, branch.itemId);
+            branchCondition.minQuantity = branch.minQuantity;
+            branchCondition.maxQuantity = branch.maxQuantity;
+            branchCondition.questId = readString(strings, branch.questId);
+            branchCondition.questStatus = readString(strings, branch.questStatus);
+            branchCondition.statName = readString(strings, branch.statName);
+            branchCondition.minValue = branch.minValue;
+            branchCondition.maxValue = branch.maxValue;
+            branchCondition.timeOfDay = readString(strings, branch.timeOfDay);
+            branchCondition.parameterName = readString(strings, branch.parameterName);
+            branchCondition.parameterValue = readString(strings, branch.parameterValue);
+            branchCondition.description = readString(strings, branch.description);
+            node->setBranchCondition(branch.branchIndex, branchCondition);
+        }
+
+        for (uint32_t p = record.firstParameter; p < record.firstParameter + record.parameterCount && p < parameters.size(); p++) {
+            const ParameterRecord& param = parameters[p];
+            node->setParameterWithType(readString(strings, param.key), readString(strings, param.value),
+                static_cast<ParameterType>(param.type));
+        }
+    }
+
+    for (const ParameterRecord& param : treeParameters) {
+        manager.setTreeParameterWithType(rootId, readString(strings, param.key), readString(strings, param.value),
+            static_cast<ParameterType>(param.type));
+    }
+
+    findTree(rootId)->loaded = true;
+
+    // A child saved in another tree means that tree has to be read before we can link it
+    for (const ChildRecord& child : children) {
+        if (child.childRoot != rootId && !manager.getNodeById(child.childId)) {
+            loadTree(manager, child.childRoot);
+        }
+    }
+
+    bool searchedAll = false;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (!created[i]) continue;
+        const NodeRecord& record = nodes[i];
+        for (uint32_t c = record.firstChild; c < record.firstChild + record.childCount && c < children.size(); c++) {
+            const ChildRecord& child = children[c];
+            auto childNode = manager.getNodeById(child.childId);
+            if (!childNode && !searchedAll) {
+                // The child moved trees since this one was saved, read everything
+                searchedAll = true;
+                for (size_t t = 0; t < m_trees.size(); t++) {
+                    loadTree(manager, m_trees[t].rootId);
+                }
+                childNode = manager.getNodeById(child.childId);
+            }
+            if (!childNode) {
+                pendingLinks.push_back(std::make_pair(record.id, child.childId));
+                continue;
+            }
+            created[i]->addChildNode(childNode, readString(strings, child.label));
+        }
+    }
+
+    for (const auto& link : pendingLinks) {
+        std::cerr << "Dialogue tree " << rootId << ": node " << link.first << " links to missing node "
+            << link.second << std::endl;
+    }
+    return true;
+}
+
+void DialogueProject::collectTrees(const DialogueManager& manager, std::unordered_map<int, std::vector<int>>& nodesByRoot) const {
+    for (const auto& node : manager.getAllNodes()) {
+        int id = node->getId();
+        // updateNodeType leaves the old id pointing at the replacement, only take a node
+        // under its own id
+        if (manager.getNodeById(id) != node) continue;
+        int rootId = manager.findRootNodeId(id);
+        if (rootId >= 0) {
+            nodesByRoot[rootId].push_back(id);
+        }
+    }
+    for (auto& pair : nodesByRoot) {
+        std::sort(pair.second.begin(), pair.second.end());
+    }
+}
+
+void DialogueProject::collectTree(const DialogueManager& manager, int rootId, std::vector<int>& nodeIds) const {
+    // Every node of the tree hangs off the root through its first parent, so walking
+    // child links and keeping nodes that resolve to this root finds all of them
+    std::unordered_set<int> visited;
+    std::vector<int> stack(1, rootId);
+    while (!stack.empty()) {
+        int id = stack.back();
+        stack.pop_back();
+        if (!visited.insert(id).second) continue;
+
+        auto node = manager.getNodeById(id);
+        if (!node || node->getId() != id || manager.findRootNodeId(id) != rootId) continue;
+        nodeIds.push_back(id);
+        for (const auto& childPair : node->getChildren()) {
+            stack.push_back(childPair.first->getId());
+        }
+    }
+    std::sort(nodeIds.begin(), nodeIds.end());
+}
+
+bool DialogueProject::writeTree(const DialogueManager& manager, int rootId, const std::vector<int>& nodeIds) {
+    StringPool strings;
+    std::vector<NodeRecord> nodes;
+    std::vector<ChildRecord> children;
+    std::vector<BranchRecord> branches;
+    std::vector<ParameterRecord> parameters;
+    std::vector<ParameterRecord> treeParameters;
+    nodes.reserve(nodeIds.size());
+
+    for (int id : nodeIds) {
+        auto node = manager.getNodeById(id);
+        if (!node) continue;
+
+        NodeRecord record = {};
+        record.id = id;
+        record.type = static_cast<uint32_t>(node->getType());
+        record.text = strings.add(node->getText());
+        auto response = node->getResponse();
+        record.responseType = response ? static_cast<int32_t>(response->getType()) : -1;
+
+        DialogueCondition condition = node->getCondition();
+        record.conditionType = static_cast<uint32_t>(condition.type);
+        record.relationshipThreshold = static_cast<uint32_t>(condition.relationshipThreshold);
+        record.conditionName = strings.add(condition.parameterName);
+        record.conditionValue = strings.add(condition.parameterValue);
+
+        record.firstChild = (uint32_t)children.size();
+        for (const auto& childPair : node->getChildren()) {
+            ChildRecord child;
+            child.childId = childPair.first->getId();
+            child.childRoot = manager.findRootNodeId(child.childId);
+            child.label = strings.add(childPair.second);
+            children.push_back(child);
+        }
+        record.childCount = (uint32_t)children.size() - record.firstChild;
+
+        record.firstBranch = (uint32_t)branches.size();
+        for (const auto& pair : node->getBranchConditions()) {
+            const BranchCondition& condition = pair.second;
+            BranchRecord branch;
+            branch.branchIndex = pair.first;
+            branch.type = static_cast<uint32_t>(condition.type);
+            branch.minRelationship = static_cast<uint32_t>(condition.minRelationship);
+            branch.maxRelationship = static_cast<uint32_t>(condition.maxRelationship);
+            branch.minQuantity = condition.minQuantity;
+            branch.maxQuantity = condition.maxQuantity;
+            branch.minValue = condition.minValue;
+            branch.maxValue = condition.maxValue;
+            branch.itemId = strings.add(condition.itemId);
+            branch.questId = strings.add(condition.questId);
+            branch.questStatus = strings.add(condition.questStatus);
+            branch.statName = strings.add(condition.statName);
+            branch.timeOfDay = strings.add(condition.timeOfDay);
+            branch.parameterName = strings.add(condition.parameterName);
+            branch.parameterValue = strings.add(condition.parameterValue);
+            branch.description = strings.add(condition.description);
+            branches.push_back(branch);
+        }
+        record.branchCount = (uint32_t)branches.size() - record.firstBranch;
+
+        record.firstParameter = (uint32_t)parameters.size();
+        for (const auto& param : node->getAllParameters()) {
+            ParameterRecord parameter;
+            parameter.key = strings.add(param.first);
+            parameter.value = strings.add(param.second);
+            parameter.type = static_cast<uint32_t>(node->getParameterType(param.first));
+            parameters.push_back(parameter);
+        }
+        record.parameterCount = (uint32_t)parameters.size() - record.firstParameter;
+
+        nodes.push_back(record);
+    }
+
+    for (const auto& param : manager.getTreeParameters(rootId)) {
+        ParameterRecord parameter;
+        parameter.key = strings.add(param.first);
+        parameter.value = strings.add(param.second);
+        parameter.type = static_cast<uint32_t>(manager.getTreeParameterType(rootId, param.first));
+        treeParameters.push_back(parameter);
+    }
+
+    TreeHeader header;
+    header.magic = TREE_MAGIC;
+    header.version = PROJECT_VERSION;
+    header.rootId = rootId;
+    header.nodeCount = (uint32_t)nodes.size();
+    header.childCount = (uint32_t)children.size();
+    header.branchCount = (uint32_t)branches.size();
+    header.parameterCount = (uint32_t)parameters.size();
+    header.treeParameterCount = (uint32_t)treeParameters.size();
+    header.stringSize = (uint32_t)strings.getData().size();
+
+    std::vector<uint8_t> blob;
+    blob.reserve(sizeof(header) + nodes.size() * sizeof(NodeRecord) + children.size() * sizeof(ChildRecord) +
+        branches.size() * sizeof(BranchRecord) + (parameters.size() + treeParameters.size()) * sizeof(ParameterRecord) +
+        strings.getData().size());
+    writeValue(blob, header);
+    writeArray(blob, nodes);
+    writeArray(blob, children);
+    writeArray(blob, branches);
+    writeArray(blob, parameters);
+    writeArray(blob, treeParameters);
+    writeArray(blob, strings.getData());
+    if (!writeFile(getTreePath(rootId), blob)) {
+        return false;
+    }
+
+    TreeInfo* info = findTree(rootId);
+    if (!info) {
+        m_trees.push_back(TreeInfo());
+        info = &m_trees.back();
+        info->rootId = rootId;
+    }
+    info->nodeCount = (uint32_t)nodes.size();
+    info->loaded = true;
+    return true;
+}
+
+bool DialogueProject::writeManifest(const DialogueManager& manager) {
+    StringPool strings;
+    std::vector<TreeRecord> trees;
+    std::vector<ResponseRecord> responses;
+    std::vector<VariantRecord> variants;
+    std::vector<VoiceRecord> voices;
+
+    for (const TreeInfo& info : m_trees) {
+        TreeRecord record;
+        record.rootId = info.rootId;
+        record.nodeCount = info.nodeCount;
+        trees.push_back(record);
+    }
+
+    auto allResponses = manager.getAllResponses();
+    std::sort(allResponses.begin(), allResponses.end(),
+        [](const std::shared_ptr<DialogueResponse>& a, const std::shared_ptr<DialogueResponse>& b) {
+            return a->getType() < b->getType();
+        });
+    for (const auto& response : allResponses) {
+        ResponseRecord record;
+        record.type = static_cast<uint32_t>(response->getType());
+        record.name = strings.add(response->getName());
+        record.defaultText = strings.add(response->getDefaultText());
+
+        record.firstVariant = (uint32_t)variants.size();
+        record.firstVoice = (uint32_t)voices.size();
+        for (int p = 0; p < PERSONALITY_COUNT; p++) {
+            PersonalityType personality = static_cast<PersonalityType>(p);
+            VariantRecord variant;
+            variant.personality = (uint32_t)p;
+            variant.edited = response->isTextEdited(personality) ? 1 : 0;
+            variant.text = strings.add(response->getTextForPersonality(personality));
+            variants.push_back(variant);
+
+            for (int v = 0; v < VOICE_COUNT; v++) {
+                VoiceType voice = static_cast<VoiceType>(v);
+                if (!response->hasVoiceGenerated(personality, voice)) continue;
+                VoiceRecord voiceRecord;
+                voiceRecord.personality = (uint32_t)p;
+                voiceRecord.voice = (uint32_t)v;
+                voiceRecord.path = strings.add(response->getVoiceFilePath(personality, voice));
+                voices.push_back(voiceRecord);
+            }
+        }
+        record.variantCount = (uint32_t)variants.size() - record.firstVariant;
+        record.voiceCount = (uint32_t)voices.size() - record.firstVoice;
+        responses.push_back(record);
+    }
+
+    ManifestHeader header;
+    header.magic = MANIFEST_MAGIC;
+    header.version = PROJECT_VERSION;
+    header.nextNodeId = manager.getNextNodeId();
+    header.treeCount = (uint32_t)trees.size();
+    header.responseCount = (uint32_t)responses.size();
+    header.variantCount = (uint32_t)variants.size();
+    header.voiceCount = (uint32_t)voices.size();
+    header.stringSize = (uint32_t)strings.getData().size();
+
+    std::vector<uint8_t> blob;
+    writeValue(blob, header);
+    writeArray(blob, trees);
+    writeArray(blob, responses);
+    writeArray(blob, variants);
+    writeArray(blob, voices);
+    writeArray(blob, strings.getData());
+    return writeFile(getManifestPath(), blob);
+}
+
+bool DialogueProject::saveAll(DialogueManager& manager) {
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    // Anything not read yet is still on disk as it was; bring it in so the
+    // rewrite below can't lose it
+    loadAllTrees(manager);
+
+    std::unordered_map<int, std::vector<int>> nodesByRoot;
+    collectTrees(manager, nodesByRoot);
+
+    bool ok = true;
+    std::vector<TreeInfo> previousTrees = m_trees;
+    m_trees.clear();
+    for (int rootId : manager.getRootNodeIds()) {
+        ok = writeTree(manager, rootId, nodesByRoot[rootId]) && ok;
+    }
+    for (const TreeInfo& tree : previousTrees) {
+        if (!findTree(tree.rootId)) {
+            std::filesystem::remove(getTreePath(tree.rootId), error);
+        }
+    }
+
+    ok = writeManifest(manager) && ok;
+    if (ok) {
+        manager.clearDirtyTrees();
+        std::cout << "Saved " << m_trees.size() << " dialogue trees to " << m_directory << std::endl;
+    }
+    return ok;
+}
+
+int DialogueProject::saveDirty(DialogueManager& manager) {
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    std::unordered_set<int> dirtyTrees = manager.getDirtyTrees();
+    int written = 0;
+    bool ok = true;
+    for (int rootId : dirtyTrees) {
+        auto node = manager.getNodeById(rootId);
+        bool isRoot = node && node->getId() == rootId && !manager.hasParent(rootId);
+        if (isRoot) {
+            std::vector<int> nodeIds;
+            collectTree(manager, rootId, nodeIds);
+            if (writeTree(manager, rootId, nodeIds)) {
+                written++;
+            }
+            else {
+                ok = false;
+            }
+            continue;
+        }
+
+        // Deleted, or merged into another tree that is dirty too
+        TreeInfo* info = findTree(rootId);
+        if (info && info->loaded) {
+            std::filesystem::remove(getTreePath(rootId), error);
+            m_trees.erase(m_trees.begin() + (info - m_trees.data()));
+            written++;
+        }
+    }
+
+    std::sort(m_trees.begin(), m_trees.end(), [](const TreeInfo& a, const TreeInfo& b) {
+        return a.rootId < b.rootId;
+    });
+    ok = writeManifest(manager) && ok;
+    if (!ok) {
+        return -1;
+    }
+    manager.clearDirtyTrees();
+    return written;
+}
+
+bool DialogueProject::exportYaml(const DialogueManager& manager, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    // The emitter writes straight into the file as we go
+    YAML::Emitter out(file);
+    out << YAML::BeginMap;
+
+    auto responses = manager.getAllResponses();
+    std::sort(responses.begin(), responses.end(),
+        [](const std::shared_ptr<DialogueResponse>& a, const std::shared_ptr<DialogueResponse>& b) {
+            return a->getType() < b->getType();
+        });
+    out << YAML::Key << "responses" << YAML::Value << YAML::BeginSeq;
+    for (const auto& response : responses) {
+        out << YAML::BeginMap;
+        out << YAML::Key << "type" << YAML::Value << static_cast<int>(response->getType());
+        out << YAML::Key << "name" << YAML::Value << response->getName();
+        out << YAML::Key << "defaultText" << YAML::Value << response->getDefaultText();
+        out << YAML::Key << "variants" << YAML::Value << YAML::BeginSeq;
+        for (int p = 0; p < PERSONALITY_COUNT; p++) {
+            PersonalityType personality = static_cast<PersonalityType>(p);
+            out << YAML::Flow << YAML::BeginMap;
+            out << YAML::Key << "personality" << YAML::Value << p;
+            out << YAML::Key << "text" << YAML::Value << response->getTextForPersonality(personality);
+            out << YAML::Key << "edited" << YAML::Value << response->isTextEdited(personality);
+            out << YAML::EndMap;
+        }
+        out << YAML::EndSeq;
+        out << YAML::Key << "voices" << YAML::Value << YAML::BeginSeq;
+        for (int p = 0; p < PERSONALITY_COUNT; p++) {
+            for (int v = 0; v < VOICE_COUNT; v++) {
+                PersonalityType personality = static_cast<PersonalityType>(p);
+                VoiceType voice = static_cast<VoiceType>(v);
+                if (!response->hasVoiceGenerated(personality, voice)) continue;
+                out << YAML::Flow << YAML::BeginMap;
+                out << YAML::Key << "personality" << YAML::Value << p;
+                out << YAML::Key << "voice" << YAML::Value << v;
+                out << YAML::Key << "path" << YAML::Value << response->getVoiceFilePath(personality, voice);
+                out << YAML::EndMap;
+            }
+        }
+        out << YAML::EndSeq;
+        out << YAML::EndMap;
+    }
+    out << YAML::EndSeq;
+
+    std::vector<std::shared_ptr<DialogueNode>> nodes;
+    for (const auto& node : manager.getAllNodes()) {
+        if (manager.getNodeById(node->getId()) == node) {
+            nodes.push_back(node);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end(),
+        [](const std::shared_ptr<DialogueNode>& a, const std::shared_ptr<DialogueNode>& b) {
+            return a->getId() < b->getId();
+        });
+
+    out << YAML::Key << "nodes" << YAML::Value << YAML::BeginSeq;
+    for (const auto& node : nodes) {
+        out << YAML::BeginMap;
+        out << YAML::Key << "id" << YAML::Value << node->getId();
+        out << YAML::Key << "type" << YAML::Value << static_cast<int>(node->getType());
+        out << YAML::Key << "text" << YAML::Value << node->getText();
+        out << YAML::Key << "parameters" << YAML::Value;
+        emitParameters(out, node->getAllParameters(), [&node](const std::string& key) {
+            return node->getParameterType(key);
+        });
+
+        if (auto response = node->getResponse()) {
+            out << YAML::Key << "response" << YAML::Value << static_cast<int>(response->getType());
+        }
+
+        DialogueCondition condition = node->getCondition();
+        if (condition.type != ConditionType::None) {
+            out << YAML::Key << "condition" << YAML::Value << YAML::Flow << YAML::BeginMap;
+            out << YAML::Key << "type" << YAML::Value << static_cast<int>(condition.type);
+            out << YAML::Key << "name" << YAML::Value << condition.parameterName;
+            out << YAML::Key << "value" << YAML::Value << condition.parameterValue;
+            out << YAML::Key << "relationship" << YAML::Value << static_cast<int>(condition.relationshipThreshold);
+            out << YAML::EndMap;
+        }
+
+        if (!node->getBranchConditions().empty()) {
+            out << YAML::Key << "branches" << YAML::Value << YAML::BeginSeq;
+            for (const auto& pair : node->getBranchConditions()) {
+                const BranchCondition& branch = pair.second;
+                out << YAML::Flow << YAML::BeginMap;
+                out << YAML::Key << "index" << YAML::Value << pair.first;
+                out << YAML::Key << "type" << YAML::Value << static_cast<int>(branch.type);
+                out << YAML::Key << "minRelationship" << YAML::Value << static_cast<int>(branch.minRelationship);
+                out << YAML::Key << "maxRelationship" << YAML::Value << static_cast<int>(branch.maxRelationship);
+                out << YAML::Key << "itemId" << YAML::Value << branch.itemId;
+                out << YAML::Key << "minQuantity" << YAML::Value << branch.minQuantity;
+                out << YAML::Key << "maxQuantity" << YAML::Value << branch.maxQuantity;
+                out << YAML::Key << "questId" << YAML::Value << branch.questId;
+                out << YAML::Key << "questStatus" << YAML::Value << branch.questStatus;
+                out << YAML::Key << "statName" << YAML::Value << branch.statName;
+                out << YAML::Key << "minValue" << YAML::Value << branch.minValue;
+                out << YAML::Key << "maxValue" << YAML::Value << branch.maxValue;
+                out << YAML::Key << "timeOfDay" << YAML::Value << branch.timeOfDay;
+                out << YAML::Key << "parameterName" << YAML::Value << branch.parameterName;
+                out << YAML::Key << "parameterValue" << YAML::Value << branch.parameterValue;
+                out << YAML::Key << "description" << YAML::Value << branch.description;
+                out << YAML::EndMap;
+            }
+            out << YAML::EndSeq;
+        }
+
+        if (!node->getChildren().empty()) {
+            out << YAML::Key << "children" << YAML::Value << YAML::BeginSeq;
+            for (const auto& childPair : node->getChildren()) {
+                out << YAML::Flow << YAML::BeginMap;
+                out << YAML::Key << "id" << YAML::Value << childPair.first->getId();
+                out << YAML::Key << "label" << YAML::Value << childPair.second;
+                out << YAML::EndMap;
+            }
+            out << YAML::EndSeq;
+        }
+        out << YAML::EndMap;
+    }
+    out << YAML::EndSeq;
+
+    out << YAML::Key << "treeParameters" << YAML::Value << YAML::BeginSeq;
+    for (int rootId : manager.getRootNodeIds()) {
+        const auto& params = manager.getTreeParameters(rootId);
+        if (params.empty()) continue;
+        out << YAML::BeginMap;
+        out << YAML::Key << "root" << YAML::Value << rootId;
+        out << YAML::Key << "parameters" << YAML::Value;
+        emitParameters(out, params, [&manager, rootId](const std::string& key) {
+            return manager.getTreeParameterType(rootId, key);
+        });
+        out << YAML::EndMap;
+    }
+    out << YAML::EndSeq;
+
+    out << YAML::EndMap;
+    file << std::endl;
+
+    if (!out.good()) {
+        std::cerr << "Failed to export dialogue: " << out.GetLastError() << std::endl;
+        return false;
+    }
+    return file.good();
+}
+
+bool DialogueProject::importYaml(DialogueManager& manager, const std::string& path) {
+    try {
+        YAML::Node rootNode = YAML::LoadFile(path);
+
+        if (rootNode["responses"]) {
+            for (const auto& responseData : rootNode["responses"]) {
+                ResponseType type = static_cast<ResponseType>(responseData["type"].as<int>());
+                auto response = manager.createResponse(type, responseData["defaultText"].as<std::string>(""));
+                if (responseData["name"]) {
+                    response->setName(responseData["name"].as<std::string>());
+                }
+                for (const auto& variant : responseData["variants"]) {
+                    response->setTextForPersonality(static_cast<PersonalityType>(variant["personality"].as<int>()),
+                        variant["text"].as<std::string>(), variant["edited"].as<bool>(false));
+                }
+                for (const auto& voice : responseData["voices"]) {
+                    response->setVoiceFilePath(static_cast<PersonalityType>(voice["personality"].as<int>()),
+                        static_cast<VoiceType>(voice["voice"].as<int>()), voice["path"].as<std::string>());
+                }
+            }
+        }
+
+        // Saved id -> node, links are made once every node exists. They're made in file
+        // order, so a node linked from two trees ends up in whichever tree comes first.
+        std::unordered_map<int, std::shared_ptr<DialogueNode>> nodesById;
+        if (rootNode["nodes"]) {
+            for (const auto& nodeData : rootNode["nodes"]) {
+                int id = nodeData["id"].as<int>();
+                DialogueNode::NodeType type = static_cast<DialogueNode::NodeType>(nodeData["type"].as<int>());
+                std::string text = nodeData["text"].as<std::string>();
+                auto node = manager.restoreDialogueNode(id, type, text);
+                if (!node) {
+                    node = manager.createDialogueNode(type, text);
+                }
+                nodesById[id] = node;
+
+                if (nodeData["parameters"]) {
+                    readParameters(nodeData["parameters"], [&node](const std::string& key, const std::string& value, ParameterType paramType) {
+                        node->setParameterWithType(key, value, paramType);
+                    });
+                }
+
+                if (nodeData["response"]) {
+                    node->setResponse(manager.getResponse(static_cast<ResponseType>(nodeData["response"].as<int>())));
+                }
+
+                if (const YAML::Node& conditionData = nodeData["condition"]) {
+                    DialogueCondition condition;
+                    condition.type = static_cast<ConditionType>(conditionData["type"].as<int>());
+                    condition.parameterName = conditionData["name"].as<std::string>("");
+                    condition.parameterValue = conditionData["value"].as<std::string>("");
+                    condition.relationshipThreshold = static_cast<RelationshipStatus>(conditionData["relationship"].as<int>(0));
+                    node->setCondition(condition);
+                }
+
+                for (const auto& branchData : nodeData["branches"]) {
+                    BranchCondition branch;
+                    branch.type = static_cast<ConditionType>(branchData["type"].as<int>());
+                    branch.minRelationship = static_cast<RelationshipStatus>(branchData["minRelationship"].as<int>());
+                    branch.maxRelationship = static_cast<RelationshipStatus>(branchData["maxRelationship"].as<int>());
+                    branch.itemId = branchData["itemId"].as<std::string>("");
+                    branch.minQuantity = branchData["minQuantity"].as<int>(0);
+                    branch.maxQuantity = branchData["maxQuantity"].as<int>(9999);
+                    branch.questId = branchData["questId"].as<std::string>("");
+                    branch.questStatus = branchData["questStatus"].as<std::string>("");
+                    branch.statName = branchData["statName"].as<std::string>("");
+                    branch.minValue = branchData["minValue"].as<int>(0);
+                    branch.maxValue = branchData["maxValue"].as<int>(9999);
+                    branch.timeOfDay = branchData["timeOfDay"].as<std::string>("");
+                    branch.parameterName = branchData["parameterName"].as<std::string>("");
+                    branch.parameterValue = branchData["parameterValue"].as<std::string>("");
+                    branch.description = branchData["description"].as<std::string>("");
+                    node->setBranchCondition(branchData["index"].as<int>(), branch);
+                }
+            }
+
+            for (const auto& nodeData : rootNode["nodes"]) {
+                auto node = nodesById[nodeData["id"].as<int>()];
+                for (const auto& childData : nodeData["children"]) {
+                    auto child = nodesById.find(childData["id"].as<int>());
+                    if (child != nodesById.end()) {
+                        node->addChildNode(child->second, childData["label"].as<std::string>(""));
+                    }
+                }
+            }
+        }
+
+        for (const auto& treeData : rootNode["treeParameters"]) {
+            auto root = nodesById.find(treeData["root"].as<int>());
+            if (root == nodesById.end()) continue;
+            int rootId = root->second->getId();
+            readParameters(treeData["parameters"], [&manager, rootId](const std::string& key, const std::string& value, ParameterType paramType) {
+                manager.setTreeParameterWithType(rootId, key, value, paramType);
+            });
+        }
+
+        std::cout << "Dialogue data loaded successfully." << std::endl;
+        return true;
+    }
+    catch (const YAML::Exception& e) {
+        std::cerr << "Error loading dialogue data: " << e.what() << std::endl;
+        return false;
+    }
+}
@@ -0,0 +1,73 @@
+//DialogueProject.h
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "DialogueSystem.h"
+
+// ==========================================================
+// Dialogue project files
+// ==========================================================
+//
+// A project is a directory holding a small manifest (project.dlgp: responses, the tree
+// list and the next free node id) plus one file per tree (tree_<root id>.dlgt) with
+// that tree's node table, links, conditions, parameters and string pool. Splitting by
+// tree means a save only rewrites the trees that changed, and a tree can be read the
+// first time it's needed rather than up front.
+//
+// exportYaml writes the same data as readable YAML, streamed through YAML::Emitter
+// rather than built up as a YAML::Node first. importYaml reads it (or an older
+// dialogue_data.yaml) back in.
+
+class DialogueProject {
+public:
+    struct TreeInfo {
+        int rootId = -1;
+        uint32_t nodeCount = 0;
+        bool loaded = false;
+    };
+
+    explicit DialogueProject(const std::string& directory = "DialogueProject");
+
+    bool exists() const;
+    const std::string& getDirectory() const { return m_directory; }
+
+    // Replaces everything in the manager with the manifest's responses. Trees are
+    // listed but not read; use loadTree or loadAllTrees.
+    bool open(DialogueManager& manager);
+    // Reads one tree, and any tree it links into, if it isn't loaded yet
+    bool loadTree(DialogueManager& manager, int rootId);
+    // Returns how many trees were read
+    int loadAllTrees(DialogueManager& manager);
+    const std::vector<TreeInfo>& getTrees() const { return m_trees; }
+
+    // Writes every loaded tree and the manifest
+    bool saveAll(DialogueManager& manager);
+    // Writes only the trees the manager has marked dirty, then the manifest. Returns
+    // how many tree files were written or removed, -1 on failure.
+    int saveDirty(DialogueManager& manager);
+
+    static bool exportYaml(const DialogueManager& manager, const std::string& path);
+    static bool importYaml(DialogueManager& manager, const std::string& path);
+
+private:
+    std::string getTreePath(int rootId) const;
+    std::string getManifestPath() const;
+
+    // Groups every loaded node by the tree it belongs to, sorted by id
+    void collectTrees(const DialogueManager& manager, std::unordered_map<int, std::vector<int>>& nodesByRoot) const;
+    // Just one tree, for saving a few dirty trees without walking the whole project
+    void collectTree(const DialogueManager& manager, int rootId, std::vector<int>& nodeIds) const;
+    bool writeTree(const DialogueManager& manager, int rootId, const std::vector<int>& nodeIds);
+    bool readTree(DialogueManager& manager, int rootId, std::vector<std::pair<int, int>>& pendingLinks);
+    bool writeManifest(const DialogueManager& manager);
+    TreeInfo* findTree(int rootId);
+
+    std::string m_directory;
+    std::vector<TreeInfo> m_trees;
+    // Tree files being read by the current loadTree call, stops link cycles recursing
+    std::unordered_set<int> m_loading;
+};
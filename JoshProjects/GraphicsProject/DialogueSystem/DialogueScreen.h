@@ -33,7 +33,7 @@ public:
 
         // Initialize dialogue manager
         m_dialogueManager = std::make_unique<DialogueManager>();
-        m_dialogueManager->initialize(m_audioEngine->getWWiseEngine());
+        m_dialogueManager->initialize(m_audioEngine->getWWiseEngine(), m_audioEngine->getVoicePlayer());
         m_dialogueManager->setGame(m_game);
         
 
@@ -547,6 +547,13 @@ private:
 
         // Navigate through the dialogue tree
         static std::shared_ptr<DialogueNode> currentNode = startNode;
+        static std::shared_ptr<DialogueNode> voicedNode = nullptr;
+
+        // Speak each node once on arrival, which also starts reading the next lines
+        if (currentNode && currentNode != voicedNode) {
+            m_dialogueManager->playNodeVoice(currentNode, PersonalityType::Bubbly, VoiceType::Male1, npcId, playerId);
+            voicedNode = currentNode;
+        }
 
         if (currentNode) {
             // Display current node
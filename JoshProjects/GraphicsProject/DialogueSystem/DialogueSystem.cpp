@@ -1,6 +1,7 @@
 //DialogueSystem.cpp
 
 #include "DialogueSystem.h"
+#include "DialogueVoicePlayer.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -134,16 +135,16 @@ DialogueNode::DialogueNode(NodeType type, const std::string& text)
 
 void DialogueNode::addChildNode(std::shared_ptr<DialogueNode> node, const std::string& condition) {
     m_children.push_back(std::make_pair(node, condition));
-}
-
-std::vector<std::pair<std::shared_ptr<DialogueNode>, std::string>> DialogueNode::getChildren() const {
-    return m_children;
+    if (m_manager) {
+        m_manager->onChildAdded(m_id, node->getId());
+    }
 }
 
 bool DialogueNode::updateChildCondition(int childId, const std::string& newCondition) {
     for (auto& childPair : m_children) {
         if (childPair.first->getId() == childId) {
             childPair.second = newCondition;
+            touch();
             return true;
         }
     }
@@ -154,6 +155,9 @@ bool DialogueNode::removeChild(int childId) {
     for (auto it = m_children.begin(); it != m_children.end(); ++it) {
         if (it->first->getId() == childId) {
             m_children.erase(it);
+            if (m_manager) {
+                m_manager->onChildRemoved(m_id, childId);
+            }
             return true;
         }
     }
@@ -162,12 +166,19 @@ bool DialogueNode::removeChild(int childId) {
 
 void DialogueNode::setResponse(std::shared_ptr<DialogueResponse> response) {
     m_response = response;
+    touch();
 }
 
 std::shared_ptr<DialogueResponse> DialogueNode::getResponse() const {
     return m_response;
 }
 
+void DialogueNode::touch() {
+    if (m_manager) {
+        m_manager->markTreeDirty(m_id);
+    }
+}
+
 
 // ==========================================================
 // DialogueManager Implementation
@@ -180,15 +191,16 @@ DialogueManager::~DialogueManager() {
     shutdown();
 }
 
-bool DialogueManager::initialize(JAGEngine::WWiseAudioEngine* audioEngine) {
+bool DialogueManager::initialize(JAGEngine::WWiseAudioEngine* audioEngine, DialogueVoicePlayer* voicePlayer) {
     m_audioEngine = audioEngine;
+    m_voicePlayer = voicePlayer;
     return true;
 }
 
 void DialogueManager::shutdown() {
     // Clear all responses and nodes
     m_responses.clear();
-    m_nodes.clear();
+    clearAllNodes();
 }
 
 std::shared_ptr<DialogueResponse> DialogueManager::createResponse(ResponseType type, const std::string& defaultText) {
@@ -225,7 +237,7 @@ void DialogueManager::createConditionBranches(std::shared_ptr<DialogueNode> cond
     // Limit to requested number of branches
     branchLabels.resize(numBranches);
 
-    // Get existing children and their conditions
+    // Get existing children and their conditions (copied, the loop below removes them)
     auto children = conditionNode->getChildren();
     std::vector<std::shared_ptr<DialogueNode>> existingNodes;
     std::vector<std::string> existingLabels;
@@ -475,7 +487,7 @@ int DialogueManager::evaluateConditionBranchIndex(const DialogueCondition& condi
 std::shared_ptr<DialogueNode> DialogueManager::getNodeByBranchIndex(std::shared_ptr<DialogueNode> conditionNode, int branchIndex) {
     if (!conditionNode) return nullptr;
 
-    auto children = conditionNode->getChildren();
+    const auto& children = conditionNode->getChildren();
     if (children.empty()) return nullptr;
 
     // If branch index is out of bounds, use the last branch
@@ -509,6 +521,7 @@ void DialogueManager::generatePersonalityVariants(std::shared_ptr<DialogueRespon
 
         // Set as unedited
         response->setTextForPersonality(personality, generatedText, false);
+        markResponsesChanged();
 
         std::cout << "Generated " << getPersonalityName(personality)
             << " variant: " << generatedText << std::endl;
@@ -538,43 +551,43 @@ std::string DialogueManager::processNodeTextWithParameters(std::shared_ptr<Dialo
 std::string DialogueManager::generateTextWithGPT(ResponseType type, PersonalityType personality, const std::string& defaultText) {
     if (m_gptApiKey.empty()) {
         std::cerr << "No GPT API key set. Using mock responses." << std::endl;
-
-        // More detailed mock responses based on personality
-        switch (personality) {
-        case PersonalityType::Bubbly:
-            return "Absolutely! I'd be super happy to help with that!";
-        case PersonalityType::Grumpy:
-            return "Yeah, fine, whatever. I'll do it.";
-        case PersonalityType::Manic:
-            return "YES! YES! ABSOLUTELY YES!! LET'S DO THIS RIGHT NOW!!";
-        case PersonalityType::Shy:
-            return "Um... I guess... if that's okay with you...";
-        case PersonalityType::Serious:
-            return "Affirmative. I will proceed with the task.";
-        case PersonalityType::Anxious:
-            return "Oh! Yes, I can do that... unless that's going to be a problem?";
-        case PersonalityType::Confident:
-            return "Of course I can. There's nobody better for the job.";
-        case PersonalityType::Intellectual:
-            return "Indeed, I shall undertake this task with methodical precision.";
-        case PersonalityType::Mysterious:
-            return "Perhaps... if fate allows it... the task shall be done.";
-        case PersonalityType::Friendly:
-            return "Sure thing, friend! Happy to help!";
-        default:
-            return defaultText + " [Mock response]";
-        }
     }
+    return makeMockText(personality, defaultText, !m_gptApiKey.empty());
+}
 
-    // In a real implementation, you would:
-    // 1. Build a prompt with the personality and response type
-    std::string prompt = getPromptForPersonality(type, personality, defaultText);
-
-    // 2. Make an API call to GPT
-    // 3. Parse the response
+std::string DialogueManager::makeMockText(PersonalityType personality, const std::string& defaultText, bool hasApiKey) {
+    if (hasApiKey) {
+        // In a real implementation, you would build a prompt with the personality and
+        // response type, make an API call to GPT and parse the response.
+        // For demo, just return the mock
+        return defaultText + " [API Key present but using mock]";
+    }
 
-    // For demo, just return the mock
-    return defaultText + " [API Key present but using mock]";
+    // More detailed mock responses based on personality
+    switch (personality) {
+    case PersonalityType::Bubbly:
+        return "Absolutely! I'd be super happy to help with that!";
+    case PersonalityType::Grumpy:
+        return "Yeah, fine, whatever. I'll do it.";
+    case PersonalityType::Manic:
+        return "YES! YES! ABSOLUTELY YES!! LET'S DO THIS RIGHT NOW!!";
+    case PersonalityType::Shy:
+        return "Um... I guess... if that's okay with you...";
+    case PersonalityType::Serious:
+        return "Affirmative. I will proceed with the task.";
+    case PersonalityType::Anxious:
+        return "Oh! Yes, I can do that... unless that's going to be a problem?";
+    case PersonalityType::Confident:
+        return "Of course I can. There's nobody better for the job.";
+    case PersonalityType::Intellectual:
+        return "Indeed, I shall undertake this task with methodical precision.";
+    case PersonalityType::Mysterious:
+        return "Perhaps... if fate allows it... the task shall be done.";
+    case PersonalityType::Friendly:
+        return "Sure thing, friend! Happy to help!";
+    default:
+        return defaultText + " [Mock response]";
+    }
 }
 
 std::shared_ptr<DialogueResponse> DialogueManager::getResponse(ResponseType type) {
@@ -595,7 +608,27 @@ std::vector<std::shared_ptr<DialogueResponse>> DialogueManager::getAllResponses(
 
 std::shared_ptr<DialogueNode> DialogueManager::createDialogueNode(DialogueNode::NodeType type, const std::string& text) {
     auto node = std::make_shared<DialogueNode>(type, text);
+    node->m_manager = this;
     m_nodes[node->getId()] = node;
+    m_dirtyTrees.insert(node->getId());
+    m_revision++;
+    return node;
+}
+
+std::shared_ptr<DialogueNode> DialogueManager::restoreDialogueNode(int id, DialogueNode::NodeType type, const std::string& text) {
+    if (m_nodes.find(id) != m_nodes.end()) {
+        return nullptr;
+    }
+
+    auto node = std::make_shared<DialogueNode>(type, text);
+    node->m_id = id;
+    node->m_manager = this;
+    m_nodes[id] = node;
+    m_dirtyTrees.insert(id);
+    m_revision++;
+
+    // The constructor used up an id; make sure new nodes never reuse a saved one
+    DialogueNode::s_nextId = std::max(DialogueNode::s_nextId, id + 1);
     return node;
 }
 
@@ -624,6 +657,10 @@ bool DialogueManager::generateVoiceWithElevenLabs(const std::string& text, Perso
         return false;
     }
 
+    return writeMockVoiceFile(text, outputPath);
+}
+
+bool DialogueManager::writeMockVoiceFile(const std::string& text, const std::string& outputPath) {
     // Mock successful voice generation by creating an empty file
     std::ofstream outFile(outputPath);
     if (!outFile) {
@@ -765,17 +802,67 @@ const std::map<std::string, std::string>& DialogueManager::getTreeParameters(int
 
 // Method to find the root node for a given node
 int DialogueManager::findRootNodeId(int nodeId) const {
-    auto node = getNodeById(nodeId);
-    if (!node) return -1;
+    auto cached = m_rootIdCache.find(nodeId);
+    if (cached != m_rootIdCache.end()) {
+        return cached->second;
+    }
+
+    if (m_nodes.find(nodeId) == m_nodes.end()) return -1;
+
+    // Walk up the first-parent chain until we hit a cached node or a node with no parent.
+    // The step limit guards against a cycle made through the editor.
+    std::vector<int> path;
+    int currentId = nodeId;
+    int rootId = -1;
+    while (path.size() <= m_nodes.size()) {
+        cached = m_rootIdCache.find(currentId);
+        if (cached != m_rootIdCache.end()) {
+            rootId = cached->second;
+            break;
+        }
+
+        path.push_back(currentId);
+        auto parentIt = m_parentIds.find(currentId);
+        if (parentIt == m_parentIds.end()) {
+            // If this node has no parent, it's a root
+            rootId = currentId;
+            break;
+        }
+        currentId = parentIt->second.front();
+    }
+
+    for (int id : path) {
+        m_rootIdCache[id] = rootId;
+    }
+    return rootId;
+}
+
+std::vector<int> DialogueManager::getRootNodeIds() const {
+    std::vector<int> rootIds;
+    for (const auto& pair : m_nodes) {
+        // updateNodeType leaves the replaced id pointing at the new node, skip those
+        if (pair.first == pair.second->getId() && !hasParent(pair.first)) {
+            rootIds.push_back(pair.first);
+        }
+    }
+    std::sort(rootIds.begin(), rootIds.end());
+    return rootIds;
+}
 
-    // If this node has no parent, it's a root
-    if (!hasParent(nodeId)) return nodeId;
+int DialogueManager::getNextNodeId() const {
+    return DialogueNode::s_nextId;
+}
 
-    // Otherwise, recursively find the root
-    auto parent = findParentNode(nodeId);
-    if (!parent) return -1;
+void DialogueManager::reserveNodeIds(int nextId) {
+    DialogueNode::s_nextId = std::max(DialogueNode::s_nextId, nextId);
+}
 
-    return findRootNodeId(parent->getId());
+void DialogueManager::markTreeDirty(int nodeId) {
+    m_revision++;
+    int rootId = findRootNodeId(nodeId);
+    if (rootId >= 0) {
+        m_dirtyTrees.insert(rootId);
+    }
 }
 
 // Method to process text with tree parameters
@@ -926,13 +1013,65 @@ bool DialogueManager::playDialogueResponse(ResponseType type, PersonalityType pe
     // Create event ID
     AkUniqueID eventID = createDialogueEventID(type, personality, voice);
 
-    // In a real implementation, you would:
-    // 1. Play the Wwise event
     std::cout << "Playing dialogue event ID " << eventID << " from file " << filePath << std::endl;
+    if (m_voicePlayer) {
+        return m_voicePlayer->play(filePath);
+    }
 
     return true;
 }
 
+bool DialogueManager::playNodeVoice(std::shared_ptr<DialogueNode> node, PersonalityType personality, VoiceType voice, int npcId, int playerId) {
+    if (!node || !m_voicePlayer) return false;
+
+    std::string filePath = getNodeVoicePath(node, personality, voice);
+    bool queued = !filePath.empty() && m_voicePlayer->play(filePath);
+
+    // Queued after the play so the line that's needed now is read first
+    prefetchNextVoiceLines(node, personality, voice, npcId, playerId);
+    return queued;
+}
+
+void DialogueManager::prefetchNextVoiceLines(std::shared_ptr<DialogueNode> node, PersonalityType personality, VoiceType voice, int npcId, int playerId) {
+    if (!node || !m_voicePlayer) return;
+
+    // A condition check already knows where it's going, anything else can go to any child
+    std::vector<std::shared_ptr<DialogueNode>> candidates;
+    auto nextNode = findNextNode(node, npcId, playerId);
+    if (nextNode && nextNode != node) {
+        candidates.push_back(nextNode);
+    }
+    else {
+        for (const auto& childPair : node->getChildren()) {
+            candidates.push_back(childPair.first);
+        }
+    }
+
+    for (const auto& candidate : candidates) {
+        std::string filePath = getNodeVoicePath(candidate, personality, voice);
+        if (!filePath.empty()) {
+            m_voicePlayer->prefetch(filePath);
+        }
+
+        // Condition checks have no line of their own, look one step past them
+        if (candidate->getType() == DialogueNode::NodeType::ConditionCheck) {
+            auto resolved = findNextNode(candidate, npcId, playerId);
+            if (resolved && resolved != candidate) {
+                filePath = getNodeVoicePath(resolved, personality, voice);
+                if (!filePath.empty()) {
+                    m_voicePlayer->prefetch(filePath);
+                }
+            }
+        }
+    }
+}
+
+std::string DialogueManager::getNodeVoicePath(const std::shared_ptr<DialogueNode>& node, PersonalityType personality, VoiceType voice) const {
+    auto response = node ? node->getResponse() : nullptr;
+    if (!response) return "";
+    return response->getVoiceFilePath(personality, voice);
+}
+
 std::vector<std::shared_ptr<DialogueNode>> DialogueManager::getAllNodes() const {
     std::vector<std::shared_ptr<DialogueNode>> result;
     for (const auto& pair : m_nodes) {
@@ -950,18 +1089,33 @@ bool DialogueManager::deleteNode(int nodeId) {
 
     // Get the node to delete
     auto nodeToDelete = it->second;
+    markTreeDirty(nodeId);
 
-    // First, recursively delete all child nodes
+    // First, recursively delete all child nodes (copied, deleting them edits the list)
     auto children = nodeToDelete->getChildren();
     for (const auto& childPair : children) {
         deleteNode(childPair.first->getId());
     }
 
     // Remove this node from any parent nodes
-    removeChildFromParent(nodeId);
+    auto parentIt = m_parentIds.find(nodeId);
+    if (parentIt != m_parentIds.end()) {
+        std::vector<int> parentIds = parentIt->second;
+        for (int parentId : parentIds) {
+            auto parent = getNodeById(parentId);
+            if (parent) {
+                parent->removeChild(nodeId);
+            }
+        }
+        m_parentIds.erase(nodeId);
+    }
 
-    // Remove this node from our map
-    m_nodes.erase(it);
+    // Remove this node from our map. Someone may still hold the node, so detach it
+    // from the index first.
+    nodeToDelete->m_manager = nullptr;
+    m_nodes.erase(nodeId);
+    m_rootIdCache.clear();
+    m_revision++;
 
     return true;
 }
@@ -983,28 +1137,49 @@ std::shared_ptr<DialogueNode> DialogueManager::duplicateNode(int nodeId) {
     // Copy the condition if relevant
     newNode->setCondition(sourceNode->getCondition());
 
-    // We don't copy children, as that would potentially create a deep copy
+    // We don't copy children, as that would potentially create a deep copy.
+    // The copy starts out as a root; linking it under a parent updates the index.
 
     return newNode;
 }
 
 bool DialogueManager::hasParent(int nodeId) const {
     // Check if this node is a child of any other node
-    return findParentNode(nodeId) != nullptr;
+    return m_parentIds.find(nodeId) != m_parentIds.end();
 }
 
 std::shared_ptr<DialogueNode> DialogueManager::findParentNode(int childId) const {
-    for (const auto& pair : m_nodes) {
-        auto& parentNode = pair.second;
-        auto children = parentNode->getChildren();
+    auto it = m_parentIds.find(childId);
+    if (it == m_parentIds.end()) {
+        return nullptr;
+    }
+    return getNodeById(it->second.front());
+}
 
-        for (const auto& childPair : children) {
-            if (childPair.first->getId() == childId) {
-                return parentNode;
-            }
-        }
+void DialogueManager::onChildAdded(int parentId, int childId) {
+    // The child may have been the root of its own tree until now
+    markTreeDirty(childId);
+    m_parentIds[childId].push_back(parentId);
+    m_rootIdCache.clear();
+    markTreeDirty(parentId);
+}
+
+void DialogueManager::onChildRemoved(int parentId, int childId) {
+    markTreeDirty(parentId);
+    auto it = m_parentIds.find(childId);
+    if (it == m_parentIds.end()) return;
+
+    auto& parentIds = it->second;
+    auto parentIt = std::find(parentIds.begin(), parentIds.end(), parentId);
+    if (parentIt != parentIds.end()) {
+        parentIds.erase(parentIt);
     }
-    return nullptr;
+    if (parentIds.empty()) {
+        m_parentIds.erase(it);
+    }
+    m_rootIdCache.clear();
+    // And may be the root of a tree of its own now
+    markTreeDirty(childId);
 }
 
 bool DialogueManager::removeChildFromParent(int childId) {
@@ -1035,24 +1210,32 @@ bool DialogueManager::updateNodeType(int nodeId, DialogueNode::NodeType newType)
     // Copy condition if present
     newNode->setCondition(oldNode->getCondition());
 
-    // Copy children
-    for (const auto& childPair : oldNode->getChildren()) {
+    // Move children over to the new node
+    auto oldChildren = oldNode->getChildren();
+    for (const auto& childPair : oldChildren) {
+        oldNode->removeChild(childPair.first->getId());
         newNode->addChildNode(childPair.first, childPair.second);
     }
 
     // Replace the old node in all parent nodes
-    for (auto& pair : m_nodes) {
-        auto& node = pair.second;
-        auto children = node->getChildren();
-
-        for (const auto& childPair : children) {
-            if (childPair.first->getId() == nodeId) {
-                // Replace child with new node
-                node->removeChild(nodeId);
-                node->addChildNode(newNode, childPair.second);
+    auto parentIt = m_parentIds.find(nodeId);
+    if (parentIt != m_parentIds.end()) {
+        std::vector<int> parentIds = parentIt->second;
+        for (int parentId : parentIds) {
+            auto node = getNodeById(parentId);
+            if (!node) continue;
+
+            auto children = node->getChildren();
+            for (const auto& childPair : children) {
+                if (childPair.first->getId() == nodeId) {
+                    // Replace child with new node
+                    node->removeChild(nodeId);
+                    node->addChildNode(newNode, childPair.second);
+                }
             }
         }
     }
+    oldNode->m_manager = nullptr;
 
     // Replace old node in the map
     m_nodes[nodeId] = newNode;
@@ -1141,7 +1324,7 @@ std::shared_ptr<DialogueNode> DialogueManager::findNextNode(std::shared_ptr<Dial
     switch (currentNode->getType()) {
     case DialogueNode::NodeType::ConditionCheck: {
         // Get all child branches
-        auto children = currentNode->getChildren();
+        const auto& children = currentNode->getChildren();
         if (children.empty()) {
             return nullptr; // No branches to follow
         }
@@ -1275,6 +1458,11 @@ bool DialogueManager::checkPlayerStat(const std::string& statName, int threshold
 }
 
 void DialogueManager::clearAllNodes() {
+    // Every tree goes away, so the next save should drop all of them
+    for (int rootId : getRootNodeIds()) {
+        m_dirtyTrees.insert(rootId);
+    }
+
     // Get a copy of all node IDs since we'll be modifying the collection
     std::vector<int> nodeIds;
     for (const auto& pair : m_nodes) {
@@ -1283,8 +1471,12 @@ void DialogueManager::clearAllNodes() {
 
     // Delete nodes in reverse order (children before parents)
     for (auto it = nodeIds.rbegin(); it != nodeIds.rend(); ++it) {
+        m_nodes[*it]->m_manager = nullptr;
         m_nodes.erase(*it);
     }
+    m_parentIds.clear();
+    m_rootIdCache.clear();
+    m_revision++;
 }
 
 std::string DialogueManager::buildAudioFilePath(ResponseType type, PersonalityType personality, VoiceType voice) {
@@ -2,18 +2,21 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include "JAGEngine/IMainGame.h"
 
 // Forward declaration of Wwise Audio Engine from JAGEngine
 namespace JAGEngine {
     class WWiseAudioEngine;
 }
+class DialogueVoicePlayer;
 
 // ==========================================================
 // Dialogue System Core Classes
@@ -466,6 +469,7 @@ public:
 
     // Core properties
     ResponseType getType() const { return m_type; }
+    const std::string& getDefaultText() const { return m_defaultText; }
     std::string getName() const { return m_name; }
     void setName(const std::string& name) { m_name = name; }
 
@@ -507,18 +511,21 @@ public:
         BranchPoint          // Pure branching point with no displayed text
     };
 
+    using ChildList = std::vector<std::pair<std::shared_ptr<DialogueNode>, std::string>>;
+
     DialogueNode(NodeType type, const std::string& text);
     ~DialogueNode() = default;
 
     // Node properties
     NodeType getType() const { return m_type; }
     std::string getText() const { return m_text; }
-    void setText(const std::string& text) { m_text = text; }
+    void setText(const std::string& text) { m_text = text; touch(); }
     int getId() const { return m_id; }
 
     // Child nodes
     void addChildNode(std::shared_ptr<DialogueNode> node, const std::string& condition = "");
-    std::vector<std::pair<std::shared_ptr<DialogueNode>, std::string>> getChildren() const;
+    // Don't hold on to this across addChildNode/removeChild calls, copy it if the list can change
+    const ChildList& getChildren() const { return m_children; }
     bool updateChildCondition(int childId, const std::string& newCondition);
     bool removeChild(int childId);
 
@@ -526,20 +533,25 @@ public:
     void setResponse(std::shared_ptr<DialogueResponse> response);
     std::shared_ptr<DialogueResponse> getResponse() const;
 
-    void setCondition(const DialogueCondition& condition) { m_condition = condition; }
+    void setCondition(const DialogueCondition& condition) { m_condition = condition; touch(); }
     DialogueCondition getCondition() const { return m_condition; }
 
     void setBranchCondition(int branchIndex, const BranchCondition& condition) {
         m_branchConditions[branchIndex] = condition;
+        touch();
     }
 
+    const std::map<int, BranchCondition>& getBranchConditions() const { return m_branchConditions; }
+
     void setParameter(const std::string& key, const std::string& value) {
         m_parameters[key] = value;
+        touch();
     }
 
     void setParameterWithType(const std::string& key, const std::string& value, ParameterType type) {
         m_parameters[key] = value;
         m_parameterTypes[key] = type;
+        touch();
     }
 
     std::string getParameter(const std::string& key) const {
@@ -576,12 +588,19 @@ public:
     }
 
 private:
+    friend class DialogueManager;
+
+    // Tells the manager this node's tree needs saving
+    void touch();
+
     static int s_nextId;
 
     int m_id;
     NodeType m_type;
     std::string m_text;
-    std::vector<std::pair<std::shared_ptr<DialogueNode>, std::string>> m_children;
+    ChildList m_children;
+    // Owning manager, told about every link change so it can keep its parent index
+    DialogueManager* m_manager = nullptr;
     std::shared_ptr<DialogueResponse> m_response;
     DialogueCondition m_condition;
     std::map<int, BranchCondition> m_branchConditions;
@@ -596,7 +615,8 @@ public:
     ~DialogueManager();
 
     // Initialization
-    bool initialize(JAGEngine::WWiseAudioEngine* audioEngine);
+    // Voice lines are queued on voicePlayer when given, otherwise only logged
+    bool initialize(JAGEngine::WWiseAudioEngine* audioEngine, DialogueVoicePlayer* voicePlayer = nullptr);
     void shutdown();
 
     using AkUniqueID = unsigned int;
@@ -611,12 +631,18 @@ public:
 
     // Dialogue tree management
     std::shared_ptr<DialogueNode> createDialogueNode(DialogueNode::NodeType type, const std::string& text);
+    // Recreates a saved node under its old id. Returns nullptr if the id is taken.
+    std::shared_ptr<DialogueNode> restoreDialogueNode(int id, DialogueNode::NodeType type, const std::string& text);
     std::shared_ptr<DialogueNode> getNodeById(int id) const;
 
     // API integrations
     void setAPIKeys(const std::string& gptKey, const std::string& elevenLabsKey);
     std::string generateTextWithGPT(ResponseType type, PersonalityType personality, const std::string& defaultText);
     bool generateVoiceWithElevenLabs(const std::string& text, PersonalityType personality, VoiceType voice, const std::string& outputPath);
+    // The mock results behind the two calls above. They don't touch the manager, so the
+    // generation queue's worker can use them with the key it captured at enqueue time.
+    static std::string makeMockText(PersonalityType personality, const std::string& defaultText, bool hasApiKey);
+    static bool writeMockVoiceFile(const std::string& text, const std::string& outputPath);
 
     // Batch operations
     void generateAllTextVariants();
@@ -631,6 +657,10 @@ public:
     using AkUniqueID = unsigned int; // Define AkUniqueID as a typedef
     bool registerWithWwise();
     bool playDialogueResponse(ResponseType type, PersonalityType personality, VoiceType voice);
+    // Queues the node's voice line, then prefetches the lines of the nodes that can
+    // follow it. Returns false if the node has no generated line.
+    bool playNodeVoice(std::shared_ptr<DialogueNode> node, PersonalityType personality, VoiceType voice, int npcId, int playerId);
+    void prefetchNextVoiceLines(std::shared_ptr<DialogueNode> node, PersonalityType personality, VoiceType voice, int npcId, int playerId);
 
     // dialogue tree editor
     std::vector<std::shared_ptr<DialogueNode>> getAllNodes() const;
@@ -681,11 +711,15 @@ public:
 
     void setTreeParameter(int rootNodeId, const std::string& key, const std::string& value) {
         m_treeParameters[rootNodeId][key] = value;
+        m_dirtyTrees.insert(rootNodeId);
+        m_revision++;
     }
 
     void setTreeParameterWithType(int rootNodeId, const std::string& key, const std::string& value, ParameterType type) {
         m_treeParameters[rootNodeId][key] = value;
         m_treeParameterTypes[rootNodeId][key] = type;
+        m_dirtyTrees.insert(rootNodeId);
+        m_revision++;
     }
 
     std::string getTreeParameter(int rootNodeId, const std::string& key) const;
@@ -694,8 +728,31 @@ public:
 
     const std::map<std::string, std::string>& getTreeParameters(int rootNodeId) const;
 
-    // Method to find the root node for a given node
+    // Method to find the root node for a given node (cached until the tree changes)
     int findRootNodeId(int nodeId) const;
+    std::vector<int> getRootNodeIds() const;
+
+    // Root ids of trees edited since the last clearDirtyTrees(). A tree that was merged
+    // into another or deleted stays in here until then so its save can be removed.
+    void markTreeDirty(int nodeId);
+    const std::unordered_set<int>& getDirtyTrees() const { return m_dirtyTrees; }
+    void clearDirtyTrees() { m_dirtyTrees.clear(); m_responsesDirty = false; }
+    void setDirtyTrees(const std::unordered_set<int>& rootIds) { m_dirtyTrees = rootIds; }
+    // Responses aren't part of any tree, they're saved with the project manifest
+    bool areResponsesDirty() const { return m_responsesDirty; }
+    bool hasUnsavedChanges() const { return m_responsesDirty || !m_dirtyTrees.empty(); }
+
+    // Goes up on every node, link, tree parameter or response text edit. Views compare it
+    // against the value they last built from instead of walking the trees each frame.
+    uint32_t getRevision() const { return m_revision; }
+
+    // Responses don't know their manager, so whoever changes their name, text or voice
+    // files calls this
+    void markResponsesChanged() { m_revision++; m_responsesDirty = true; }
+
+    // Node ids handed out so far, saved with a project so unloaded trees keep theirs
+    int getNextNodeId() const;
+    void reserveNodeIds(int nextId);
 
     // Method to process text with tree parameters
     std::string processTextWithTreeParameters(int nodeId, const std::string& text) const;
@@ -709,19 +766,37 @@ public:
     void testDialogueWithParameters();
 
 private:
+    friend class DialogueNode;
+    friend class GenerationQueue;
+
+    // Called by DialogueNode whenever a child link is added or removed
+    void onChildAdded(int parentId, int childId);
+    void onChildRemoved(int parentId, int childId);
+
     JAGEngine::IMainGame* m_game;
     JAGEngine::WWiseAudioEngine* m_audioEngine;
+    DialogueVoicePlayer* m_voicePlayer = nullptr;
     std::string m_gptApiKey;
     std::string m_elevenLabsKey;
     std::string m_elevenLabsApiKey;
     std::unordered_map<ResponseType, std::shared_ptr<DialogueResponse>> m_responses;
     std::unordered_map<int, std::shared_ptr<DialogueNode>> m_nodes;
+    // Child id -> parent ids, in link order. A node can sit under more than one parent
+    // (e.g. two choices leading to the same line); the first one is "the" parent.
+    std::unordered_map<int, std::vector<int>> m_parentIds;
+    // Node id -> root id, filled lazily by findRootNodeId and dropped on any link change
+    mutable std::unordered_map<int, int> m_rootIdCache;
+    std::unordered_set<int> m_dirtyTrees;
+    bool m_responsesDirty = false;
+    uint32_t m_revision = 0;
     std::map<int, std::map<std::string, std::string>> m_treeParameters;
     std::map<int, std::map<std::string, ParameterType>> m_treeParameterTypes;
 
     // Helper methods
     std::string getPromptForPersonality(ResponseType type, PersonalityType personality, const std::string& defaultText);
     std::string getVoiceIdFromType(VoiceType voice);
+    // Empty if the node has no response or the line isn't generated
+    std::string getNodeVoicePath(const std::shared_ptr<DialogueNode>& node, PersonalityType personality, VoiceType voice) const;
 
     // Test data structures - make sure these are properly declared with types
     std::map<std::pair<int, int>, RelationshipStatus> m_testRelationships;
@@ -4,7 +4,6 @@
 #include <ImGui/imgui.h>
 #include <vector>
 #include <string>
-#include <functional>
 
 // This function creates a sample dialogue tree similar to your diagram
 void createSampleDialogueTree(DialogueManager* manager) {
@@ -110,68 +109,157 @@ void createSampleDialogueTree(DialogueManager* manager) {
     whyNode->addChildNode(dontKnowNode);
 }
 
-// Render the dialogue tree with ImGui
-void renderDialogueTreeView(DialogueManager* manager, std::shared_ptr<DialogueNode> rootNode) {
-    if (!rootNode) return;
+// ==========================================================
+// DialogueRowList Implementation
+// ==========================================================
 
-    ImGui::SetNextWindowPos(ImVec2(500, 50), ImGuiCond_FirstUseEver);
-    ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiCond_FirstUseEver);
+DialogueRowList::DialogueRowList(bool startOpen) :
+    m_startOpen(startOpen) {
+}
 
-    if (ImGui::Begin("Dialogue Tree Viewer")) {
-        // Display function for recursive tree rendering
-        std::function<void(std::shared_ptr<DialogueNode>, int)> displayNode;
-
-        displayNode = [&displayNode, manager](std::shared_ptr<DialogueNode> node, int depth) {
-            if (!node) return;
-
-            // Create indentation based on depth
-            ImGui::Indent(depth * 20.0f);
-
-            // Process text using the dialogue manager so placeholders (like [NPC1]) are replaced
-            std::string nodeText = manager->processTextWithTreeParameters(node->getId(), node->getText());
-            std::string typeText;
-
-            switch (node->getType()) {
-            case DialogueNode::NodeType::NPCStatement:
-                typeText = "[Statement]";
-                break;
-            case DialogueNode::NodeType::PlayerChoice:
-                typeText = "[Player Choice]";
-                break;
-            case DialogueNode::NodeType::DynamicStatement:
-                typeText = "[Dynamic]";
-                break;
-            }
+const std::vector<DialogueRowList::Row>& DialogueRowList::getRows(const DialogueManager& manager, int rootId) {
+    if (m_rowsValid && m_revision == manager.getRevision() && m_rootId == rootId) {
+        return m_rows;
+    }
 
-            // Get response text if available
-            std::string responseText;
-            auto response = node->getResponse();
-            if (response) {
-                responseText = " -> \"" + response->getTextForPersonality(PersonalityType::Bubbly) + "\"";
-            }
+    // Text, links or parameters changed, so any label could be stale
+    if (m_revision != manager.getRevision()) {
+        m_labels.clear();
+    }
+    m_revision = manager.getRevision();
+    m_rootId = rootId;
+    m_rowsValid = true;
+
+    m_rows.clear();
+    m_visiting.clear();
+    if (rootId >= 0) {
+        addRows(manager, manager.getNodeById(rootId), -1, 0);
+    }
+    else {
+        for (int id : manager.getRootNodeIds()) {
+            addRows(manager, manager.getNodeById(id), -1, 0);
+        }
+    }
+    return m_rows;
+}
 
-            ImGui::Text("%s %s%s", nodeText.c_str(), typeText.c_str(), responseText.c_str());
+void DialogueRowList::addRows(const DialogueManager& manager, const std::shared_ptr<DialogueNode>& node, int parentId, int depth) {
+    if (!node || m_visiting.count(node->getId())) return;
+
+    const auto& children = node->getChildren();
+    Row row;
+    row.nodeId = node->getId();
+    row.parentId = parentId;
+    row.depth = depth;
+    row.hasChildren = !children.empty();
+    m_rows.push_back(row);
+
+    if (children.empty() || !isOpen(node->getId())) return;
+
+    m_visiting.insert(node->getId());
+    for (size_t i = 0; i < children.size(); i++) {
+        if (!children[i].second.empty()) {
+            Row branch;
+            branch.type = RowType::Branch;
+            branch.nodeId = children[i].first->getId();
+            branch.parentId = node->getId();
+            branch.depth = depth + 1;
+            branch.branchIndex = (int)i;
+            branch.branchCount = (int)children.size();
+            branch.condition = children[i].second;
+            m_rows.push_back(branch);
+        }
 
-            // Display children nodes
-            for (const auto& childPair : node->getChildren()) {
-                std::string condition = childPair.second;
-                if (!condition.empty()) {
-                    ImGui::Indent(depth * 20.0f + 10.0f);
-                    ImGui::Text("(Condition: %s)", condition.c_str());
-                    ImGui::Unindent(depth * 20.0f + 10.0f);
-                }
-                displayNode(childPair.first, depth + 1);
-            }
+        size_t childRow = m_rows.size();
+        addRows(manager, children[i].first, node->getId(), depth + 1);
+        if (childRow < m_rows.size()) {
+            m_rows[childRow].branchIndex = (int)i;
+            m_rows[childRow].branchCount = (int)children.size();
+        }
+    }
+    m_visiting.erase(node->getId());
+}
 
-            ImGui::Unindent(depth * 20.0f);
-        };
+bool DialogueRowList::isOpen(int nodeId) const {
+    return (m_toggled.count(nodeId) > 0) != m_startOpen;
+}
+
+void DialogueRowList::setOpen(int nodeId, bool open) {
+    if (isOpen(nodeId) == open) return;
+
+    if (open != m_startOpen) {
+        m_toggled.insert(nodeId);
+    }
+    else {
+        m_toggled.erase(nodeId);
+    }
+    m_rowsValid = false;
+}
+
+void DialogueRowList::invalidate() {
+    m_rowsValid = false;
+    m_labels.clear();
+}
 
+// Render the dialogue tree with ImGui
+void renderDialogueTreeView(DialogueManager* manager, std::shared_ptr<DialogueNode> rootNode, DialogueRowList& rowList) {
+    if (!rootNode) return;
+
+    ImGui::SetNextWindowPos(ImVec2(500, 50), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiCond_FirstUseEver);
+
+    if (ImGui::Begin("Dialogue Tree Viewer")) {
+        // The row list only changes when the tree does
+        const auto& rows = rowList.getRows(*manager, rootNode->getId());
 
-        // Start rendering from the root
         ImGui::Text("Dialogue Tree Structure:");
         ImGui::Separator();
 
-        displayNode(rootNode, 0);
+        ImGuiListClipper clipper;
+        clipper.Begin((int)rows.size());
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const auto& row = rows[i];
+
+                if (row.type == DialogueRowList::RowType::Branch) {
+                    // Sits between the parent and the child it leads to
+                    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + (row.depth - 1) * 20.0f + 10.0f);
+                    ImGui::Text("(Condition: %s)", row.condition.c_str());
+                    continue;
+                }
+
+                auto node = manager->getNodeById(row.nodeId);
+                if (!node) continue;
+
+                const std::string& label = rowList.getLabel(row.nodeId, [&]() {
+                    // Process text using the dialogue manager so placeholders (like [NPC1]) are replaced
+                    std::string text = manager->processTextWithTreeParameters(node->getId(), node->getText());
+
+                    switch (node->getType()) {
+                    case DialogueNode::NodeType::NPCStatement:
+                        text += " [Statement]";
+                        break;
+                    case DialogueNode::NodeType::PlayerChoice:
+                        text += " [Player Choice]";
+                        break;
+                    case DialogueNode::NodeType::DynamicStatement:
+                        text += " [Dynamic]";
+                        break;
+                    default:
+                        break;
+                    }
+
+                    auto response = node->getResponse();
+                    if (response) {
+                        text += " -> \"" + response->getTextForPersonality(PersonalityType::Bubbly) + "\"";
+                    }
+                    return text;
+                });
+
+                ImGui::SetCursorPosX(ImGui::GetCursorPosX() + row.depth * 20.0f);
+                ImGui::TextUnformatted(label.c_str());
+            }
+        }
     }
     ImGui::End();
 }
@@ -198,7 +286,7 @@ void renderDialoguePlayer(DialogueManager* manager, std::shared_ptr<DialogueNode
         ImGui::Separator();
 
         // Show children nodes as choice buttons
-        auto children = currentNode->getChildren();
+        const auto& children = currentNode->getChildren();
         if (!children.empty()) {
             ImGui::Text("Your choices:");
 
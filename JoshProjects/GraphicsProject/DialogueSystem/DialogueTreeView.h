@@ -4,16 +4,87 @@
 
 #include "DialogueSystem.h"
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // Forward declarations for ImGui - you don't need full ImGui.h here
 struct ImVec2;
 struct ImVec4;
 
+// ==========================================================
+// Flattened tree rows
+// ==========================================================
+//
+// The tree views draw one row per visible node (and per branch label) out of a flat
+// list, so they can hand it to ImGuiListClipper and only lay out what's on screen. The
+// list is rebuilt when the manager's revision, the roots or a node's open state change,
+// not every frame. Labels are built on first draw and kept until the next edit.
+
+class DialogueRowList {
+public:
+    enum class RowType {
+        Node,
+        Branch      // Condition text shown above a child
+    };
+
+    struct Row {
+        RowType type = RowType::Node;
+        int nodeId = -1;
+        int parentId = -1;
+        int depth = 0;
+        bool hasChildren = false;
+        // Position among the parent's children, used for ConditionCheck colours
+        int branchIndex = 0;
+        int branchCount = 0;
+        std::string condition;
+    };
+
+    // With startOpen every node begins expanded, otherwise collapsed
+    explicit DialogueRowList(bool startOpen = false);
+
+    // Rows under rootId, or under every root if it's -1
+    const std::vector<Row>& getRows(const DialogueManager& manager, int rootId = -1);
+
+    bool isOpen(int nodeId) const;
+    void setOpen(int nodeId, bool open);
+
+    // Cached label for a node, made with buildLabel() the first time it's asked for
+    // after an edit
+    template <typename BuildLabel>
+    const std::string& getLabel(int nodeId, BuildLabel buildLabel) {
+        auto it = m_labels.find(nodeId);
+        if (it == m_labels.end()) {
+            it = m_labels.emplace(nodeId, buildLabel()).first;
+        }
+        return it->second;
+    }
+
+    // Forces the next getRows to rebuild and drops every cached label
+    void invalidate();
+
+private:
+    void addRows(const DialogueManager& manager, const std::shared_ptr<DialogueNode>& node, int parentId, int depth);
+
+    bool m_startOpen;
+    bool m_rowsValid = false;
+    uint32_t m_revision = 0;
+    int m_rootId = -1;
+    std::vector<Row> m_rows;
+    // Nodes whose open state differs from m_startOpen
+    std::unordered_set<int> m_toggled;
+    // Nodes on the path being flattened, so a link back up the tree doesn't recurse forever
+    std::unordered_set<int> m_visiting;
+    std::unordered_map<int, std::string> m_labels;
+};
+
 // Creates a sample dialogue tree for demonstration
 void createSampleDialogueTree(DialogueManager* manager);
 
-// Renders a structured view of a dialogue tree with ImGui
-void renderDialogueTreeView(DialogueManager* manager, std::shared_ptr<DialogueNode> rootNode);
+// Renders a structured view of a dialogue tree with ImGui. rowList keeps the flattened
+// rows between frames; make it with startOpen so the whole tree shows expanded.
+void renderDialogueTreeView(DialogueManager* manager, std::shared_ptr<DialogueNode> rootNode, DialogueRowList& rowList);
 
 // Renders an interactive dialogue player interface for testing conversations
 void renderDialoguePlayer(DialogueManager* manager, std::shared_ptr<DialogueNode> currentNode);
\ No newline at end of file
@@ -0,0 +1,158 @@
+//DialogueVoicePlayer.cpp
+
+#include "DialogueVoicePlayer.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+DialogueVoicePlayer::DialogueVoicePlayer() {
+}
+
+DialogueVoicePlayer::~DialogueVoicePlayer() {
+    shutdown();
+}
+
+void DialogueVoicePlayer::start(PlayFunc playFunc, StopFunc stopFunc, uint64_t cacheBudgetBytes) {
+    if (isRunning()) return;
+
+    m_playFunc = std::move(playFunc);
+    m_stopFunc = std::move(stopFunc);
+    m_cacheBudget = cacheBudgetBytes;
+    m_running = true;
+    m_worker = std::thread(&DialogueVoicePlayer::workerLoop, this);
+}
+
+void DialogueVoicePlayer::shutdown() {
+    if (!isRunning()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+
+    // Anything still queued is never going to play
+    Command command;
+    while (m_commands.pop(command)) {}
+    m_cache.clear();
+    m_lru.clear();
+    m_cachedBytes = 0;
+    m_cachedBytesShared = 0;
+}
+
+bool DialogueVoicePlayer::play(const std::string& path) {
+    return pushCommand(Command::Type::Play, path);
+}
+
+bool DialogueVoicePlayer::prefetch(const std::string& path) {
+    return pushCommand(Command::Type::Prefetch, path);
+}
+
+bool DialogueVoicePlayer::stop() {
+    return pushCommand(Command::Type::Stop, "");
+}
+
+DialogueVoicePlayer::Stats DialogueVoicePlayer::getStats() const {
+    Stats stats;
+    stats.plays = m_plays;
+    stats.prefetchHits = m_prefetchHits;
+    stats.loads = m_loads;
+    stats.failedLoads = m_failedLoads;
+    stats.cachedBytes = m_cachedBytesShared;
+    return stats;
+}
+
+bool DialogueVoicePlayer::pushCommand(Command::Type type, const std::string& path) {
+    if (!isRunning()) return false;
+
+    Command command;
+    command.type = type;
+    command.path = path;
+    if (!m_commands.push(std::move(command))) {
+        m_droppedCommands++;
+        return false;
+    }
+    // No lock here, so the wakeup can be missed. The voice thread never sleeps for
+    // more than a few milliseconds at a time, which covers it.
+    m_wake.notify_one();
+    return true;
+}
+
+void DialogueVoicePlayer::workerLoop() {
+    Command command;
+    while (true) {
+        if (!m_commands.pop(command)) {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            if (!m_running) break;
+            m_wake.wait_for(lock, std::chrono::milliseconds(5));
+            continue;
+        }
+
+        switch (command.type) {
+        case Command::Type::Play: {
+            bool wasCached = false;
+            const VoiceClip* clip = getClip(command.path, wasCached);
+            m_plays++;
+            if (wasCached) m_prefetchHits++;
+            if (clip && m_playFunc) {
+                m_playFunc(*clip);
+            }
+            break;
+        }
+        case Command::Type::Prefetch: {
+            bool wasCached = false;
+            getClip(command.path, wasCached);
+            break;
+        }
+        case Command::Type::Stop:
+            if (m_stopFunc) {
+                m_stopFunc();
+            }
+            break;
+        }
+    }
+}
+
+const VoiceClip* DialogueVoicePlayer::getClip(const std::string& path, bool& wasCached) {
+    auto it = m_cache.find(path);
+    if (it != m_cache.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+        wasCached = true;
+        return &it->second.clip;
+    }
+    wasCached = false;
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cerr << "Error: Could not open voice file " << path << std::endl;
+        m_failedLoads++;
+        return nullptr;
+    }
+
+    CacheEntry entry;
+    entry.clip.path = path;
+    entry.clip.data.resize((size_t)file.tellg());
+    file.seekg(0);
+    file.read(entry.clip.data.data(), (std::streamsize)entry.clip.data.size());
+    m_loads++;
+
+    m_lru.push_front(path);
+    entry.lruPosition = m_lru.begin();
+    m_cachedBytes += entry.clip.data.size();
+    VoiceClip* clip = &m_cache.emplace(path, std::move(entry)).first->second.clip;
+
+    trimCache();
+    m_cachedBytesShared = m_cachedBytes;
+    return clip;
+}
+
+void DialogueVoicePlayer::trimCache() {
+    // Never evicts the clip just loaded, even if it's bigger than the whole budget
+    while (m_cachedBytes > m_cacheBudget && m_lru.size() > 1) {
+        auto it = m_cache.find(m_lru.back());
+        m_cachedBytes -= it->second.clip.data.size();
+        m_cache.erase(it);
+        m_lru.pop_back();
+    }
+}
@@ -0,0 +1,140 @@
+//DialogueVoicePlayer.h
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// ==========================================================
+// Voice line playback
+// ==========================================================
+//
+// The game thread never touches the disk to start a line. play / prefetch / stop are
+// pushed onto a lock-free single-producer / single-consumer ring and a voice thread
+// does the rest: it reads clips under Audio/Dialogue/ into an LRU cache (bounded by
+// bytes) and hands them to the output. Prefetching the lines that can come next means
+// the clip is usually already in memory by the time it's played.
+//
+// Every call except the stats getters has to come from the same thread.
+
+// Fixed-size ring with one writer and one reader, neither ever blocks
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two");
+
+public:
+    // False when full, the item is left untouched
+    bool push(T&& item) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) return false;
+        m_items[tail & (Capacity - 1)] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        item = std::move(m_items[head & (Capacity - 1)]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, Capacity> m_items;
+    // Kept on separate cache lines so the two threads don't fight over them
+    alignas(64) std::atomic<size_t> m_head{ 0 };
+    alignas(64) std::atomic<size_t> m_tail{ 0 };
+};
+
+struct VoiceClip {
+    std::string path;
+    std::vector<char> data;
+};
+
+class DialogueVoicePlayer {
+public:
+    // Both run on the voice thread
+    using PlayFunc = std::function<void(const VoiceClip& clip)>;
+    using StopFunc = std::function<void()>;
+
+    struct Stats {
+        int plays = 0;
+        int prefetchHits = 0; // Lines that were already in memory when played
+        int loads = 0;        // Clips read from disk
+        int failedLoads = 0;
+        uint64_t cachedBytes = 0;
+    };
+
+    DialogueVoicePlayer();
+    ~DialogueVoicePlayer();
+
+    void start(PlayFunc playFunc, StopFunc stopFunc, uint64_t cacheBudgetBytes = 32ull * 1024 * 1024);
+    void shutdown();
+    bool isRunning() const { return m_worker.joinable(); }
+
+    // Each returns false if the queue is full and the command was dropped
+    bool play(const std::string& path);
+    bool prefetch(const std::string& path);
+    bool stop();
+
+    Stats getStats() const;
+    int getDroppedCommandCount() const { return m_droppedCommands; }
+
+private:
+    struct Command {
+        enum class Type { Play, Prefetch, Stop };
+        Type type = Type::Stop;
+        std::string path;
+    };
+
+    struct CacheEntry {
+        VoiceClip clip;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    bool pushCommand(Command::Type type, const std::string& path);
+    void workerLoop();
+    // Voice thread only. nullptr if the file can't be read.
+    const VoiceClip* getClip(const std::string& path, bool& wasCached);
+    void trimCache();
+
+    SpscQueue<Command, 256> m_commands;
+    int m_droppedCommands = 0;
+
+    // Only for waking the voice thread, the queue itself needs no lock
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_running{ false };
+    std::thread m_worker;
+
+    PlayFunc m_playFunc;
+    StopFunc m_stopFunc;
+
+    // Voice thread only
+    std::unordered_map<std::string, CacheEntry> m_cache;
+    std::list<std::string> m_lru; // Most recently used at the front
+    uint64_t m_cacheBudget = 0;
+    uint64_t m_cachedBytes = 0;
+
+    // Written by the voice thread, read by anyone
+    std::atomic<int> m_plays{ 0 };
+    std::atomic<int> m_prefetchHits{ 0 };
+    std::atomic<int> m_loads{ 0 };
+    std::atomic<int> m_failedLoads{ 0 };
+    std::atomic<uint64_t> m_cachedBytesShared{ 0 };
+};
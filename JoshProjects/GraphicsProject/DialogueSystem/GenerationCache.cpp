@@ -0,0 +1,307 @@
+//GenerationCache.cpp
+
+#include "GenerationCache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    uint64_t hashBytes(uint64_t hash, const char* data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= (unsigned char)data[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    // Length goes in first so ("ab", "c") and ("a", "bc") don't collide
+    uint64_t hashField(uint64_t hash, const std::string& field) {
+        uint64_t length = field.size();
+        hash = hashBytes(hash, reinterpret_cast<const char*>(&length), sizeof(length));
+        return hashBytes(hash, field.data(), field.size());
+    }
+
+    std::string toHex(uint64_t value) {
+        char buffer[17];
+        snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)value);
+        return buffer;
+    }
+
+    bool fromHex(const std::string& text, uint64_t& value) {
+        if (text.size() != 16) return false;
+        char* end = nullptr;
+        value = std::strtoull(text.c_str(), &end, 16);
+        return end == text.c_str() + text.size();
+    }
+
+    bool readFile(const std::string& path, std::string& contents) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        contents = stream.str();
+        return true;
+    }
+}
+
+GenerationCache::GenerationCache(const std::string& directory) :
+    m_directory(directory) {
+}
+
+uint64_t GenerationCache::makeTextKey(const std::string& prompt, const std::string& model) {
+    uint64_t hash = hashField(FNV_OFFSET, "text");
+    hash = hashField(hash, prompt);
+    return hashField(hash, model);
+}
+
+uint64_t GenerationCache::makeVoiceKey(const std::string& text, const std::string& voiceId, const std::string& model) {
+    uint64_t hash = hashField(FNV_OFFSET, "voice");
+    hash = hashField(hash, text);
+    hash = hashField(hash, voiceId);
+    return hashField(hash, model);
+}
+
+bool GenerationCache::findText(uint64_t key, std::string& text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->second.kind != Kind::Text) return false;
+
+    uint64_t blob = it->second.blob;
+    auto cached = m_textBlobs.find(blob);
+    if (cached == m_textBlobs.end()) {
+        std::string contents;
+        if (!readFile(blobPath(blob, Kind::Text), contents)) return false;
+        cached = m_textBlobs.emplace(blob, std::move(contents)).first;
+    }
+    text = cached->second;
+    return true;
+}
+
+std::string GenerationCache::findVoice(uint64_t key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->second.kind != Kind::Voice) return "";
+    if (m_blobSizes.find(it->second.blob) == m_blobSizes.end()) return "";
+    return blobPath(it->second.blob, Kind::Voice);
+}
+
+void GenerationCache::storeText(uint64_t key, const std::string& text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+
+    uint64_t blob = hashBytes(FNV_OFFSET, text.data(), text.size());
+    if (m_blobSizes.find(blob) == m_blobSizes.end()) {
+        // Written to a temp file and renamed like the clips, so a crash mid-write can't
+        // leave a cut-off blob under the real name. load() skips the .tmp names.
+        std::string path = blobPath(blob, Kind::Text);
+        std::string tempPath = path + ".tmp";
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(text.data(), (std::streamsize)text.size());
+        file.close();
+
+        std::error_code error;
+        if (!file.fail()) {
+            std::filesystem::rename(tempPath, path, error);
+        }
+        if (file.fail() || error) {
+            std::cerr << "ERROR: Could not write cached text to " << path << std::endl;
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+        m_blobSizes[blob] = text.size();
+    }
+    m_textBlobs[blob] = text;
+    addEntry(key, { Kind::Text, blob });
+}
+
+std::string GenerationCache::storeVoiceFile(uint64_t key, const std::string& sourcePath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+
+    std::string contents;
+    if (!readFile(sourcePath, contents)) {
+        std::cerr << "ERROR: Could not read generated clip " << sourcePath << std::endl;
+        return "";
+    }
+
+    uint64_t blob = hashBytes(FNV_OFFSET, contents.data(), contents.size());
+    std::string path = blobPath(blob, Kind::Voice);
+    std::error_code error;
+    if (m_blobSizes.find(blob) != m_blobSizes.end() && std::filesystem::exists(path, error)) {
+        // Already have these exact bytes
+        std::filesystem::remove(sourcePath, error);
+    }
+    else {
+        std::filesystem::rename(sourcePath, path, error);
+        if (error) {
+            // Different volume, fall back to copying
+            error.clear();
+            std::filesystem::copy_file(sourcePath, path, std::filesystem::copy_options::overwrite_existing, error);
+            if (error) {
+                std::cerr << "ERROR: Could not move " << sourcePath << " into the cache: " << error.message() << std::endl;
+                return "";
+            }
+            std::filesystem::remove(sourcePath, error);
+        }
+        m_blobSizes[blob] = contents.size();
+    }
+
+    addEntry(key, { Kind::Voice, blob });
+    return path;
+}
+
+void GenerationCache::invalidate(uint64_t key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+
+    if (m_entries.erase(key) == 0) return;
+    // The old "+" line and this "-" line are both dead now. The blob stays, other keys
+    // or saved responses may still point at it.
+    m_deadIndexLines += 2;
+    appendIndex("- " + toHex(key));
+}
+
+std::string GenerationCache::makeTempVoicePath(uint64_t key) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        load();
+    }
+    return m_directory + "/" + toHex(key) + "_" + std::to_string(m_tempCounter++) + ".tmp";
+}
+
+size_t GenerationCache::getEntryCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+    return m_entries.size();
+}
+
+size_t GenerationCache::getBlobCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+    return m_blobSizes.size();
+}
+
+uint64_t GenerationCache::getBlobBytes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+    uint64_t total = 0;
+    for (const auto& pair : m_blobSizes) {
+        total += pair.second;
+    }
+    return total;
+}
+
+void GenerationCache::load() {
+    if (m_loaded) return;
+    m_loaded = true;
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory + "/blobs", error);
+    if (error) {
+        std::cerr << "ERROR: Could not create cache directory " << m_directory << ": " << error.message() << std::endl;
+        return;
+    }
+
+    // Blobs are named <content hash>.txt / .mp3
+    for (const auto& file : std::filesystem::directory_iterator(m_directory + "/blobs", error)) {
+        uint64_t blob = 0;
+        if (!file.is_regular_file() || !fromHex(file.path().stem().string(), blob)) continue;
+        m_blobSizes[blob] = (uint64_t)file.file_size(error);
+    }
+
+    std::ifstream index(m_directory + "/index.txt");
+    std::string line;
+    while (std::getline(index, line)) {
+        std::istringstream stream(line);
+        std::string op, keyText, kindText, blobText;
+        uint64_t key = 0;
+        stream >> op >> keyText;
+        if (!fromHex(keyText, key)) {
+            m_deadIndexLines++;
+            continue;
+        }
+
+        if (op == "-") {
+            if (m_entries.erase(key) > 0) m_deadIndexLines++;
+            m_deadIndexLines++;
+            continue;
+        }
+
+        uint64_t blob = 0;
+        stream >> kindText >> blobText;
+        if (op != "+" || kindText.size() != 1 || (kindText[0] != 't' && kindText[0] != 'v') || !fromHex(blobText, blob)) {
+            m_deadIndexLines++;
+            continue;
+        }
+        if (m_entries.find(key) != m_entries.end()) m_deadIndexLines++;
+        m_entries[key] = { (Kind)kindText[0], blob };
+    }
+
+    // Drop entries whose blob was deleted by hand
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (m_blobSizes.find(it->second.blob) == m_blobSizes.end()) {
+            it = m_entries.erase(it);
+            m_deadIndexLines++;
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (m_deadIndexLines > 64 && m_deadIndexLines > m_entries.size()) {
+        compactIndex();
+    }
+}
+
+void GenerationCache::appendIndex(const std::string& line) {
+    std::ofstream index(m_directory + "/index.txt", std::ios::app);
+    index << line << '\n';
+
+    if (m_deadIndexLines > 64 && m_deadIndexLines > m_entries.size()) {
+        index.close();
+        compactIndex();
+    }
+}
+
+void GenerationCache::compactIndex() {
+    std::string tempPath = m_directory + "/index.txt.tmp";
+    {
+        std::ofstream index(tempPath, std::ios::trunc);
+        if (!index) return;
+        for (const auto& pair : m_entries) {
+            index << "+ " << toHex(pair.first) << ' ' << (char)pair.second.kind << ' ' << toHex(pair.second.blob) << '\n';
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, m_directory + "/index.txt", error);
+    if (!error) {
+        m_deadIndexLines = 0;
+    }
+}
+
+std::string GenerationCache::blobPath(uint64_t blob, Kind kind) const {
+    return m_directory + "/blobs/" + toHex(blob) + (kind == Kind::Text ? ".txt" : ".mp3");
+}
+
+void GenerationCache::addEntry(uint64_t key, const Entry& entry) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        if (it->second.kind == entry.kind && it->second.blob == entry.blob) return;
+        m_deadIndexLines++;
+    }
+    m_entries[key] = entry;
+
+    std::string line = "+ " + toHex(key) + ' ' + (char)entry.kind + ' ' + toHex(entry.blob);
+    appendIndex(line);
+}
@@ -0,0 +1,68 @@
+//GenerationCache.h
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// ==========================================================
+// Generated text / voice cache
+// ==========================================================
+//
+// Every generation request is keyed by a hash of what would be sent to the API (the
+// prompt, or the line plus voice id) and the model. A key points at a blob named after
+// the hash of its contents, so the same text or clip reached from different responses
+// is only stored once. The index is an append-only text file replayed on load; it gets
+// rewritten when it has collected more dead lines than live ones.
+
+class GenerationCache {
+public:
+    explicit GenerationCache(const std::string& directory = "Audio/Dialogue/Cache");
+
+    static uint64_t makeTextKey(const std::string& prompt, const std::string& model);
+    static uint64_t makeVoiceKey(const std::string& text, const std::string& voiceId, const std::string& model);
+
+    bool findText(uint64_t key, std::string& text);
+    // Path of the cached clip, empty on a miss or if the blob has gone missing
+    std::string findVoice(uint64_t key);
+
+    void storeText(uint64_t key, const std::string& text);
+    // Moves the clip into the blob store and returns its new path, empty on failure
+    std::string storeVoiceFile(uint64_t key, const std::string& sourcePath);
+    // Forgets a key so the next request for it goes out again
+    void invalidate(uint64_t key);
+
+    // Somewhere unique to write a new clip before handing it to storeVoiceFile
+    std::string makeTempVoicePath(uint64_t key);
+
+    size_t getEntryCount();
+    size_t getBlobCount();
+    uint64_t getBlobBytes();
+
+private:
+    enum class Kind : char { Text = 't', Voice = 'v' };
+
+    struct Entry {
+        Kind kind;
+        uint64_t blob;
+    };
+
+    // All called with m_mutex held
+    void load();
+    void appendIndex(const std::string& line);
+    void compactIndex();
+    std::string blobPath(uint64_t blob, Kind kind) const;
+    void addEntry(uint64_t key, const Entry& entry);
+
+    std::string m_directory;
+    std::mutex m_mutex;
+    bool m_loaded = false;
+    size_t m_deadIndexLines = 0;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::unordered_map<uint64_t, uint64_t> m_blobSizes; // Blob hash -> bytes on disk
+    std::unordered_map<uint64_t, std::string> m_textBlobs; // Text blobs read so far
+    std::atomic<uint32_t> m_tempCounter{ 0 };
+};
@@ -0,0 +1,703 @@
+//GenerationQueue.cpp
+
+#include "GenerationQueue.h"
+#include <algorithm>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <random>
+
+#if __has_include(<curl/curl.h>)
+#include <curl/curl.h>
+#define DIALOGUE_HAS_CURL 1
+#else
+#define DIALOGUE_HAS_CURL 0
+#endif
+
+namespace {
+    // Whether a job goes to the real API. Everything else gets a mock result, which
+    // must never end up in the cache.
+    bool usesHttp(const std::string& apiKey) {
+        return DIALOGUE_HAS_CURL && !apiKey.empty();
+    }
+
+    std::string escapeJson(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size() + 16);
+        for (char c : text) {
+            switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                }
+                else {
+                    escaped += c;
+                }
+                break;
+            }
+        }
+        return escaped;
+    }
+
+    void appendUtf8(std::string& out, unsigned int codePoint) {
+        if (codePoint < 0x80) {
+            out += (char)codePoint;
+        }
+        else if (codePoint < 0x800) {
+            out += (char)(0xC0 | (codePoint >> 6));
+            out += (char)(0x80 | (codePoint & 0x3F));
+        }
+        else {
+            out += (char)(0xE0 | (codePoint >> 12));
+            out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            out += (char)(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    // Pulls the first string value for "key" out of a JSON body. Good enough for the
+    // chat completion reply, where the text is the first "content" field.
+    bool extractJsonString(const std::string& json, const char* key, std::string& value) {
+        std::string pattern = std::string("\"") + key + "\"";
+        size_t pos = json.find(pattern);
+        if (pos == std::string::npos) return false;
+        pos = json.find(':', pos + pattern.size());
+        if (pos == std::string::npos) return false;
+        pos = json.find_first_not_of(" \t\r\n", pos + 1);
+        if (pos == std::string::npos || json[pos] != '"') return false;
+
+        value.clear();
+        for (pos++; pos < json.size(); pos++) {
+            char c = json[pos];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\' || pos + 1 >= json.size()) {
+                value += c;
+                continue;
+            }
+            char e = json[++pos];
+            switch (e) {
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'u':
+                if (pos + 4 < json.size()) {
+                    appendUtf8(value, (unsigned int)std::stoul(json.substr(pos + 1, 4), nullptr, 16));
+                    pos += 4;
+                }
+                break;
+            default: value += e; break;
+            }
+        }
+        return false;
+    }
+
+#if DIALOGUE_HAS_CURL
+    size_t writeToString(char* data, size_t size, size_t count, void* userData) {
+        static_cast<std::string*>(userData)->append(data, size * count);
+        return size * count;
+    }
+
+    size_t writeToFile(char* data, size_t size, size_t count, void* userData) {
+        return fwrite(data, size, count, static_cast<FILE*>(userData)) * size;
+    }
+#endif
+}
+
+struct GenerationQueue::Transfer {
+    Job job;
+    bool cancelled = false;
+
+    // Mock path
+    bool local = false;
+    std::future<std::pair<bool, std::string>> localResult;
+
+    // HTTP path
+    void* easy = nullptr;    // CURL*
+    void* headers = nullptr; // curl_slist*
+    std::string body;
+    std::string response;
+    std::string tempPath;
+    FILE* audioFile = nullptr;
+};
+
+GenerationQueue::GenerationQueue(DialogueManager* manager) :
+    m_manager(manager) {
+#if DIALOGUE_HAS_CURL
+    // Not thread-safe, so do it here on the thread that owns the queue. The multi
+    // handle outlives the worker so cancelAll() can always wake it.
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    m_multi = curl_multi_init();
+#endif
+    m_lastRefill = Clock::now();
+    m_tokens = m_settings.burstSize;
+    m_worker = std::thread(&GenerationQueue::workerLoop, this);
+}
+
+GenerationQueue::~GenerationQueue() {
+    cancelAll();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+#if DIALOGUE_HAS_CURL
+    curl_multi_wakeup(static_cast<CURLM*>(m_multi));
+#endif
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+#if DIALOGUE_HAS_CURL
+    for (void* easy : m_idleEasyHandles) {
+        curl_easy_cleanup(static_cast<CURL*>(easy));
+    }
+    m_idleEasyHandles.clear();
+    curl_multi_cleanup(static_cast<CURLM*>(m_multi));
+    m_multi = nullptr;
+    curl_global_cleanup();
+#endif
+}
+
+void GenerationQueue::setSettings(const GenerationSettings& settings) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_settings = settings;
+    m_settings.maxInFlight = std::max(1, m_settings.maxInFlight);
+    m_settings.burstSize = std::max(1, m_settings.burstSize);
+}
+
+GenerationSettings GenerationQueue::getSettings() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_settings;
+}
+
+void GenerationQueue::enqueue(const GenerationRequest& request) {
+    Job job;
+    job.request = request;
+    bool isText = request.kind == GenerationRequest::Kind::Text;
+    if (isText) {
+        job.apiKey = m_manager->m_gptApiKey;
+        job.prompt = m_manager->getPromptForPersonality(request.type, request.personality, request.inputText);
+    }
+    else {
+        job.apiKey = m_manager->m_elevenLabsApiKey;
+        job.voiceId = m_manager->getVoiceIdFromType(request.voice);
+    }
+
+    GenerationSettings settings = getSettings();
+    job.cacheKey = isText ? GenerationCache::makeTextKey(job.prompt, settings.textModel) :
+        GenerationCache::makeVoiceKey(request.inputText, job.voiceId, settings.voiceModel);
+    job.cacheable = usesHttp(job.apiKey);
+
+    // Look in the cache before anything can go out
+    Result cachedResult;
+    bool cacheHit = false;
+    if (job.cacheable) {
+        if (request.forceRefresh) {
+            m_cache.invalidate(job.cacheKey);
+        }
+        else if (isText) {
+            cacheHit = m_cache.findText(job.cacheKey, cachedResult.text);
+        }
+        else {
+            cachedResult.request.outputPath = m_cache.findVoice(job.cacheKey);
+            cacheHit = !cachedResult.request.outputPath.empty();
+        }
+    }
+    if (!isText && !cacheHit) {
+        // Real clips download next to the cache and move in once they're done, mock ones
+        // go where the manager would have put them
+        job.request.outputPath = job.cacheable ? m_cache.makeTempVoicePath(job.cacheKey) :
+            m_manager->buildAudioFilePath(request.type, request.personality, request.voice);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.empty() && m_delayed.empty() && m_progress.inFlight == 0 && m_waiting.empty() && m_results.empty()) {
+            // New batch, start the counters over
+            m_progress = GenerationProgress();
+        }
+        m_progress.total++;
+
+        if (cacheHit) {
+            std::string outputPath = cachedResult.request.outputPath;
+            cachedResult.request = request;
+            cachedResult.request.outputPath = outputPath;
+            cachedResult.fromCache = true;
+            cachedResult.success = true;
+            m_results.push_back(std::move(cachedResult));
+            m_progress.completed++;
+            m_progress.cached++;
+            return;
+        }
+
+        if (job.cacheable) {
+            // Same request already queued or in flight, share its result. A forced refresh
+            // goes out on its own instead, the point of it is a new answer.
+            auto waiting = m_waiting.find(job.cacheKey);
+            if (waiting == m_waiting.end()) {
+                m_waiting[job.cacheKey];
+                job.shared = true;
+            }
+            else if (!request.forceRefresh) {
+                waiting->second.push_back(request);
+                return;
+            }
+        }
+
+        job.notBefore = Clock::now();
+        m_queue.push_back(std::move(job));
+    }
+    m_wake.notify_all();
+}
+
+void GenerationQueue::cancelAll() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Dropped jobs come out of the total so the progress bar can still finish.
+        // In-flight ones are taken out when the worker aborts them.
+        int dropped = (int)(m_queue.size() + m_delayed.size());
+        for (const auto& waiting : m_waiting) {
+            dropped += (int)waiting.second.size();
+        }
+        m_progress.total -= dropped;
+        m_queue.clear();
+        m_delayed.clear();
+        m_waiting.clear();
+        m_cancelRequested = true;
+    }
+    m_wake.notify_all();
+#if DIALOGUE_HAS_CURL
+    curl_multi_wakeup(static_cast<CURLM*>(m_multi));
+#endif
+}
+
+int GenerationQueue::applyResults() {
+    std::vector<Result> results;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.swap(m_results);
+    }
+
+    int applied = 0;
+    std::vector<GenerationRequest> followers;
+    for (Result& result : results) {
+        const GenerationRequest& request = result.request;
+        bool isText = request.kind == GenerationRequest::Kind::Text;
+
+        // Keep new results for next time, but only ones that came back from the API
+        bool storeFailed = false;
+        if (result.success && result.cacheable && !result.fromCache) {
+            if (isText) {
+                m_cache.storeText(result.cacheKey, result.text);
+            }
+            else {
+                std::string cachedPath = m_cache.storeVoiceFile(result.cacheKey, request.outputPath);
+                if (cachedPath.empty()) {
+                    storeFailed = true;
+                    result.success = false;
+                    result.error = "could not store clip in the cache";
+                }
+                else {
+                    result.request.outputPath = cachedPath;
+                }
+            }
+        }
+
+        followers.clear();
+        if (storeFailed || result.shared) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto waiting = result.shared ? m_waiting.find(result.cacheKey) : m_waiting.end();
+            if (waiting != m_waiting.end()) {
+                followers.swap(waiting->second);
+                m_waiting.erase(waiting);
+            }
+            if (result.success) {
+                m_progress.completed += (int)followers.size();
+                m_progress.cached += (int)followers.size();
+            }
+            else {
+                // The worker already counted this one as completed
+                if (storeFailed) {
+                    m_progress.completed--;
+                    m_progress.failed++;
+                }
+                m_progress.failed += (int)followers.size();
+            }
+        }
+        followers.push_back(request);
+
+        for (const GenerationRequest& target : followers) {
+            if (!result.success) {
+                std::cerr << "Generation failed for " << m_manager->getResponseTypeName(target.type)
+                    << " / " << m_manager->getPersonalityName(target.personality) << ": " << result.error << std::endl;
+                continue;
+            }
+
+            auto response = m_manager->getResponse(target.type);
+            if (!response) continue;
+
+            if (isText) {
+                // Someone hand-edited it while the request was out, keep their version
+                if (response->isTextEdited(target.personality) && !target.forceRefresh) continue;
+                response->setTextForPersonality(target.personality, result.text, false);
+            }
+            else {
+                response->setVoiceFilePath(target.personality, target.voice, result.request.outputPath);
+            }
+            m_manager->markResponsesChanged();
+            applied++;
+        }
+    }
+    return applied;
+}
+
+GenerationProgress GenerationQueue::getProgress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    GenerationProgress progress = m_progress;
+    progress.queued = (int)(m_queue.size() + m_delayed.size());
+    return progress;
+}
+
+bool GenerationQueue::isBusy() const {
+    GenerationProgress progress = getProgress();
+    return progress.queued > 0 || progress.inFlight > 0;
+}
+
+bool GenerationQueue::takeToken(Clock::time_point now) {
+    double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+    m_lastRefill = now;
+    m_tokens = std::min((double)m_settings.burstSize, m_tokens + elapsed * m_settings.requestsPerSecond);
+    if (m_tokens < 1.0) {
+        return false;
+    }
+    m_tokens -= 1.0;
+    return true;
+}
+
+void GenerationQueue::workerLoop() {
+    std::vector<Job> toStart;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_running) break;
+
+            if (m_cancelRequested.exchange(false)) {
+                abortTransfers();
+            }
+
+            // Jobs whose backoff has passed go back to the front of the line
+            Clock::time_point now = Clock::now();
+            for (size_t i = 0; i < m_delayed.size();) {
+                if (m_delayed[i].notBefore <= now) {
+                    m_queue.push_front(std::move(m_delayed[i]));
+                    m_delayed[i] = std::move(m_delayed.back());
+                    m_delayed.pop_back();
+                }
+                else {
+                    i++;
+                }
+            }
+
+            while (!m_queue.empty() && (int)(m_transfers.size() + toStart.size()) < m_settings.maxInFlight && takeToken(now)) {
+                toStart.push_back(std::move(m_queue.front()));
+                m_queue.pop_front();
+            }
+
+            if (toStart.empty() && m_transfers.empty()) {
+                if (m_queue.empty() && m_delayed.empty()) {
+                    m_wake.wait(lock);
+                }
+                else {
+                    // Waiting on the token bucket or a backoff
+                    m_wake.wait_for(lock, std::chrono::milliseconds(20));
+                }
+                continue;
+            }
+            m_progress.inFlight += (int)toStart.size();
+        }
+
+        for (Job& job : toStart) {
+            startTransfer(std::move(job));
+        }
+        toStart.clear();
+
+        pumpCurlTransfers(20);
+        pumpLocalTransfers();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        abortTransfers();
+    }
+    // Any mock calls still running are waited on when their futures go away
+    m_transfers.clear();
+}
+
+void GenerationQueue::startTransfer(Job&& job) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->job = std::move(job);
+    const GenerationRequest& request = transfer->job.request;
+    bool isText = request.kind == GenerationRequest::Kind::Text;
+
+    const std::string& apiKey = transfer->job.apiKey;
+    GenerationSettings settings = getSettings();
+
+    if (!usesHttp(apiKey)) {
+        // Same mock behaviour as calling the manager directly, but built only from what
+        // the job captured on the UI thread, so setAPIKeys can't race with it
+        const Job& captured = transfer->job;
+        transfer->local = true;
+        transfer->localResult = std::async(std::launch::async, [captured]() {
+            const GenerationRequest& copy = captured.request;
+            if (copy.kind == GenerationRequest::Kind::Text) {
+                return std::make_pair(true, DialogueManager::makeMockText(copy.personality, copy.inputText, !captured.apiKey.empty()));
+            }
+            if (captured.apiKey.empty()) {
+                return std::make_pair(false, std::string("no ElevenLabs API key set"));
+            }
+            if (captured.voiceId.empty()) {
+                return std::make_pair(false, std::string("invalid voice type"));
+            }
+            bool ok = DialogueManager::writeMockVoiceFile(copy.inputText, copy.outputPath);
+            return std::make_pair(ok, std::string(ok ? "" : "voice generation failed"));
+        });
+        m_transfers.push_back(std::move(transfer));
+        return;
+    }
+
+#if DIALOGUE_HAS_CURL
+    CURL* easy = nullptr;
+    if (!m_idleEasyHandles.empty()) {
+        // Reset keeps the handle's open connections and DNS cache
+        easy = static_cast<CURL*>(m_idleEasyHandles.back());
+        m_idleEasyHandles.pop_back();
+        curl_easy_reset(easy);
+    }
+    else {
+        easy = curl_easy_init();
+    }
+    transfer->easy = easy;
+
+    curl_slist* headers = curl_slist_append(nullptr, "Content-Type: application/json");
+    std::string url;
+    if (isText) {
+        url = settings.textEndpoint;
+        headers = curl_slist_append(headers, ("Authorization: Bearer " + apiKey).c_str());
+        transfer->body = "{\"model\":\"" + escapeJson(settings.textModel) +
+            "\",\"max_tokens\":120,\"messages\":[{\"role\":\"user\",\"content\":\"" + escapeJson(transfer->job.prompt) + "\"}]}";
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeToString);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response);
+    }
+    else {
+        url = settings.voiceEndpoint + transfer->job.voiceId;
+        headers = curl_slist_append(headers, ("xi-api-key: " + apiKey).c_str());
+        headers = curl_slist_append(headers, "Accept: audio/mpeg");
+        transfer->body = "{\"text\":\"" + escapeJson(request.inputText) +
+            "\",\"model_id\":\"" + escapeJson(settings.voiceModel) + "\"}";
+
+        // Written next to the target and renamed on success so a failed or cancelled
+        // request never leaves a half-written clip behind
+        transfer->tempPath = request.outputPath + ".part";
+        transfer->audioFile = fopen(transfer->tempPath.c_str(), "wb");
+        if (!transfer->audioFile) {
+            curl_slist_free_all(headers);
+            m_transfers.push_back(std::move(transfer));
+            finishTransfer(*m_transfers.back(), false, false, "", "could not open " + request.outputPath + ".part");
+            m_transfers.pop_back();
+            return;
+        }
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeToFile);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer->audioFile);
+    }
+    transfer->headers = headers;
+
+    curl_easy_setopt(easy, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->body.c_str());
+    curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, (long)transfer->body.size());
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT, settings.timeoutSeconds);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer.get());
+
+    CURLM* multi = static_cast<CURLM*>(m_multi);
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)settings.maxInFlight);
+    curl_multi_add_handle(multi, easy);
+    m_transfers.push_back(std::move(transfer));
+#endif
+}
+
+void GenerationQueue::finishTransfer(Transfer& transfer, bool success, bool retryable,
+    const std::string& text, const std::string& error) {
+
+    if (transfer.audioFile) {
+        fclose(transfer.audioFile);
+        transfer.audioFile = nullptr;
+    }
+    if (!transfer.tempPath.empty()) {
+        if (success) {
+            std::remove(transfer.job.request.outputPath.c_str());
+            success = std::rename(transfer.tempPath.c_str(), transfer.job.request.outputPath.c_str()) == 0;
+        }
+        if (!success) {
+            std::remove(transfer.tempPath.c_str());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_progress.inFlight--;
+    if (transfer.cancelled) {
+        m_progress.total--;
+        return;
+    }
+
+    if (!success && retryable && transfer.job.attempt < m_settings.maxRetries) {
+        // Exponential backoff with jitter so a burst of 429s doesn't come back in lockstep
+        static thread_local std::mt19937 rng(std::random_device{}());
+        double backoff = std::min(m_settings.maxBackoffSeconds,
+            m_settings.baseBackoffSeconds * (double)(1 << std::min(transfer.job.attempt, 16)));
+        backoff *= std::uniform_real_distribution<double>(0.5, 1.0)(rng);
+
+        Job retry = transfer.job;
+        retry.attempt++;
+        retry.notBefore = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(backoff));
+        m_delayed.push_back(std::move(retry));
+        m_progress.retries++;
+        return;
+    }
+
+    Result result;
+    result.request = transfer.job.request;
+    result.cacheKey = transfer.job.cacheKey;
+    result.cacheable = transfer.job.cacheable;
+    result.shared = transfer.job.shared;
+    result.success = success;
+    result.text = text;
+    result.error = error;
+    m_results.push_back(std::move(result));
+    if (success) {
+        m_progress.completed++;
+    }
+    else {
+        m_progress.failed++;
+    }
+}
+
+void GenerationQueue::pumpLocalTransfers() {
+    bool anyLocal = false;
+    for (size_t i = 0; i < m_transfers.size();) {
+        Transfer& transfer = *m_transfers[i];
+        if (!transfer.local) {
+            i++;
+            continue;
+        }
+        anyLocal = true;
+        if (transfer.localResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            i++;
+            continue;
+        }
+        auto result = transfer.localResult.get();
+        finishTransfer(transfer, result.first, false, result.first ? result.second : "", result.first ? "" : result.second);
+        m_transfers.erase(m_transfers.begin() + i);
+    }
+
+#if !DIALOGUE_HAS_CURL
+    if (anyLocal) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+#else
+    (void)anyLocal;
+#endif
+}
+
+void GenerationQueue::pumpCurlTransfers(int waitMs) {
+#if DIALOGUE_HAS_CURL
+    CURLM* multi = static_cast<CURLM*>(m_multi);
+    int running = 0;
+    curl_multi_perform(multi, &running);
+    // Wakes up early on socket activity, cancelAll() or the destructor
+    curl_multi_poll(multi, nullptr, 0, waitMs, nullptr);
+    curl_multi_perform(multi, &running);
+
+    int remaining = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi, &remaining)) {
+        if (message->msg != CURLMSG_DONE) continue;
+
+        CURL* easy = message->easy_handle;
+        Transfer* transfer = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, reinterpret_cast<char**>(&transfer));
+        long status = 0;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &status);
+        CURLcode code = message->data.result;
+
+        curl_multi_remove_handle(multi, easy);
+        curl_slist_free_all(static_cast<curl_slist*>(transfer->headers));
+        transfer->headers = nullptr;
+        m_idleEasyHandles.push_back(easy);
+
+        bool success = code == CURLE_OK && status >= 200 && status < 300;
+        // Network errors, rate limiting and server errors are worth another try
+        bool retryable = code != CURLE_OK || status == 429 || status >= 500;
+        std::string text;
+        std::string error;
+        if (code != CURLE_OK) {
+            error = curl_easy_strerror(code);
+        }
+        else if (!success) {
+            error = "HTTP " + std::to_string(status);
+        }
+        else if (transfer->job.request.kind == GenerationRequest::Kind::Text &&
+            !extractJsonString(transfer->response, "content", text)) {
+            success = false;
+            error = "no content in reply";
+        }
+
+        finishTransfer(*transfer, success, retryable, text, error);
+        for (size_t i = 0; i < m_transfers.size(); i++) {
+            if (m_transfers[i].get() == transfer) {
+                m_transfers.erase(m_transfers.begin() + i);
+                break;
+            }
+        }
+    }
+#else
+    (void)waitMs;
+#endif
+}
+
+void GenerationQueue::abortTransfers() {
+    // Called with m_mutex held from the worker, so only touch worker-owned state and
+    // the progress counters directly
+    for (size_t i = 0; i < m_transfers.size();) {
+        Transfer& transfer = *m_transfers[i];
+        if (transfer.local) {
+            // Can't interrupt a mock call, just throw its result away when it lands
+            transfer.cancelled = true;
+            i++;
+            continue;
+        }
+
+#if DIALOGUE_HAS_CURL
+        CURL* easy = static_cast<CURL*>(transfer.easy);
+        curl_multi_remove_handle(static_cast<CURLM*>(m_multi), easy);
+        curl_slist_free_all(static_cast<curl_slist*>(transfer.headers));
+        m_idleEasyHandles.push_back(easy);
+#endif
+        if (transfer.audioFile) {
+            fclose(transfer.audioFile);
+            std::remove(transfer.tempPath.c_str());
+        }
+        m_progress.inFlight--;
+        m_progress.total--;
+        m_transfers.erase(m_transfers.begin() + i);
+    }
+}
@@ -0,0 +1,155 @@
+//GenerationQueue.h
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "DialogueSystem.h"
+#include "GenerationCache.h"
+
+// ==========================================================
+// Batch text / voice generation
+// ==========================================================
+//
+// One background thread drives every request. With libcurl available it runs up to
+// maxInFlight HTTP transfers at once on a curl multi handle, reusing easy handles
+// so connections stay alive between requests. Without curl, or without an API key,
+// it runs the DialogueManager mock calls instead, with the same concurrency limit.
+// Requests are spread out with a token bucket and failed ones retry with
+// exponential backoff. Results are only applied to DialogueResponse objects from
+// applyResults() on the UI thread.
+//
+// Requests that would hit the API are looked up in a GenerationCache first, and a
+// request identical to one already in flight waits for that one instead of going out.
+
+struct GenerationSettings {
+    int maxInFlight = 8;
+    // Token bucket: sustained requests per second and how many can go at once
+    double requestsPerSecond = 5.0;
+    int burstSize = 10;
+    int maxRetries = 4;
+    double baseBackoffSeconds = 0.5;
+    double maxBackoffSeconds = 30.0;
+    long timeoutSeconds = 60;
+    // Point these at a local server to test without touching the real APIs
+    std::string textEndpoint = "https://api.openai.com/v1/chat/completions";
+    std::string textModel = "gpt-4o-mini";
+    std::string voiceEndpoint = "https://api.elevenlabs.io/v1/text-to-speech/";
+    std::string voiceModel = "eleven_multilingual_v2";
+};
+
+struct GenerationRequest {
+    enum class Kind { Text, Voice };
+
+    Kind kind = Kind::Text;
+    ResponseType type = ResponseType::EnthusiasticAffirmative;
+    PersonalityType personality = PersonalityType::Bubbly;
+    VoiceType voice = VoiceType::Male1;
+    std::string inputText;  // Base text for text jobs, line to speak for voice jobs
+    std::string outputPath; // Voice jobs, filled in by the queue
+    // Skip the cache and ask again, even if an identical request is already in flight.
+    // Text from a forced request also replaces hand edits.
+    bool forceRefresh = false;
+};
+
+struct GenerationProgress {
+    int queued = 0;
+    int inFlight = 0;
+    int completed = 0;
+    int failed = 0;
+    int retries = 0;
+    int cached = 0; // Served from the cache or shared with an identical request
+    int total = 0;
+};
+
+class GenerationQueue {
+public:
+    GenerationQueue(DialogueManager* manager);
+    ~GenerationQueue();
+
+    void setSettings(const GenerationSettings& settings);
+    GenerationSettings getSettings() const;
+
+    void enqueue(const GenerationRequest& request);
+    // Drops everything queued and aborts whatever is in flight
+    void cancelAll();
+
+    // Call on the UI thread, writes finished text and voice paths into the responses.
+    // Returns how many results were applied.
+    int applyResults();
+
+    GenerationProgress getProgress() const;
+    bool isBusy() const;
+
+    GenerationCache& getCache() { return m_cache; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        GenerationRequest request;
+        // Captured on the UI thread at enqueue time so the worker never reads the manager
+        std::string apiKey;
+        std::string prompt;
+        std::string voiceId;
+        uint64_t cacheKey = 0;
+        bool cacheable = false; // Only real API results go in the cache, not mock ones
+        bool shared = false;    // Owns the m_waiting entry for its key
+        int attempt = 0;
+        Clock::time_point notBefore;
+    };
+
+    struct Result {
+        GenerationRequest request;
+        uint64_t cacheKey = 0;
+        bool cacheable = false;
+        bool shared = false;
+        bool fromCache = false;
+        bool success = false;
+        std::string text;
+        std::string error;
+    };
+
+    struct Transfer; // One in-flight request, defined in the .cpp
+
+    void workerLoop();
+    bool takeToken(Clock::time_point now);
+    void startTransfer(Job&& job);
+    void finishTransfer(Transfer& transfer, bool success, bool retryable, const std::string& text, const std::string& error);
+    void pumpLocalTransfers();
+    void pumpCurlTransfers(int waitMs);
+    void abortTransfers();
+
+    DialogueManager* m_manager;
+    GenerationCache m_cache;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    GenerationSettings m_settings;
+    std::deque<Job> m_queue;
+    std::vector<Job> m_delayed; // Waiting out a backoff
+    std::vector<Result> m_results;
+    // Cache key of a cacheable job queued or in flight -> identical requests waiting on
+    // its result. A forced refresh only gets an entry if no other job has one.
+    std::unordered_map<uint64_t, std::vector<GenerationRequest>> m_waiting;
+    GenerationProgress m_progress;
+    std::atomic<bool> m_cancelRequested{ false };
+    bool m_running = true;
+
+    // Worker thread only
+    std::vector<std::unique_ptr<Transfer>> m_transfers;
+    double m_tokens = 0.0;
+    Clock::time_point m_lastRefill;
+    void* m_multi = nullptr;              // CURLM*, created and destroyed by the owner
+    std::vector<void*> m_idleEasyHandles; // CURL*, kept for connection reuse
+
+    std::thread m_worker;
+};
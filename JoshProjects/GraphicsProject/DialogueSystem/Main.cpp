@@ -1,8 +1,15 @@
 // Main.cpp
 #include "DialogueApp.h"
+#include "Benchmark.h"
+#include <cstring>
 #include <iostream>
 
 int main(int argc, char** argv) {
+    // "--benchmark" times project saves and loads headless instead of opening the editor
+    if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0) {
+        return runBenchmark(argc - 2, argv + 2);
+    }
+
     std::cout << "Main function starting\n";
 
     // Disable fullscreen before creating app
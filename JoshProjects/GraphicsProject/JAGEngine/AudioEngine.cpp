@@ -2,22 +2,20 @@
 
 #include "AudioEngine.h"
 #include "JAGErrors.h"
+#include <iostream>
 
 namespace JAGEngine {
 
-  int SoundEffect::nextChannel = 0; // not used for wwise
-  int SoundEffect::totalChannels = 8; // not used for wwise
-
   void SoundEffect::play(int loops /* = 0 */) {
-    if (Mix_PlayChannel(-1, m_chunk, loops) == -1) {
-      if (Mix_PlayChannel(nextChannel, m_chunk, loops) == -1) {
-        fatalError("Mix_PlayChannel error: " + std::string(Mix_GetError()));
-      }
-      // Move to the next channel
-      nextChannel = (nextChannel + 1) % totalChannels;
+    if (m_engine) {
+      m_engine->playSound(m_id, loops);
     }
   }
 
+  bool SoundEffect::isLoaded() const {
+    return m_engine && m_engine->m_sounds[m_id]->chunk.load(std::memory_order_acquire) != nullptr;
+  }
+
   void Music::play(int loops /* = -1 */) {
     Mix_PlayMusic(m_music, loops);
   }
@@ -40,6 +38,8 @@ AudioEngine::AudioEngine() {
 
 AudioEngine::~AudioEngine() {
   destroy();
+  // Banks can be queued before init()
+  stopLoader();
 }
 
 void AudioEngine::init() {
@@ -59,23 +59,30 @@ void AudioEngine::init() {
 }
 
 void AudioEngine::setChannels(int channels) {
-  SoundEffect::totalChannels = Mix_AllocateChannels(channels);
-  SoundEffect::nextChannel = 0;
+  m_voices.assign(Mix_AllocateChannels(channels), Voice());
 }
 
 void AudioEngine::destroy() {
   if (m_isInitialized) {
     m_isInitialized = false;
 
-    for (auto& it : m_effectMap) {
-      Mix_FreeChunk(it.second);
+    stopLoader();
+    Mix_HaltChannel(-1);
+
+    for (auto& sound : m_sounds) {
+      Mix_Chunk* chunk = sound->chunk.load();
+      if (chunk) {
+        Mix_FreeChunk(chunk);
+      }
     }
 
     for (auto& it : m_musicMap) {
       Mix_FreeMusic(it.second);
     }
 
-    m_effectMap.clear();
+    m_sounds.clear();
+    m_soundIds.clear();
+    m_voices.clear();
     m_musicMap.clear();
 
     Mix_CloseAudio();
@@ -84,26 +91,198 @@ void AudioEngine::destroy() {
 }
 
 SoundEffect AudioEngine::loadSoundEffect(const std::string& filePath) {
-  auto it = m_effectMap.find(filePath);
+  auto it = m_soundIds.find(filePath);
+  if (it != m_soundIds.end()) {
+    //its already cached, or queued in a bank
+    return makeHandle(it->second);
+  }
+
+  Mix_Chunk* chunk = Mix_LoadWAV(filePath.c_str());
+  if (chunk == nullptr) {
+    fatalError("Mix_LoadWAV error: " + std::string(Mix_GetError()));
+  }
+
+  SoundEffectDesc desc;
+  desc.filePath = filePath;
+  int id = addSound(desc);
+  m_sounds[id]->chunk.store(chunk, std::memory_order_release);
+  return makeHandle(id);
+}
+
+std::vector<SoundEffect> AudioEngine::loadSoundBank(const std::vector<SoundEffectDesc>& sounds) {
+  std::vector<SoundEffect> effects;
+  effects.reserve(sounds.size());
+
+  std::vector<SoundSlot*> toLoad;
+  for (const auto& desc : sounds) {
+    auto it = m_soundIds.find(desc.filePath);
+    if (it != m_soundIds.end()) {
+      // Already known; the bank's settings win
+      SoundSlot& sound = *m_sounds[it->second];
+      sound.priority = desc.priority;
+      sound.maxInstances = desc.maxInstances;
+      effects.push_back(makeHandle(it->second));
+      continue;
+    }
+
+    int id = addSound(desc);
+    toLoad.push_back(m_sounds[id].get());
+    effects.push_back(makeHandle(id));
+  }
 
+  if (!toLoad.empty()) {
+    std::lock_guard<std::mutex> lock(m_loaderMutex);
+    if (!m_loaderThread.joinable()) {
+      m_stopLoader = false;
+      m_loaderThread = std::thread(&AudioEngine::loaderLoop, this);
+    }
+    m_pendingLoads += (int)toLoad.size();
+    m_loadQueue.insert(m_loadQueue.end(), toLoad.begin(), toLoad.end());
+  }
+  m_loaderCondition.notify_one();
+
+  return effects;
+}
+
+void AudioEngine::waitForSoundBanks() {
+  {
+    std::unique_lock<std::mutex> lock(m_loaderMutex);
+    m_loadedCondition.wait(lock, [this]() { return m_pendingLoads.load() == 0; });
+  }
+
+  // Same as a failed synchronous load
+  for (const auto& sound : m_sounds) {
+    if (sound->failed.load()) {
+      fatalError("Mix_LoadWAV error: could not load " + sound->filePath);
+    }
+  }
+}
+
+int AudioEngine::addSound(const SoundEffectDesc& desc) {
+  int id = (int)m_sounds.size();
+  auto sound = std::make_unique<SoundSlot>();
+  sound->filePath = desc.filePath;
+  sound->priority = desc.priority;
+  sound->maxInstances = desc.maxInstances;
+  m_sounds.push_back(std::move(sound));
+  m_soundIds[desc.filePath] = id;
+  return id;
+}
+
+SoundEffect AudioEngine::makeHandle(int id) {
   SoundEffect effect;
+  effect.m_engine = this;
+  effect.m_id = id;
+  return effect;
+}
 
-  if (it == m_effectMap.end()) {
-    Mix_Chunk* chunk = Mix_LoadWAV(filePath.c_str());
+void AudioEngine::loaderLoop() {
+  while (true) {
+    SoundSlot* sound = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_loaderMutex);
+      m_loaderCondition.wait(lock, [this]() { return m_stopLoader || !m_loadQueue.empty(); });
+      if (m_stopLoader) return;
+      sound = m_loadQueue.front();
+      m_loadQueue.pop_front();
+    }
+
+    // Decoding is the slow part and only reads the mixer's output format
+    Mix_Chunk* chunk = Mix_LoadWAV(sound->filePath.c_str());
     if (chunk == nullptr) {
-      fatalError("Mix_LoadWAV error: " + std::string(Mix_GetError()));
+      std::cout << "Mix_LoadWAV error: " << sound->filePath << ": " << Mix_GetError() << std::endl;
+      sound->failed.store(true);
     }
+    sound->chunk.store(chunk, std::memory_order_release);
 
-    effect.m_chunk = chunk;
-    m_effectMap[filePath] = chunk;
+    {
+      std::lock_guard<std::mutex> lock(m_loaderMutex);
+      m_pendingLoads--;
+    }
+    m_loadedCondition.notify_all();
+  }
+}
 
+void AudioEngine::stopLoader() {
+  {
+    std::lock_guard<std::mutex> lock(m_loaderMutex);
+    m_stopLoader = true;
+    m_loadQueue.clear();
   }
-  else {
-    //its already cached
-    effect.m_chunk = it->second;
+  m_loaderCondition.notify_all();
+  if (m_loaderThread.joinable()) {
+    m_loaderThread.join();
   }
+  m_pendingLoads = 0;
+  m_loadedCondition.notify_all();
+}
 
-  return effect;
+void AudioEngine::playSound(int id, int loops) {
+  if (id < 0 || id >= (int)m_sounds.size()) return;
+  SoundSlot& sound = *m_sounds[id];
+
+  // Still decoding (or failed): skip it rather than wait
+  Mix_Chunk* chunk = sound.chunk.load(std::memory_order_acquire);
+  if (chunk == nullptr) {
+    m_droppedPlays++;
+    return;
+  }
+
+  int channel = pickChannel(id, sound);
+  if (channel < 0) {
+    m_droppedPlays++;
+    return;
+  }
+
+  if (Mix_PlayChannel(channel, chunk, loops) == -1) {
+    fatalError("Mix_PlayChannel error: " + std::string(Mix_GetError()));
+  }
+
+  Voice& voice = m_voices[channel];
+  voice.soundId = id;
+  voice.priority = sound.priority;
+  voice.startOrder = m_playCounter++;
+}
+
+int AudioEngine::pickChannel(int id, const SoundSlot& sound) {
+  int freeChannel = -1;
+  int oldestSame = -1;
+  int instances = 0;
+  int victim = -1;
+
+  for (int channel = 0; channel < (int)m_voices.size(); channel++) {
+    const Voice& voice = m_voices[channel];
+    if (!Mix_Playing(channel)) {
+      if (freeChannel < 0) freeChannel = channel;
+      continue;
+    }
+
+    if (voice.soundId == id) {
+      instances++;
+      if (oldestSame < 0 || voice.startOrder < m_voices[oldestSame].startOrder) {
+        oldestSame = channel;
+      }
+    }
+
+    // Lowest priority, then oldest
+    if (victim < 0 || voice.priority < m_voices[victim].priority ||
+        (voice.priority == m_voices[victim].priority && voice.startOrder < m_voices[victim].startOrder)) {
+      victim = channel;
+    }
+  }
+
+  // At its limit: restart the oldest copy instead of stacking another
+  if (sound.maxInstances > 0 && instances >= sound.maxInstances) {
+    return oldestSame;
+  }
+  if (freeChannel >= 0) {
+    return freeChannel;
+  }
+  if (victim >= 0 && m_voices[victim].priority <= sound.priority) {
+    m_stolenVoices++;
+    return victim;
+  }
+  return -1;
 }
 
 Music AudioEngine::loadMusic(const std::string& filePath) {
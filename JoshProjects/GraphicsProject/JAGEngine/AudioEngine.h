@@ -1,19 +1,44 @@
 #pragma once
 
 #include <SDL/SDL_mixer.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <map>
 
 namespace JAGEngine {
 
+  class AudioEngine;
+
+  // Handle to a sound owned by the AudioEngine. Cheap to copy; playing it is an index
+  // into the engine's sound table, no lookups by name.
   class SoundEffect {
   public:
     friend class AudioEngine;
     void play(int loops = 0);
+    // False until the sound has finished decoding (or if it failed to)
+    bool isLoaded() const;
   private:
-    Mix_Chunk* m_chunk = nullptr;
-    static int nextChannel;
-    static int totalChannels;
+    AudioEngine* m_engine = nullptr;
+    int m_id = -1;
+  };
+
+  // One entry in a sound bank
+  struct SoundEffectDesc {
+    std::string filePath;
+    // When every channel is busy, a sound can take over a channel playing something of
+    // equal or lower priority. Lower-priority sounds are dropped instead.
+    int priority = 0;
+    // Most copies of this sound playing at once, 0 for no limit. Past the limit the
+    // oldest copy is restarted rather than taking another channel.
+    int maxInstances = 0;
   };
 
   class Music {
@@ -36,11 +61,64 @@ namespace JAGEngine {
     ~AudioEngine();
     void init();
     void destroy();
+    // Decodes on the calling thread if the sound isn't known yet. Prefer loadSoundBank
+    // during level load.
     SoundEffect loadSoundEffect(const std::string& filePath);
+    // Queues every sound for decoding on the loader thread and returns their handles
+    // straight away, in the same order. Playing one before it's decoded does nothing.
+    std::vector<SoundEffect> loadSoundBank(const std::vector<SoundEffectDesc>& sounds);
+    bool isLoadingSoundBanks() const { return m_pendingLoads.load() > 0; }
+    // Blocks until every queued sound is decoded
+    void waitForSoundBanks();
     Music loadMusic(const std::string& filePath);
     void setChannels(int channels); // New method to set the number of channels
+
+    // Voices taken from other sounds / plays dropped since init
+    int getStolenVoiceCount() const { return m_stolenVoices; }
+    int getDroppedPlayCount() const { return m_droppedPlays; }
+
   private:
-    std::map<std::string, Mix_Chunk*> m_effectMap;
+    friend class SoundEffect;
+
+    struct SoundSlot {
+      std::string filePath;
+      int priority = 0;
+      int maxInstances = 0;
+      // Written by the loader thread once decoding finishes
+      std::atomic<Mix_Chunk*> chunk{ nullptr };
+      std::atomic<bool> failed{ false };
+    };
+
+    // What each mixer channel was last asked to play
+    struct Voice {
+      int soundId = -1;
+      int priority = 0;
+      uint32_t startOrder = 0;
+    };
+
+    int addSound(const SoundEffectDesc& desc);
+    SoundEffect makeHandle(int id);
+    void playSound(int id, int loops);
+    int pickChannel(int id, const SoundSlot& sound);
+    void loaderLoop();
+    void stopLoader();
+
+    // Slots never move once created, the loader thread holds pointers to them
+    std::vector<std::unique_ptr<SoundSlot>> m_sounds;
+    std::unordered_map<std::string, int> m_soundIds;
+    std::vector<Voice> m_voices;
+    uint32_t m_playCounter = 0;
+    int m_stolenVoices = 0;
+    int m_droppedPlays = 0;
+
+    std::thread m_loaderThread;
+    std::mutex m_loaderMutex;
+    std::condition_variable m_loaderCondition;
+    std::condition_variable m_loadedCondition;
+    std::deque<SoundSlot*> m_loadQueue;
+    std::atomic<int> m_pendingLoads{ 0 };
+    bool m_stopLoader = false;
+
     std::map<std::string, Mix_Music*> m_musicMap;
     bool m_isInitialized = false;
   };
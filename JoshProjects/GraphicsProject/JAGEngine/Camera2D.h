@@ -24,6 +24,8 @@ namespace JAGEngine {
     glm::mat4 getCameraMatrix() const { return _cameraMatrix; }
     glm::mat4 getOrthoMatrix() const { return _orthoMatrix; }
     glm::vec2 getScreenDimensions() const { return glm::vec2(_screenWidth, _screenHeight); }
+    // World space size of the area the camera shows at the current scale
+    glm::vec2 getViewDimensions() const { return glm::vec2(_screenWidth, _screenHeight) * (ORTHO_SCALE / _scale); }
 
   private:
     static constexpr float MAX_WORLD_SIZE = 1000000.0f;  // Maximum world coordinates
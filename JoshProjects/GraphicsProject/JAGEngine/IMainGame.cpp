@@ -2,7 +2,11 @@
 
 #include "IMainGame.h"
 #include "Timing.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "Memory.h"
 #include <iostream>
+#include <algorithm>
 #include "ScreenList.h"
 #include "IGameScreen.h"
 
@@ -43,6 +47,8 @@ namespace JAGEngine {
       m_screenList.reset();
     }
 
+    JobSystem::getInstance().destroy();
+    Profiler::getInstance().destroy();
     m_window.destroy();
     SDL_Quit();
   }
@@ -53,13 +59,27 @@ namespace JAGEngine {
     std::cout << "Starting game loop...\n";
 
     FpsLimiter limiter;
-    limiter.setMaxFPS(60.0f);
+    limiter.setMaxFPS(m_maxFPS);
     m_isRunning = true;
 
+    // Frames longer than this are clamped so a hitch can't queue up seconds of ticks
+    const float MAX_FRAME_TIME = 0.25f;
+    const double perfFrequency = (double)SDL_GetPerformanceFrequency();
+    Uint64 previousCounter = SDL_GetPerformanceCounter();
+    float accumulator = 0.0f;
+
     // Ensure window is visible before entering game loop
     SDL_RaiseWindow(m_window.getSDLWindow());
 
     while (m_isRunning) {
+      Profiler::getInstance().beginFrame();
+      limiter.begin();
+
+      Uint64 currentCounter = SDL_GetPerformanceCounter();
+      float frameTime = (float)((double)(currentCounter - previousCounter) / perfFrequency);
+      previousCounter = currentCounter;
+      accumulator += std::min(frameTime, MAX_FRAME_TIME);
+
       // Process all SDL events
       SDL_Event evnt;
       while (SDL_PollEvent(&evnt)) {
@@ -82,15 +102,46 @@ namespace JAGEngine {
 
       beginImGuiFrame();
 
-      m_inputManager.update();
-      updateAudio();
-      update();
-      draw();
-
-      endImGuiFrame();
+      {
+        JAG_PROFILE_SCOPE("Audio");
+        updateAudio();
+      }
+      {
+        JAG_PROFILE_SCOPE("Update");
+        int ticks = 0;
+        while (accumulator >= m_fixedTimeStep && m_isRunning) {
+          if (ticks == m_maxTicksPerFrame) {
+            // Can't keep up, drop the backlog instead of spiralling
+            accumulator = 0.0f;
+            break;
+          }
+          m_inputManager.update();
+          update();
+          accumulator -= m_fixedTimeStep;
+          ticks++;
+        }
+      }
+      if (!m_isRunning) break;
+      {
+        JAG_PROFILE_SCOPE("Draw");
+        JAG_PROFILE_GPU_SCOPE("Draw");
+        draw();
+      }
+      {
+        JAG_PROFILE_GPU_SCOPE("ImGui");
+        endImGuiFrame();
+      }
 
       m_fps = limiter.end();
-      m_window.swapBuffer();
+      {
+        JAG_PROFILE_SCOPE("SwapBuffer");
+        m_window.swapBuffer();
+      }
+
+      JobSystem::getInstance().endFrame();
+      FrameArena::getInstance().reset();
+      MemoryStats::endFrame();
+      Profiler::getInstance().endFrame();
     }
   }
 
@@ -170,6 +221,10 @@ namespace JAGEngine {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    Profiler::getInstance().setThreadName("Main");
+    Profiler::getInstance().initGpu();
+    JobSystem::getInstance().init();
+
     return true;
   }
 
@@ -33,6 +33,14 @@ namespace JAGEngine {
 
     const float getFps() const { return m_fps; }
 
+    // Simulation runs update() at a fixed tick rate, draw() runs once per frame
+    void setTickRate(float ticksPerSecond) { m_fixedTimeStep = 1.0f / ticksPerSecond; }
+    float getFixedTimeStep() const { return m_fixedTimeStep; }
+    // 0 means rendering is uncapped. Nothing blends between ticks, so frames past the
+    // tick rate would only redraw the same state.
+    void setMaxFPS(float maxFPS) { m_maxFPS = maxFPS; }
+    void setMaxTicksPerFrame(int maxTicks) { m_maxTicksPerFrame = maxTicks; }
+
     void signalCleanup() {
       if (!m_isCleanedUp) {
         cleanup();
@@ -59,6 +67,9 @@ namespace JAGEngine {
     IGameScreen* m_currentScreen = nullptr;
     bool m_isRunning = false;
     float m_fps = 0.0f;
+    float m_fixedTimeStep = 1.0f / 60.0f;
+    float m_maxFPS = 60.0f;
+    int m_maxTicksPerFrame = 8;
     Window m_window;
     InputManager m_inputManager;
     bool m_imguiInitialized = false;
@@ -0,0 +1,206 @@
+// JobSystem.cpp
+
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace JAGEngine {
+
+  namespace {
+    thread_local int t_threadIndex = -1;
+  }
+
+  bool JobSystem::WorkQueue::push(const Job& job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tail - m_head == QUEUE_CAPACITY) {
+      return false;
+    }
+    m_jobs[m_tail % QUEUE_CAPACITY] = job;
+    m_tail++;
+    return true;
+  }
+
+  bool JobSystem::WorkQueue::pop(Job& job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tail == m_head) {
+      return false;
+    }
+    m_tail--;
+    job = m_jobs[m_tail % QUEUE_CAPACITY];
+    return true;
+  }
+
+  bool JobSystem::WorkQueue::steal(Job& job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tail == m_head) {
+      return false;
+    }
+    job = m_jobs[m_head % QUEUE_CAPACITY];
+    m_head++;
+    return true;
+  }
+
+  void JobSystem::init(uint32_t numWorkers, size_t frameAllocatorSize) {
+    if (m_isInitialized) {
+      std::cout << "JobSystem already initialized\n";
+      return;
+    }
+
+    if (numWorkers == 0) {
+      uint32_t hardwareThreads = std::thread::hardware_concurrency();
+      numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_frameAllocator.init(frameAllocatorSize);
+
+    // Queue 0 belongs to the calling thread
+    for (uint32_t i = 0; i < numWorkers + 1; i++) {
+      m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    t_threadIndex = 0;
+
+    m_isRunning.store(true);
+    for (uint32_t i = 1; i <= numWorkers; i++) {
+      m_workers.emplace_back(&JobSystem::workerLoop, this, (int)i);
+    }
+
+    m_isInitialized = true;
+    std::cout << "JobSystem started with " << numWorkers << " workers\n";
+  }
+
+  void JobSystem::destroy() {
+    if (!m_isInitialized) return;
+
+    {
+      std::lock_guard<std::mutex> lock(m_wakeMutex);
+      m_isRunning.store(false);
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers) {
+      worker.join();
+    }
+    m_workers.clear();
+    m_queues.clear();
+    m_pendingJobs.store(0);
+    t_threadIndex = -1;
+    m_isInitialized = false;
+  }
+
+  int JobSystem::getThreadIndex() {
+    return t_threadIndex;
+  }
+
+  void JobSystem::execute(const Job& job) {
+    job.function(job.data, job.begin, job.end);
+    if (job.counter) {
+      job.counter->m_count.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  }
+
+  void JobSystem::run(const Job& job) {
+    if (!m_isInitialized) {
+      // No workers, behave like a plain function call
+      job.function(job.data, job.begin, job.end);
+      return;
+    }
+
+    if (job.counter) {
+      job.counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int threadIndex = t_threadIndex >= 0 ? t_threadIndex : 0;
+    if (!m_queues[threadIndex]->push(job)) {
+      // Queue is full, running it here is better than dropping it
+      execute(job);
+      return;
+    }
+
+    m_pendingJobs.fetch_add(1);
+    if (m_sleepingWorkers.load() > 0) {
+      { std::lock_guard<std::mutex> lock(m_wakeMutex); }
+      m_wakeCondition.notify_one();
+    }
+  }
+
+  void JobSystem::parallelFor(JobFunction function, void* data, uint32_t count, uint32_t grainSize, JobCounter& counter) {
+    if (count == 0) return;
+
+    grainSize = std::max(grainSize, 1u);
+    // No point making more chunks than there are threads to steal them several times over
+    uint32_t maxChunks = std::max(getNumThreads(), 1u) * 4;
+    uint32_t chunkSize = std::max(grainSize, (count + maxChunks - 1) / maxChunks);
+
+    Job job;
+    job.function = function;
+    job.data = data;
+    job.counter = &counter;
+    for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+      job.begin = begin;
+      job.end = std::min(begin + chunkSize, count);
+      run(job);
+    }
+  }
+
+  bool JobSystem::tryRunJob(int threadIndex) {
+    Job job;
+    bool found = m_queues[threadIndex]->pop(job);
+
+    if (!found) {
+      uint32_t numQueues = (uint32_t)m_queues.size();
+      for (uint32_t i = 1; i < numQueues && !found; i++) {
+        found = m_queues[(threadIndex + i) % numQueues]->steal(job);
+      }
+    }
+
+    if (!found) return false;
+
+    m_pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+    return true;
+  }
+
+  void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+      // Threads we don't own have no queue, they can only wait
+      if (t_threadIndex < 0 || !tryRunJob(t_threadIndex)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void JobSystem::endFrame() {
+    m_frameAllocator.reset();
+  }
+
+  void JobSystem::workerLoop(int threadIndex) {
+    t_threadIndex = threadIndex;
+    std::string name = "Worker " + std::to_string(threadIndex);
+    Profiler::getInstance().setThreadName(name.c_str());
+
+    const int SPINS_BEFORE_SLEEP = 64;
+    int idleSpins = 0;
+
+    while (m_isRunning.load(std::memory_order_acquire)) {
+      if (tryRunJob(threadIndex)) {
+        idleSpins = 0;
+        continue;
+      }
+
+      if (++idleSpins < SPINS_BEFORE_SLEEP) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_wakeMutex);
+      m_sleepingWorkers.fetch_add(1);
+      m_wakeCondition.wait(lock, [this]() {
+        return m_pendingJobs.load() > 0 || !m_isRunning.load();
+      });
+      m_sleepingWorkers.fetch_sub(1);
+      idleSpins = 0;
+    }
+  }
+}
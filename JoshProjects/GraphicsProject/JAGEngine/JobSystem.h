@@ -0,0 +1,138 @@
+// JobSystem.h
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "LinearAllocator.h"
+
+namespace JAGEngine {
+
+  // Work function for a job. begin/end is the index range for parallelFor jobs,
+  // plain jobs get 0, 0.
+  typedef void (*JobFunction)(void* data, uint32_t begin, uint32_t end);
+
+  // Counts outstanding jobs. Pass the same counter to several jobs and wait() on it
+  // to use it as a fence, or hand it to a later stage as a dependency.
+  class JobCounter {
+  public:
+    bool isDone() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class JobSystem;
+    std::atomic<int> m_count{ 0 };
+  };
+
+  struct Job {
+    JobFunction function = nullptr;
+    void* data = nullptr;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    JobCounter* counter = nullptr;
+  };
+
+  // Fixed pool of worker threads, each with its own deque. Owners push and pop at the
+  // back, idle workers steal from the front of someone else's deque. The thread that
+  // calls init() is thread 0 and helps run jobs while it waits.
+  class JobSystem {
+  public:
+    static JobSystem& getInstance() {
+      static JobSystem instance;
+      return instance;
+    }
+
+    // 0 workers means one per hardware thread minus the caller
+    void init(uint32_t numWorkers = 0, size_t frameAllocatorSize = 1024 * 1024);
+    void destroy();
+    bool isInitialized() const { return m_isInitialized; }
+
+    // Workers plus the main thread, i.e. the range of getThreadIndex()
+    uint32_t getNumThreads() const { return (uint32_t)m_queues.size(); }
+    // 0 for the main thread, 1..N for workers, -1 for threads the system doesn't own
+    static int getThreadIndex();
+
+    void run(const Job& job);
+
+    // Runs a callable as a job. The callable is copied into the frame allocator, so
+    // the job has to finish before endFrame().
+    template<typename F>
+    void run(JobCounter& counter, F&& function) {
+      typedef typename std::decay<F>::type Fn;
+      void* memory = m_frameAllocator.allocate(sizeof(Fn), alignof(Fn));
+      if (memory == nullptr) {
+        function();
+        return;
+      }
+      Job job;
+      job.function = [](void* data, uint32_t, uint32_t) {
+        Fn* fn = static_cast<Fn*>(data);
+        (*fn)();
+        fn->~Fn();
+      };
+      job.data = new (memory) Fn(std::forward<F>(function));
+      job.counter = &counter;
+      run(job);
+    }
+
+    // Splits [0, count) into chunks of at least grainSize and queues them without waiting
+    void parallelFor(JobFunction function, void* data, uint32_t count, uint32_t grainSize, JobCounter& counter);
+
+    // Calls function(begin, end) over [0, count) in parallel and returns when it's all done
+    template<typename F>
+    void parallelFor(uint32_t count, uint32_t grainSize, F&& function) {
+      typedef typename std::remove_reference<F>::type Fn;
+      JobCounter counter;
+      parallelFor([](void* data, uint32_t begin, uint32_t end) {
+        (*static_cast<Fn*>(data))(begin, end);
+      }, const_cast<void*>(static_cast<const void*>(&function)), count, grainSize, counter);
+      wait(counter);
+    }
+
+    // Runs other jobs until the counter reaches zero
+    void wait(JobCounter& counter);
+
+    // Scratch memory for job data that lives until endFrame()
+    LinearAllocator& getFrameAllocator() { return m_frameAllocator; }
+    // Call once per frame after every job that used the frame allocator is done
+    void endFrame();
+
+  private:
+    JobSystem() {}
+
+    static constexpr uint32_t QUEUE_CAPACITY = 4096;
+
+    class WorkQueue {
+    public:
+      bool push(const Job& job);
+      bool pop(Job& job);
+      bool steal(Job& job);
+
+    private:
+      std::mutex m_mutex;
+      Job m_jobs[QUEUE_CAPACITY];
+      uint32_t m_head = 0; // steal end
+      uint32_t m_tail = 0; // owner end
+    };
+
+    static void execute(const Job& job);
+    bool tryRunJob(int threadIndex);
+    void workerLoop(int threadIndex);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    LinearAllocator m_frameAllocator;
+
+    std::atomic<int> m_pendingJobs{ 0 };
+    std::atomic<int> m_sleepingWorkers{ 0 };
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::atomic<bool> m_isRunning{ false };
+    bool m_isInitialized = false;
+  };
+}
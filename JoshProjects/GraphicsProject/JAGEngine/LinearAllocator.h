@@ -0,0 +1,74 @@
+// LinearAllocator.h
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace JAGEngine {
+
+  // Bump allocator over one fixed block. allocate() is lock-free and safe to call from
+  // any thread; nothing is freed individually, reset() releases everything at once.
+  // Destructors are never run, so only put trivially destructible data here or
+  // destroy it yourself before reset().
+  class LinearAllocator {
+  public:
+    LinearAllocator() {}
+    explicit LinearAllocator(size_t capacity) { init(capacity); }
+
+    void init(size_t capacity) {
+      m_memory.reset(new uint8_t[capacity]);
+      m_capacity = capacity;
+      m_offset.store(0, std::memory_order_relaxed);
+      m_peak = 0;
+    }
+
+    // Returns nullptr when the block is exhausted
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+      const uintptr_t base = reinterpret_cast<uintptr_t>(m_memory.get());
+      size_t offset = m_offset.load(std::memory_order_relaxed);
+      size_t newOffset;
+      uintptr_t aligned;
+      do {
+        aligned = (base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        newOffset = (size_t)(aligned - base) + size;
+        if (newOffset > m_capacity) {
+          return nullptr;
+        }
+      } while (!m_offset.compare_exchange_weak(offset, newOffset, std::memory_order_relaxed));
+      return reinterpret_cast<void*>(aligned);
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+      void* memory = allocate(sizeof(T), alignof(T));
+      return memory ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    template<typename T>
+    T* allocateArray(size_t count) {
+      return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Not thread-safe, call once nothing is using the memory anymore
+    void reset() {
+      size_t used = m_offset.load(std::memory_order_relaxed);
+      if (used > m_peak) m_peak = used;
+      m_offset.store(0, std::memory_order_relaxed);
+    }
+
+    size_t getUsed() const { return m_offset.load(std::memory_order_relaxed); }
+    size_t getCapacity() const { return m_capacity; }
+    size_t getPeak() const { return m_peak; }
+
+  private:
+    std::unique_ptr<uint8_t[]> m_memory;
+    size_t m_capacity = 0;
+    std::atomic<size_t> m_offset{ 0 };
+    size_t m_peak = 0;
+  };
+}
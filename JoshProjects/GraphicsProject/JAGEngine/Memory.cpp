@@ -0,0 +1,61 @@
+// Memory.cpp
+
+#include "Memory.h"
+#include <atomic>
+#include <cstdlib>
+
+namespace JAGEngine {
+
+  namespace {
+    const size_t DEFAULT_FRAME_ARENA_SIZE = 512 * 1024;
+
+    std::atomic<uint64_t> s_allocationCount{ 0 };
+    std::atomic<uint64_t> s_allocationBytes{ 0 };
+  }
+
+  uint64_t MemoryStats::s_allocationsLastFrame = 0;
+  uint64_t MemoryStats::s_bytesLastFrame = 0;
+
+  FrameArena::FrameArena() {
+    init(DEFAULT_FRAME_ARENA_SIZE);
+  }
+
+  void FrameArena::init(size_t capacity) {
+    m_resource.reset();
+    m_buffer.assign(capacity, std::byte(0));
+    m_resource = std::make_unique<std::pmr::monotonic_buffer_resource>(
+      m_buffer.data(), m_buffer.size(), std::pmr::new_delete_resource());
+  }
+
+  void FrameArena::reset() {
+    // Drops any heap spill and rewinds to the start of the buffer
+    m_resource->release();
+  }
+
+  void MemoryStats::endFrame() {
+    s_allocationsLastFrame = s_allocationCount.exchange(0, std::memory_order_relaxed);
+    s_bytesLastFrame = s_allocationBytes.exchange(0, std::memory_order_relaxed);
+  }
+}
+
+#if JAG_TRACK_ALLOCATIONS
+// Global replacements so every heap allocation in the process is counted.
+// The array and nothrow forms forward to these by default.
+void* operator new(std::size_t size) {
+  JAGEngine::s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+  JAGEngine::s_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+  void* memory = std::malloc(size ? size : 1);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+#endif
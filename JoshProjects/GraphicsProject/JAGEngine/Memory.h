@@ -0,0 +1,142 @@
+// Memory.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Counts every global operator new in debug builds so per-frame allocations show up
+// in the profiler window. Define to 0 to turn it off.
+#ifndef JAG_TRACK_ALLOCATIONS
+#ifdef _DEBUG
+#define JAG_TRACK_ALLOCATIONS 1
+#else
+#define JAG_TRACK_ALLOCATIONS 0
+#endif
+#endif
+
+namespace JAGEngine {
+
+  // Per-frame bump arena. Anything allocated from it is thrown away at the end of the
+  // frame, so it's meant for scratch containers on the main thread. When the block
+  // runs out it spills to the heap until the next reset. Not thread-safe; jobs should
+  // use JobSystem::getFrameAllocator() instead.
+  class FrameArena {
+  public:
+    static FrameArena& getInstance() {
+      static FrameArena instance;
+      return instance;
+    }
+
+    void init(size_t capacity);
+    // Called by IMainGame at the end of every frame
+    void reset();
+
+    std::pmr::memory_resource* getResource() { return m_resource.get(); }
+    size_t getCapacity() const { return m_buffer.size(); }
+
+  private:
+    FrameArena();
+
+    std::vector<std::byte> m_buffer;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> m_resource;
+  };
+
+  // Shorthand for the frame arena's memory resource
+  inline std::pmr::memory_resource* frameResource() {
+    return FrameArena::getInstance().getResource();
+  }
+
+  // Scratch containers for use inside a single frame
+  template<typename T>
+  using FrameVector = std::pmr::vector<T>;
+  template<typename T>
+  using FrameSet = std::pmr::set<T>;
+  template<typename T>
+  using FrameUnorderedSet = std::pmr::unordered_set<T>;
+  template<typename K, typename V>
+  using FrameUnorderedMap = std::pmr::unordered_map<K, V>;
+
+  // Fixed-size object pool. Storage grows in blocks and is never returned to the heap
+  // until the pool is destroyed, freed slots are reused first.
+  template<typename T, size_t BLOCK_SIZE = 256>
+  class ObjectPool {
+  public:
+    ObjectPool() {}
+    ~ObjectPool() { clear(); }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+      if (m_freeList == nullptr) {
+        addBlock();
+      }
+      Slot* slot = m_freeList;
+      m_freeList = slot->next;
+      m_liveCount++;
+      return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* object) {
+      if (object == nullptr) return;
+      object->~T();
+      Slot* slot = reinterpret_cast<Slot*>(object);
+      slot->next = m_freeList;
+      m_freeList = slot;
+      m_liveCount--;
+    }
+
+    // Frees the blocks. Every object must have been destroyed already.
+    void clear() {
+      m_blocks.clear();
+      m_freeList = nullptr;
+      m_liveCount = 0;
+    }
+
+    size_t getLiveCount() const { return m_liveCount; }
+    size_t getCapacity() const { return m_blocks.size() * BLOCK_SIZE; }
+
+  private:
+    union Slot {
+      Slot* next;
+      alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void addBlock() {
+      m_blocks.push_back(std::make_unique<Slot[]>(BLOCK_SIZE));
+      Slot* block = m_blocks.back().get();
+      for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        block[i].next = i + 1 < BLOCK_SIZE ? &block[i + 1] : m_freeList;
+      }
+      m_freeList = block;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> m_blocks;
+    Slot* m_freeList = nullptr;
+    size_t m_liveCount = 0;
+  };
+
+  // Heap allocation counts per frame, only filled in when JAG_TRACK_ALLOCATIONS is on
+  class MemoryStats {
+  public:
+    static bool isTracking() { return JAG_TRACK_ALLOCATIONS != 0; }
+    // Rolls the current counters into the "last frame" values
+    static void endFrame();
+
+    static uint64_t getAllocationsLastFrame() { return s_allocationsLastFrame; }
+    static uint64_t getBytesLastFrame() { return s_bytesLastFrame; }
+
+  private:
+    static uint64_t s_allocationsLastFrame;
+    static uint64_t s_bytesLastFrame;
+  };
+}
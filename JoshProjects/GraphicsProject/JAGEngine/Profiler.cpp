@@ -0,0 +1,399 @@
+// Profiler.cpp
+
+#include "Profiler.h"
+#include "Memory.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <ImGui/imgui.h>
+
+// The glew.h in deps doesn't expose GL_TIMESTAMP under its usual name
+#ifndef GL_TIMESTAMP
+#define GL_TIMESTAMP 0x8E28
+#endif
+
+namespace JAGEngine {
+
+  namespace {
+    thread_local ProfileThreadBuffer* t_threadBuffer = nullptr;
+
+    const uint32_t GPU_THREAD_ID = 0;
+
+    void writeJsonString(std::ostream& out, const char* s) {
+      out << '"';
+      for (; s && *s; ++s) {
+        switch (*s) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        default: out << *s; break;
+        }
+      }
+      out << '"';
+    }
+
+    // Stable color per scope name so the same scope looks the same every frame
+    ImU32 colorForName(const char* name) {
+      uintptr_t h = reinterpret_cast<uintptr_t>(name);
+      h ^= h >> 13;
+      h *= 0x9E3779B1u;
+      h ^= h >> 16;
+      int r = 80 + (int)(h & 0x7F);
+      int g = 80 + (int)((h >> 8) & 0x7F);
+      int b = 80 + (int)((h >> 16) & 0x7F);
+      return IM_COL32(r, g, b, 255);
+    }
+  }
+
+  ProfileThreadBuffer::ProfileThreadBuffer(uint32_t threadId, const char* name) :
+    m_events(new ProfileEvent[CAPACITY]),
+    m_threadId(threadId),
+    m_name(name) {
+  }
+
+  void ProfileThreadBuffer::push(const ProfileEvent& evnt) {
+    uint64_t index = m_writeIndex.load(std::memory_order_relaxed);
+    m_events[index & (CAPACITY - 1)] = evnt;
+    m_writeIndex.store(index + 1, std::memory_order_release);
+  }
+
+  void ProfileThreadBuffer::snapshot(std::vector<ProfileEvent>& out) const {
+    uint64_t end = m_writeIndex.load(std::memory_order_acquire);
+    uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+
+    size_t firstOut = out.size();
+    for (uint64_t i = begin; i < end; i++) {
+      out.push_back(m_events[i & (CAPACITY - 1)]);
+    }
+
+    // Anything the writer lapped while we were copying is garbage, drop it
+    uint64_t after = m_writeIndex.load(std::memory_order_acquire);
+    uint64_t safeBegin = after >= CAPACITY ? after - CAPACITY + 1 : 0;
+    if (safeBegin > begin) {
+      size_t toDrop = (size_t)std::min<uint64_t>(safeBegin - begin, end - begin);
+      out.erase(out.begin() + firstOut, out.begin() + firstOut + toDrop);
+    }
+  }
+
+  void GpuProfiler::init() {
+    if (m_initialized) return;
+
+    if (!GLEW_VERSION_3_3) {
+      std::cout << "GpuProfiler: timer queries not supported, GPU timing disabled\n";
+      return;
+    }
+
+    for (auto& frame : m_frames) {
+      glGenQueries(MAX_SCOPES_PER_FRAME * 2, frame.queries);
+      frame.numScopes = 0;
+    }
+    m_currentFrame = 0;
+    m_depth = 0;
+    m_initialized = true;
+  }
+
+  void GpuProfiler::destroy() {
+    if (!m_initialized) return;
+
+    for (auto& frame : m_frames) {
+      glDeleteQueries(MAX_SCOPES_PER_FRAME * 2, frame.queries);
+      frame.numScopes = 0;
+    }
+    m_initialized = false;
+  }
+
+  void GpuProfiler::beginFrame(uint32_t frameIndex) {
+    if (!m_initialized) return;
+
+    m_currentFrame = (m_currentFrame + 1) % FRAME_LATENCY;
+    Frame& frame = m_frames[m_currentFrame];
+
+    // This slot was last used FRAME_LATENCY frames ago, its results should be ready by now
+    if (frame.numScopes > 0) {
+      resolveFrame(frame);
+    }
+
+    frame.numScopes = 0;
+    frame.frame = frameIndex;
+    frame.cpuSyncNs = Profiler::nowNs();
+    glGetInteger64v(GL_TIMESTAMP, &frame.gpuSyncNs);
+    m_depth = 0;
+  }
+
+  int GpuProfiler::beginScope(const char* name) {
+    if (!m_initialized) return -1;
+
+    Frame& frame = m_frames[m_currentFrame];
+    if (frame.numScopes >= MAX_SCOPES_PER_FRAME) return -1;
+
+    int index = frame.numScopes++;
+    frame.scopes[index].name = name;
+    frame.scopes[index].depth = m_depth++;
+    glQueryCounter(frame.queries[index * 2], GL_TIMESTAMP);
+    return index;
+  }
+
+  void GpuProfiler::endScope(int scopeIndex) {
+    if (!m_initialized || scopeIndex < 0) return;
+
+    Frame& frame = m_frames[m_currentFrame];
+    glQueryCounter(frame.queries[scopeIndex * 2 + 1], GL_TIMESTAMP);
+    if (m_depth > 0) m_depth--;
+  }
+
+  void GpuProfiler::resolveFrame(Frame& frame) {
+    // Queries complete in order, so if the last one is ready they all are
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.numScopes * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+      frame.numScopes = 0;
+      return;
+    }
+
+    for (int i = 0; i < frame.numScopes; i++) {
+      GLuint64 startGpu = 0;
+      GLuint64 endGpu = 0;
+      glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &startGpu);
+      glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &endGpu);
+
+      ProfileEvent evnt;
+      evnt.name = frame.scopes[i].name;
+      evnt.depth = frame.scopes[i].depth;
+      evnt.frame = frame.frame;
+      evnt.startNs = frame.cpuSyncNs + (int64_t)(startGpu - frame.gpuSyncNs);
+      evnt.endNs = frame.cpuSyncNs + (int64_t)(endGpu - frame.gpuSyncNs);
+      Profiler::getInstance().pushGpuEvent(evnt);
+    }
+  }
+
+  Profiler::Profiler() :
+    m_gpuBuffer(std::make_unique<ProfileThreadBuffer>(GPU_THREAD_ID, "GPU")) {
+  }
+
+  uint64_t Profiler::nowNs() {
+    static const auto s_epoch = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - s_epoch).count();
+  }
+
+  void Profiler::initGpu() {
+    m_gpu.init();
+  }
+
+  void Profiler::destroy() {
+    m_gpu.destroy();
+  }
+
+  ProfileThreadBuffer& Profiler::getThreadBuffer() {
+    if (t_threadBuffer == nullptr) {
+      std::lock_guard<std::mutex> lock(m_registryMutex);
+      uint32_t threadId = (uint32_t)m_threadBuffers.size() + 1;
+      std::string name = threadId == 1 ? "Main" : "Thread " + std::to_string(threadId);
+      m_threadBuffers.push_back(std::make_unique<ProfileThreadBuffer>(threadId, name.c_str()));
+      t_threadBuffer = m_threadBuffers.back().get();
+    }
+    return *t_threadBuffer;
+  }
+
+  void Profiler::setThreadName(const char* name) {
+    ProfileThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    buffer.setName(name);
+  }
+
+  uint64_t Profiler::beginScope() {
+    getThreadBuffer().m_depth++;
+    return nowNs();
+  }
+
+  void Profiler::endScope(const char* name, uint64_t startNs) {
+    uint64_t endNs = nowNs();
+    ProfileThreadBuffer& buffer = getThreadBuffer();
+    if (buffer.m_depth > 0) buffer.m_depth--;
+    if (!isEnabled()) return;
+
+    ProfileEvent evnt;
+    evnt.name = name;
+    evnt.startNs = startNs;
+    evnt.endNs = endNs;
+    evnt.depth = buffer.m_depth;
+    evnt.frame = m_frameIndex.load(std::memory_order_relaxed);
+    buffer.push(evnt);
+  }
+
+  void Profiler::pushGpuEvent(const ProfileEvent& evnt) {
+    if (!isEnabled()) return;
+    m_gpuBuffer->push(evnt);
+  }
+
+  void Profiler::beginFrame() {
+    uint32_t frame = m_frameIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+    m_gpu.beginFrame(frame);
+    // The frame itself is the outermost scope on the main thread
+    m_frameStartNs = beginScope();
+  }
+
+  void Profiler::endFrame() {
+    endScope("Frame", m_frameStartNs);
+    m_lastFrameStartNs = m_frameStartNs;
+    m_lastFrameEndNs = nowNs();
+  }
+
+  void Profiler::takeSnapshot(std::vector<ThreadSnapshot>& out) {
+    out.clear();
+
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    out.reserve(m_threadBuffers.size() + 1);
+    for (auto& buffer : m_threadBuffers) {
+      out.push_back({ buffer->getName(), buffer->getThreadId(), {} });
+      buffer->snapshot(out.back().events);
+    }
+    if (m_gpu.isInitialized()) {
+      out.push_back({ m_gpuBuffer->getName(), m_gpuBuffer->getThreadId(), {} });
+      m_gpuBuffer->snapshot(out.back().events);
+    }
+  }
+
+  bool Profiler::exportChromeTrace(const std::string& filePath) {
+    std::vector<ThreadSnapshot> threads;
+    takeSnapshot(threads);
+
+    std::ofstream file(filePath);
+    if (file.fail()) {
+      std::cout << "Profiler: failed to open " << filePath << " for writing\n";
+      return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (auto& thread : threads) {
+      if (!first) file << ",\n";
+      first = false;
+      file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.threadId
+        << ",\"args\":{\"name\":";
+      writeJsonString(file, thread.name.c_str());
+      file << "}}";
+
+      const char* category = thread.threadId == GPU_THREAD_ID ? "gpu" : "cpu";
+      for (auto& evnt : thread.events) {
+        file << ",\n{\"name\":";
+        writeJsonString(file, evnt.name);
+        file << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.threadId
+          << ",\"ts\":" << (double)evnt.startNs / 1000.0
+          << ",\"dur\":" << (double)(evnt.endNs - evnt.startNs) / 1000.0
+          << ",\"args\":{\"frame\":" << evnt.frame << "}}";
+      }
+    }
+    file << "\n]}\n";
+
+    std::cout << "Profiler: wrote trace to " << filePath << "\n";
+    return true;
+  }
+
+  void Profiler::drawImGui(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(900, 400), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", open)) {
+      ImGui::End();
+      return;
+    }
+
+    bool enabled = isEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+      setEnabled(enabled);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &m_paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+      exportChromeTrace("profile_trace.json");
+    }
+
+    if (!m_paused) {
+      takeSnapshot(m_viewSnapshot);
+      m_viewStartNs = m_lastFrameStartNs;
+      m_viewEndNs = m_lastFrameEndNs;
+      // GPU results lag behind, so show the newest frame that has GPU data for it
+      for (auto& thread : m_viewSnapshot) {
+        if (thread.threadId != GPU_THREAD_ID || thread.events.empty()) continue;
+        uint32_t gpuFrame = thread.events.back().frame;
+        for (auto& main : m_viewSnapshot) {
+          if (main.threadId != 1) continue;
+          for (auto it = main.events.rbegin(); it != main.events.rend(); ++it) {
+            if (it->frame == gpuFrame && it->depth == 0) {
+              m_viewStartNs = it->startNs;
+              m_viewEndNs = it->endNs;
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    if (m_viewEndNs <= m_viewStartNs) {
+      ImGui::Text("No completed frame yet");
+      ImGui::End();
+      return;
+    }
+
+    const double frameMs = (double)(m_viewEndNs - m_viewStartNs) / 1000000.0;
+    ImGui::Text("Frame: %.3f ms", frameMs);
+    if (MemoryStats::isTracking()) {
+      ImGui::SameLine();
+      ImGui::Text("  Heap allocations: %llu (%llu bytes)",
+        (unsigned long long)MemoryStats::getAllocationsLastFrame(),
+        (unsigned long long)MemoryStats::getBytesLastFrame());
+    }
+
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    const float laneLabelWidth = 90.0f;
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    for (auto& thread : m_viewSnapshot) {
+      uint32_t maxDepth = 0;
+      for (auto& evnt : thread.events) {
+        if (evnt.endNs < m_viewStartNs || evnt.startNs > m_viewEndNs) continue;
+        maxDepth = std::max(maxDepth, evnt.depth);
+      }
+
+      ImGui::TextUnformatted(thread.name.c_str());
+      ImGui::SameLine(laneLabelWidth);
+
+      ImVec2 origin = ImGui::GetCursorScreenPos();
+      float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+      float height = rowHeight * (maxDepth + 1);
+      ImGui::InvisibleButton(("##lane" + thread.name).c_str(), ImVec2(width, height));
+      drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(30, 30, 30, 255));
+
+      const double scale = width / (double)(m_viewEndNs - m_viewStartNs);
+      ImVec2 mouse = ImGui::GetIO().MousePos;
+
+      for (auto& evnt : thread.events) {
+        if (evnt.endNs < m_viewStartNs || evnt.startNs > m_viewEndNs) continue;
+
+        uint64_t start = std::max(evnt.startNs, m_viewStartNs);
+        uint64_t end = std::min(evnt.endNs, m_viewEndNs);
+        float x0 = origin.x + (float)((start - m_viewStartNs) * scale);
+        float x1 = std::max(x0 + 1.0f, origin.x + (float)((end - m_viewStartNs) * scale));
+        float y0 = origin.y + evnt.depth * rowHeight;
+        float y1 = y0 + rowHeight - 1.0f;
+
+        drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), colorForName(evnt.name));
+        if (x1 - x0 > 30.0f) {
+          drawList->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+          drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(255, 255, 255, 255), evnt.name);
+          drawList->PopClipRect();
+        }
+
+        if (mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1) {
+          ImGui::BeginTooltip();
+          ImGui::Text("%s", evnt.name);
+          ImGui::Text("%.3f ms", (double)(evnt.endNs - evnt.startNs) / 1000000.0);
+          ImGui::EndTooltip();
+        }
+      }
+    }
+
+    ImGui::End();
+  }
+}
@@ -0,0 +1,205 @@
+// Profiler.h
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+
+// Set to 0 to compile every JAG_PROFILE_* macro out of the build
+#ifndef JAG_PROFILER_ENABLED
+#define JAG_PROFILER_ENABLED 1
+#endif
+
+namespace JAGEngine {
+
+  // One finished CPU or GPU scope. Names must be string literals (or otherwise
+  // outlive the profiler) since only the pointer is stored.
+  struct ProfileEvent {
+    const char* name = nullptr;
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+    uint32_t depth = 0;
+    uint32_t frame = 0;
+  };
+
+  // Ring of events owned by a single thread. Only the owning thread writes,
+  // readers copy a snapshot and discard anything that got overwritten meanwhile.
+  class ProfileThreadBuffer {
+  public:
+    static constexpr uint32_t CAPACITY = 1 << 14;
+
+    ProfileThreadBuffer(uint32_t threadId, const char* name);
+
+    void push(const ProfileEvent& evnt);
+    void snapshot(std::vector<ProfileEvent>& out) const;
+
+    uint32_t getThreadId() const { return m_threadId; }
+    const std::string& getName() const { return m_name; }
+    void setName(const char* name) { m_name = name; }
+
+    uint32_t m_depth = 0;
+
+  private:
+    std::unique_ptr<ProfileEvent[]> m_events;
+    std::atomic<uint64_t> m_writeIndex{ 0 };
+    uint32_t m_threadId;
+    std::string m_name;
+  };
+
+  // Resolves GL_TIMESTAMP query pairs a few frames late so the CPU never waits on the GPU
+  class GpuProfiler {
+  public:
+    static constexpr int FRAME_LATENCY = 4;
+    static constexpr int MAX_SCOPES_PER_FRAME = 64;
+
+    void init();
+    void destroy();
+    bool isInitialized() const { return m_initialized; }
+
+    void beginFrame(uint32_t frame);
+    int beginScope(const char* name);
+    void endScope(int scopeIndex);
+
+  private:
+    struct Scope {
+      const char* name = nullptr;
+      uint32_t depth = 0;
+    };
+
+    struct Frame {
+      GLuint queries[MAX_SCOPES_PER_FRAME * 2] = {};
+      Scope scopes[MAX_SCOPES_PER_FRAME];
+      int numScopes = 0;
+      uint32_t frame = 0;
+      // CPU time matching GPU time gpuSyncNs, used to place GPU events on the CPU timeline
+      uint64_t cpuSyncNs = 0;
+      GLint64 gpuSyncNs = 0;
+    };
+
+    void resolveFrame(Frame& frame);
+
+    Frame m_frames[FRAME_LATENCY];
+    int m_currentFrame = 0;
+    uint32_t m_depth = 0;
+    bool m_initialized = false;
+  };
+
+  class Profiler {
+  public:
+    static Profiler& getInstance() {
+      static Profiler instance;
+      return instance;
+    }
+
+    // Call once the GL context exists, enables GPU timing when timer queries are supported
+    void initGpu();
+    void destroy();
+
+    void beginFrame();
+    void endFrame();
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Names the calling thread's track in the timeline
+    void setThreadName(const char* name);
+
+    uint64_t beginScope();
+    void endScope(const char* name, uint64_t startNs);
+
+    int beginGpuScope(const char* name) { return m_gpu.beginScope(name); }
+    void endGpuScope(int scopeIndex) { m_gpu.endScope(scopeIndex); }
+    void pushGpuEvent(const ProfileEvent& evnt);
+
+    // Writes everything currently held in the ring buffers as Chrome trace_event JSON
+    // (open with chrome://tracing or ui.perfetto.dev)
+    bool exportChromeTrace(const std::string& filePath);
+
+    // Flame view of the last completed frame, one lane per thread
+    void drawImGui(bool* open = nullptr);
+
+    uint32_t getFrameIndex() const { return m_frameIndex.load(std::memory_order_relaxed); }
+    static uint64_t nowNs();
+
+  private:
+    Profiler();
+
+    struct ThreadSnapshot {
+      std::string name;
+      uint32_t threadId;
+      std::vector<ProfileEvent> events;
+    };
+
+    ProfileThreadBuffer& getThreadBuffer();
+    void takeSnapshot(std::vector<ThreadSnapshot>& out);
+
+    std::mutex m_registryMutex; // only taken the first time a thread records a scope
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> m_threadBuffers;
+    std::unique_ptr<ProfileThreadBuffer> m_gpuBuffer;
+
+    GpuProfiler m_gpu;
+
+    std::atomic<bool> m_enabled{ true };
+    std::atomic<uint32_t> m_frameIndex{ 0 };
+    uint64_t m_frameStartNs = 0;
+    uint64_t m_lastFrameStartNs = 0;
+    uint64_t m_lastFrameEndNs = 0;
+
+    // ImGui state
+    bool m_paused = false;
+    std::vector<ThreadSnapshot> m_viewSnapshot;
+    uint64_t m_viewStartNs = 0;
+    uint64_t m_viewEndNs = 0;
+  };
+
+  // RAII CPU scope. Does not allocate; the name pointer is stored as-is.
+  class ProfileScope {
+  public:
+    explicit ProfileScope(const char* name) : m_name(name) {
+      m_startNs = Profiler::getInstance().beginScope();
+    }
+    ~ProfileScope() {
+      Profiler::getInstance().endScope(m_name, m_startNs);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    const char* m_name;
+    uint64_t m_startNs;
+  };
+
+  // RAII GPU scope, must be used on the thread that owns the GL context
+  class GpuProfileScope {
+  public:
+    explicit GpuProfileScope(const char* name) {
+      m_index = Profiler::getInstance().beginGpuScope(name);
+    }
+    ~GpuProfileScope() {
+      Profiler::getInstance().endGpuScope(m_index);
+    }
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+  private:
+    int m_index;
+  };
+}
+
+#define JAG_PROFILE_CONCAT_INNER(a, b) a##b
+#define JAG_PROFILE_CONCAT(a, b) JAG_PROFILE_CONCAT_INNER(a, b)
+
+#if JAG_PROFILER_ENABLED
+#define JAG_PROFILE_SCOPE(name) JAGEngine::ProfileScope JAG_PROFILE_CONCAT(jagProfileScope, __LINE__)(name)
+#define JAG_PROFILE_FUNCTION() JAG_PROFILE_SCOPE(__FUNCTION__)
+#define JAG_PROFILE_GPU_SCOPE(name) JAGEngine::GpuProfileScope JAG_PROFILE_CONCAT(jagGpuProfileScope, __LINE__)(name)
+#else
+#define JAG_PROFILE_SCOPE(name)
+#define JAG_PROFILE_FUNCTION()
+#define JAG_PROFILE_GPU_SCOPE(name)
+#endif
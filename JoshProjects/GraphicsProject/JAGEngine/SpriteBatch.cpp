@@ -59,6 +59,13 @@ namespace JAGEngine {
      topRight.setUV(uvRect.x + uvRect.z, uvRect.y);  // Fixed UV coordinate
    }
 
+  void Glyph::translate(const glm::vec2& offset) {
+    topLeft.setPosition(topLeft.position.x + offset.x, topLeft.position.y + offset.y);
+    bottomLeft.setPosition(bottomLeft.position.x + offset.x, bottomLeft.position.y + offset.y);
+    bottomRight.setPosition(bottomRight.position.x + offset.x, bottomRight.position.y + offset.y);
+    topRight.setPosition(topRight.position.x + offset.x, topRight.position.y + offset.y);
+  }
+
   glm::vec2 Glyph::rotatePoint(glm::vec2 pos, float angle) {
     glm::vec2 newv;
     newv.x = pos.x * cos(angle) - pos.y * sin(angle);
@@ -66,20 +73,60 @@ namespace JAGEngine {
     return newv;
   }
 
-  SpriteBatch::SpriteBatch() : _vbo(0), _vao(0)
+  SpriteBatch::SpriteBatch() : _vbo(0), _vao(0), m_whiteTexture(0)
   {
 
   }
 
   SpriteBatch::~SpriteBatch() {
+    deleteGLObjects();
+  }
+
+  SpriteBatch::SpriteBatch(SpriteBatch&& other) noexcept :
+    _vbo(other._vbo), _vao(other._vao), _sortType(other._sortType),
+    _glyphPointers(std::move(other._glyphPointers)), _glyphs(std::move(other._glyphs)),
+    _renderBatches(std::move(other._renderBatches)), _vertices(std::move(other._vertices)),
+    m_whiteTexture(other.m_whiteTexture) {
+    other._vbo = 0;
+    other._vao = 0;
+    other.m_whiteTexture = 0;
+  }
+
+  SpriteBatch& SpriteBatch::operator=(SpriteBatch&& other) noexcept {
+    if (this != &other) {
+      deleteGLObjects();
+      _vbo = other._vbo;
+      _vao = other._vao;
+      _sortType = other._sortType;
+      _glyphPointers = std::move(other._glyphPointers);
+      _glyphs = std::move(other._glyphs);
+      _renderBatches = std::move(other._renderBatches);
+      _vertices = std::move(other._vertices);
+      m_whiteTexture = other.m_whiteTexture;
+      other._vbo = 0;
+      other._vao = 0;
+      other.m_whiteTexture = 0;
+    }
+    return *this;
+  }
+
+  void SpriteBatch::deleteGLObjects() {
     if (m_whiteTexture != 0) {
       glDeleteTextures(1, &m_whiteTexture);
     }
+    if (_vbo != 0) {
+      glDeleteBuffers(1, &_vbo);
+    }
+    if (_vao != 0) {
+      glDeleteVertexArrays(1, &_vao);
+    }
+    _vbo = 0;
+    _vao = 0;
+    m_whiteTexture = 0;
   }
 
   void SpriteBatch::init() {
     createVertexArray();
-    createWhiteTexture();
 
     // Enable blending
     glEnable(GL_BLEND);
@@ -124,6 +171,10 @@ namespace JAGEngine {
     _glyphs.emplace_back(destRect, uvRect, texture, depth, color, angle);
   }
 
+  void SpriteBatch::drawGlyphs(const Glyph* glyphs, size_t count) {
+    _glyphs.insert(_glyphs.end(), glyphs, glyphs + count);
+  }
+
   void SpriteBatch::renderBatch() {
     // Make sure blending is enabled
     glEnable(GL_BLEND);
@@ -131,8 +182,15 @@ namespace JAGEngine {
 
     glBindVertexArray(_vao);
     for (int i = 0; i < _renderBatches.size(); i++) {
-      // Use white texture for texture ID 0
-      GLuint textureID = _renderBatches[i].texture == 0 ? m_whiteTexture : _renderBatches[i].texture;
+      // Use white texture for texture ID 0. Most batches never draw one, e.g. the
+      // level chunks, so it isn't made until needed.
+      GLuint textureID = _renderBatches[i].texture;
+      if (textureID == 0) {
+        if (m_whiteTexture == 0) {
+          createWhiteTexture();
+        }
+        textureID = m_whiteTexture;
+      }
       glBindTexture(GL_TEXTURE_2D, textureID);
 
       if (DEBUG_OUTPUT) {
@@ -147,7 +205,8 @@ namespace JAGEngine {
   }
 
   void SpriteBatch::createRenderBatches() {
-    std::vector <Vertex> vertices;
+    // Reuse last frame's storage, resize only grows the capacity
+    std::vector<Vertex>& vertices = _vertices;
     vertices.resize(_glyphPointers.size() * 6);
 
 
@@ -64,6 +64,9 @@ namespace JAGEngine {
     Glyph(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint Texture, float Depth, const ColorRGBA8& color);
     Glyph(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint Texture, float Depth, const ColorRGBA8& color, float angle);
 
+    // Moves all four corners, used to re-place cached text runs
+    void translate(const glm::vec2& offset);
+
     GLuint texture;
     float depth;
 
@@ -92,6 +95,12 @@ namespace JAGEngine {
     SpriteBatch();
     ~SpriteBatch();
 
+    // Owns its VAO, VBO and white texture, so it can be moved but not copied
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+    SpriteBatch(SpriteBatch&& other) noexcept;
+    SpriteBatch& operator=(SpriteBatch&& other) noexcept;
+
     void init();
 
     void begin(GlyphSortType sortType = GlyphSortType::TEXTURE);
@@ -102,6 +111,9 @@ namespace JAGEngine {
 
     void draw(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint texture, float depth, const ColorRGBA8& color, const glm::vec2& dir);
 
+    // Appends prebuilt glyphs as-is, e.g. a cached text run
+    void drawGlyphs(const Glyph* glyphs, size_t count);
+
     void renderBatch();
 
   private:
@@ -111,6 +123,7 @@ namespace JAGEngine {
     void createVertexArray();
     void sortGlyphs();
     void createWhiteTexture();
+    void deleteGLObjects();
 
     static bool compareFrontToBack(Glyph* a, Glyph* b);
     static bool compareBackToFront(Glyph* a, Glyph* b);
@@ -124,7 +137,8 @@ namespace JAGEngine {
     std::vector<Glyph*> _glyphPointers; //for sorting
     std::vector<Glyph> _glyphs; //aCTUAL GLYPHS
     std::vector<RenderBatch> _renderBatches;
+    std::vector<Vertex> _vertices; // staging for the VBO upload, kept between frames
 
-    GLuint m_whiteTexture;
+    GLuint m_whiteTexture; ///< Stands in for texture 0, made the first time one is drawn
   };
 }
@@ -2,11 +2,112 @@
 
 #include "SpriteFont.h"
 #include "SpriteBatch.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 
 namespace JAGEngine {
 
+  namespace {
+    uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+      // FNV-1a
+      const unsigned char* bytes = static_cast<const unsigned char*>(data);
+      for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+      }
+      return hash;
+    }
+
+    uint64_t hashLayout(const char* s, size_t length, glm::vec2 scaling, float depth, ColorRGBA8 tint, Justification just) {
+      uint64_t hash = 14695981039346656037ull;
+      hash = hashBytes(hash, s, length);
+      hash = hashBytes(hash, &scaling, sizeof(scaling));
+      hash = hashBytes(hash, &depth, sizeof(depth));
+      hash = hashBytes(hash, &tint, sizeof(tint));
+      hash = hashBytes(hash, &just, sizeof(just));
+      return hash;
+    }
+
+    float justifyOffset(Justification just, float width, float scaleX) {
+      if (just == Justification::MIDDLE) {
+        return -width * scaleX / 2;
+      }
+      if (just == Justification::RIGHT) {
+        return -width * scaleX;
+      }
+      return 0.0f;
+    }
+  }
+
+  void TextLayout::setText(SpriteFont& font, const char* s, glm::vec2 scaling, float depth,
+    ColorRGBA8 tint, Justification just) {
+
+    bool sameStyle = m_font == &font && m_scaling == scaling && m_depth == depth &&
+      m_tint.r == tint.r && m_tint.g == tint.g && m_tint.b == tint.b && m_tint.a == tint.a;
+
+    // Only the tail after the first changed character needs new glyphs
+    size_t start = 0;
+    if (sameStyle) {
+      size_t length = m_text.size();
+      while (start < length && s[start] == m_text[start]) {
+        start++;
+      }
+      if (start == length && s[start] == '\0') {
+        m_just = just;
+        return;
+      }
+    }
+
+    m_font = &font;
+    m_scaling = scaling;
+    m_depth = depth;
+    m_tint = tint;
+    m_just = just;
+    m_text.assign(s);
+
+    float penX = 0.0f;
+    if (start == 0) {
+      m_glyphs.clear();
+    }
+    else if (start < m_firstGlyph.size()) {
+      penX = m_penX[start];
+      m_glyphs.resize(m_firstGlyph[start]);
+    }
+    else {
+      // Old text is a prefix of the new one, keep every glyph
+      penX = m_width;
+    }
+    m_firstGlyph.resize(start);
+    m_penX.resize(start);
+
+    font.layoutFrom(*this, start, penX);
+  }
+
+  void TextLayout::draw(SpriteBatch& batch, glm::vec2 position) {
+    if (m_glyphs.empty()) return;
+
+    position.x += justifyOffset(m_just, m_width, m_scaling.x);
+    if (position != m_origin) {
+      glm::vec2 offset = position - m_origin;
+      for (Glyph& glyph : m_glyphs) {
+        glyph.translate(offset);
+      }
+      m_origin = position;
+    }
+    batch.drawGlyphs(m_glyphs.data(), m_glyphs.size());
+  }
+
+  void TextLayout::clear() {
+    m_font = nullptr;
+    m_text.clear();
+    m_glyphs.clear();
+    m_firstGlyph.clear();
+    m_penX.clear();
+    m_width = 0.0f;
+  }
+
   SpriteFont::SpriteFont() : m_atlas(nullptr), m_font(nullptr), m_fontHeight(0), m_textureID(0) {}
 
   SpriteFont::SpriteFont(const char* font, int size) : m_atlas(nullptr), m_font(nullptr), m_fontHeight(0), m_textureID(0) {
@@ -73,15 +174,15 @@ namespace JAGEngine {
       char c = cache[i];
       ftgl::texture_glyph_t* glyph = ftgl::texture_font_get_glyph(m_font, &c);
       if (glyph) {
-        m_glyphMap[c] = glyph;
+        m_glyphTable[(unsigned char)c] = glyph;
       }
     }
     // After loading glyphs
     if (DEBUG_OUTPUT) {
-      for (const auto& pair : m_glyphMap) {
-        auto glyph = pair.second;
-        if (DEBUG_OUTPUT) {
-          std::cout << "Glyph '" << pair.first << "' UV coords: "
+      for (int c = 0; c < 128; c++) {
+        auto glyph = m_glyphTable[c];
+        if (glyph) {
+          std::cout << "Glyph '" << (char)c << "' UV coords: "
             << glyph->s0 << ", " << glyph->t0 << ", "
             << glyph->s1 << ", " << glyph->t1 << std::endl;
         }
@@ -103,7 +204,8 @@ namespace JAGEngine {
       ftgl::texture_atlas_delete(m_atlas);
       m_atlas = nullptr;
     }
-    m_glyphMap.clear();
+    std::fill(std::begin(m_glyphTable), std::end(m_glyphTable), nullptr);
+    m_layoutCache.clear();
   }
 
   int SpriteFont::getFontHeight() const {
@@ -114,9 +216,8 @@ namespace JAGEngine {
     glm::vec2 size(0, m_fontHeight);
     float xpos = 0;
     for (int i = 0; s[i] != 0; i++) {
-      auto it = m_glyphMap.find(s[i]);
-      if (it != m_glyphMap.end()) {
-        ftgl::texture_glyph_t* glyph = it->second;
+      const ftgl::texture_glyph_t* glyph = getGlyph(s[i]);
+      if (glyph) {
         xpos += glyph->advance_x;
       }
     }
@@ -140,42 +241,76 @@ namespace JAGEngine {
       return;
     }
 
-    glm::vec2 pen = position;
+    m_drawCounter++;
+    size_t length = strlen(s);
+    uint64_t key = hashLayout(s, length, scaling, depth, tint, just);
 
-    // Apply justification
-    if (just == Justification::MIDDLE) {
-      pen.x -= measure(s).x * scaling.x / 2;
+    auto it = m_layoutCache.find(key);
+    if (it == m_layoutCache.end()) {
+      if (m_layoutCache.size() >= MAX_CACHED_LAYOUTS) {
+        evictLayouts();
+      }
+      it = m_layoutCache.emplace(key, CachedLayout()).first;
     }
-    else if (just == Justification::RIGHT) {
-      pen.x -= measure(s).x * scaling.x;
+
+    CachedLayout& cached = it->second;
+    cached.lastUsed = m_drawCounter;
+    // On a hash collision this just relays the text out, which is still correct
+    if (cached.layout.m_font != this || cached.layout.m_text.size() != length ||
+      memcmp(cached.layout.m_text.data(), s, length) != 0) {
+      cached.layout.setText(*this, s, scaling, depth, tint, just);
     }
+    cached.layout.draw(batch, position);
+  }
 
-    float baseline = pen.y;
+  void SpriteFont::layoutFrom(TextLayout& layout, size_t start, float penX) const {
+    const std::string& text = layout.m_text;
+    const glm::vec2 scaling = layout.m_scaling;
+    const glm::vec2 origin = layout.m_origin;
 
-    for (const char* p = s; *p; ++p) {
-      auto it = m_glyphMap.find(*p);
-      if (it != m_glyphMap.end()) {
-        ftgl::texture_glyph_t* glyph = it->second;
-        float x = pen.x + glyph->offset_x * scaling.x;
-        float y = baseline - (glyph->height - glyph->offset_y) * scaling.y;
-        float w = glyph->width * scaling.x;
-        float h = glyph->height * scaling.y;
+    layout.m_glyphs.reserve(text.size());
+    for (size_t i = start; i < text.size(); i++) {
+      layout.m_firstGlyph.push_back((uint32_t)layout.m_glyphs.size());
+      layout.m_penX.push_back(penX);
 
-        glm::vec4 destRect(x, y, w, h);
-        glm::vec4 uvRect(glyph->s0, glyph->t0, glyph->s1 - glyph->s0, glyph->t1 - glyph->t0);
+      const ftgl::texture_glyph_t* glyph = getGlyph(text[i]);
+      if (!glyph) continue;
 
-        if (DEBUG_OUTPUT) {
-          std::cout << "  Glyph '" << *p << "' at: " << destRect.x << ", " << destRect.y
-            << " size: " << destRect.z << "x" << destRect.w
-            << " UV: " << uvRect.x << ", " << uvRect.y << ", " << uvRect.z << ", " << uvRect.w
-            << " Texture ID: " << m_textureID << std::endl;
-        }
+      // Laid out relative to the layout's current origin so the untouched glyphs still line up
+      float x = origin.x + (penX + glyph->offset_x) * scaling.x;
+      float y = origin.y - (glyph->height - glyph->offset_y) * scaling.y;
+      float w = glyph->width * scaling.x;
+      float h = glyph->height * scaling.y;
 
-        // TODO: REMOVE
-        batch.draw(destRect, uvRect, m_textureID, depth, tint);
+      glm::vec4 destRect(x, y, w, h);
+      glm::vec4 uvRect(glyph->s0, glyph->t0, glyph->s1 - glyph->s0, glyph->t1 - glyph->t0);
 
-        pen.x += glyph->advance_x * scaling.x;
+      if (DEBUG_OUTPUT) {
+        std::cout << "  Glyph '" << text[i] << "' at: " << destRect.x << ", " << destRect.y
+          << " size: " << destRect.z << "x" << destRect.w
+          << " UV: " << uvRect.x << ", " << uvRect.y << ", " << uvRect.z << ", " << uvRect.w
+          << " Texture ID: " << m_textureID << std::endl;
       }
+
+      layout.m_glyphs.emplace_back(destRect, uvRect, m_textureID, layout.m_depth, layout.m_tint);
+      penX += glyph->advance_x;
+    }
+    layout.m_width = penX;
+  }
+
+  void SpriteFont::evictLayouts() {
+    // Drop everything that wasn't drawn recently, or everything if it was all recent
+    size_t before = m_layoutCache.size();
+    for (auto it = m_layoutCache.begin(); it != m_layoutCache.end();) {
+      if (m_drawCounter - it->second.lastUsed > MAX_CACHED_LAYOUTS) {
+        it = m_layoutCache.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+    if (m_layoutCache.size() == before) {
+      m_layoutCache.clear();
     }
   }
 
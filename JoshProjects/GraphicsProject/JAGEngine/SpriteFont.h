@@ -25,14 +25,17 @@
 #define SpriteFont_h__
 
 #include <glm/glm.hpp>
-#include <map>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "Vertex.h"
+#include "SpriteBatch.h"
 #include <GL/freetype-gl.h>
 
 namespace JAGEngine {
 
-  class SpriteBatch;
+  class SpriteFont;
 
 #define FIRST_PRINTABLE_CHAR ((char)32)
 #define LAST_PRINTABLE_CHAR ((char)126)
@@ -42,6 +45,41 @@ namespace JAGEngine {
     LEFT, MIDDLE, RIGHT
   };
 
+  /// A laid out run of text glyphs that can be redrawn without touching the font.
+  /// Keep one around for text that changes every frame (timers, counters): setText()
+  /// only rebuilds glyphs from the first character that differs from last time, and
+  /// moving or re-justifying the text just offsets the existing glyphs.
+  class TextLayout {
+  public:
+    void setText(SpriteFont& font, const char* s, glm::vec2 scaling, float depth,
+      ColorRGBA8 tint, Justification just = Justification::LEFT);
+
+    void draw(SpriteBatch& batch, glm::vec2 position);
+
+    void clear();
+
+    const std::string& getText() const { return m_text; }
+    /// Unscaled width, same as SpriteFont::measure(getText()).x
+    float getWidth() const { return m_width; }
+    size_t getGlyphCount() const { return m_glyphs.size(); }
+
+  private:
+    friend class SpriteFont;
+
+    SpriteFont* m_font = nullptr;
+    std::string m_text;
+    glm::vec2 m_scaling = glm::vec2(1.0f);
+    float m_depth = 0.0f;
+    ColorRGBA8 m_tint;
+    Justification m_just = Justification::LEFT;
+
+    std::vector<Glyph> m_glyphs;
+    std::vector<uint32_t> m_firstGlyph; ///< Index into m_glyphs for each character
+    std::vector<float> m_penX;          ///< Unscaled pen position before each character
+    float m_width = 0.0f;
+    glm::vec2 m_origin = glm::vec2(0.0f); ///< Where the glyphs currently sit
+  };
+
   class SpriteFont {
   public:
     SpriteFont();
@@ -58,21 +96,45 @@ namespace JAGEngine {
     /// Measures the dimensions of the text
     glm::vec2 measure(const char* s);
 
-    /// Draws using a spritebatch
+    /// Draws using a spritebatch. Layouts are cached per string, so static labels only
+    /// get laid out once; use a TextLayout for text that changes often.
     void draw(SpriteBatch& batch, const char* s, glm::vec2 position, glm::vec2 scaling,
       float depth, ColorRGBA8 tint, Justification just = Justification::LEFT);
 
+    /// Drops every cached layout
+    void clearLayoutCache() { m_layoutCache.clear(); }
+
     //getters
     GLuint getTextureID() const { return m_textureID; }
     int getFontHeight() const;
 
 
   private:
+    friend class TextLayout;
+
     static constexpr bool DEBUG_OUTPUT = false;
+    static constexpr size_t MAX_CACHED_LAYOUTS = 256;
+
+    struct CachedLayout {
+      TextLayout layout;
+      uint32_t lastUsed = 0;
+    };
+
+    const ftgl::texture_glyph_t* getGlyph(char c) const {
+      unsigned char index = (unsigned char)c;
+      return index < 128 ? m_glyphTable[index] : nullptr;
+    }
+
+    /// Appends the glyphs for s[start..] to the layout, starting at pen position penX
+    void layoutFrom(TextLayout& layout, size_t start, float penX) const;
+    void evictLayouts();
 
     ftgl::texture_atlas_t* m_atlas;
     ftgl::texture_font_t* m_font;
-    std::map<char, ftgl::texture_glyph_t*> m_glyphMap;
+    ftgl::texture_glyph_t* m_glyphTable[128] = {};
+
+    std::unordered_map<uint64_t, CachedLayout> m_layoutCache;
+    uint32_t m_drawCounter = 0;
 
     int m_fontHeight;
     GLuint m_textureID; 
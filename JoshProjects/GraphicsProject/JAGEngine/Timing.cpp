@@ -3,7 +3,7 @@
 #include "Timing.h"
 #include <SDL/SDL.h>
 namespace JAGEngine {
-  FpsLimiter::FpsLimiter() {
+  FpsLimiter::FpsLimiter() : m_fps(0.0f), m_maxFPS(0.0f), _frameTime(0.0f), _startTicks(0) {
 
   }
   void FpsLimiter::init(float maxFPS) {
@@ -22,8 +22,8 @@ namespace JAGEngine {
     calculateFPS();
     float frameTicks = SDL_GetTicks() - _startTicks;
 
-    //limit fps
-    if (1000.0F / m_maxFPS > frameTicks) {
+    //limit fps, 0 means uncapped
+    if (m_maxFPS > 0.0f && 1000.0F / m_maxFPS > frameTicks) {
       SDL_Delay(1000.0F / m_maxFPS - frameTicks);
     }
 
@@ -55,6 +55,9 @@ namespace JAGEngine {
         // Initialize Memory Manager
         AkMemSettings memSettings;
         AK::MemoryMgr::GetDefaultSettings(memSettings);
+        if (m_memoryBudget > 0) {
+            memSettings.uMemAllocationSizeLimit = m_memoryBudget;
+        }
         if (AK::MemoryMgr::Init(&memSettings) != AK_Success) {
             std::cout << "AK: Memory Manager Failed to Initialize." << std::endl;
             return false;
@@ -73,7 +76,10 @@ namespace JAGEngine {
         // Initialize Streaming Device
         AkDeviceSettings deviceSettings;
         AK::StreamMgr::GetDefaultDeviceSettings(deviceSettings);
-        if (m_lowLevelIO.Init(deviceSettings) != AK_Success) {
+        if (!m_lowLevelIO) {
+            m_lowLevelIO = std::make_unique<FilePackageLowLevelIO>();
+        }
+        if (m_lowLevelIO->init(deviceSettings) != AK_Success) {
             std::cout << "AK: Could not create the streaming device and Low-Level I/O system." << std::endl;
             return false;
         }
@@ -92,7 +98,7 @@ namespace JAGEngine {
         std::cout << "AK: Sound Engine Initialized!" << std::endl;
 
         // Set up bank path and language
-        m_lowLevelIO.SetBasePath(m_bankPath);
+        m_lowLevelIO->setBasePath(m_bankPath);
         AK::StreamMgr::SetCurrentLanguage(AKTEXT("English(US)"));
 
         // Now load the banks
@@ -145,15 +151,196 @@ namespace JAGEngine {
 
     void WWiseAudioEngine::update() {
         if (m_isInitialized) {
+            applyCompletedRequests();
             AK::SoundEngine::RenderAudio();
+
+            // Memory stats walk every pool, no need to do it each frame
+            if (m_frameCounter++ % 30 == 0) {
+                updateMemoryStats();
+            }
+        }
+    }
+
+    void WWiseAudioEngine::acquireBank(const char* bankName) {
+        LoadEntry& entry = m_banks[bankName];
+        if (entry.refCount++ == 0 && (entry.state == LoadState::Unloaded || entry.state == LoadState::Failed)) {
+            startRequest(entry, false, bankName, AK_INVALID_UNIQUE_ID, true);
+        }
+        // Loading / Loaded: nothing to do. Unloading: reloaded once the unload finishes.
+    }
+
+    void WWiseAudioEngine::releaseBank(const char* bankName) {
+        auto it = m_banks.find(bankName);
+        if (it == m_banks.end() || it->second.refCount == 0) {
+            std::cout << "AK: Released bank " << bankName << " more times than it was acquired." << std::endl;
+            return;
+        }
+
+        LoadEntry& entry = it->second;
+        if (--entry.refCount > 0) return;
+        if (entry.state == LoadState::Loaded) {
+            startRequest(entry, false, bankName, AK_INVALID_UNIQUE_ID, false);
         }
+        else if (entry.state == LoadState::Failed) {
+            entry.state = LoadState::Unloaded;
+        }
+        // Loading: unloaded once the load finishes
+    }
+
+    bool WWiseAudioEngine::isBankLoaded(const char* bankName) const {
+        auto it = m_banks.find(bankName);
+        return it != m_banks.end() && it->second.state == LoadState::Loaded;
+    }
+
+    void WWiseAudioEngine::acquireEvent(AkUniqueID eventId) {
+        LoadEntry& entry = m_events[eventId];
+        if (entry.refCount++ == 0 && (entry.state == LoadState::Unloaded || entry.state == LoadState::Failed)) {
+            startRequest(entry, true, "", eventId, true);
+        }
+    }
+
+    void WWiseAudioEngine::releaseEvent(AkUniqueID eventId) {
+        auto it = m_events.find(eventId);
+        if (it == m_events.end() || it->second.refCount == 0) {
+            std::cout << "AK: Released event " << eventId << " more times than it was acquired." << std::endl;
+            return;
+        }
+
+        LoadEntry& entry = it->second;
+        if (--entry.refCount > 0) return;
+        if (entry.state == LoadState::Loaded) {
+            startRequest(entry, true, "", eventId, false);
+        }
+        else if (entry.state == LoadState::Failed) {
+            entry.state = LoadState::Unloaded;
+        }
+    }
+
+    bool WWiseAudioEngine::isEventPrepared(AkUniqueID eventId) const {
+        auto it = m_events.find(eventId);
+        return it != m_events.end() && it->second.state == LoadState::Loaded;
+    }
+
+    void WWiseAudioEngine::startRequest(LoadEntry& entry, bool isEvent, const std::string& bankName, AkUniqueID eventId, bool isLoad) {
+        PendingRequest* request = new PendingRequest{ this, isEvent, isLoad, bankName, eventId, AK_Success };
+
+        AKRESULT result;
+        if (isEvent) {
+            AK::SoundEngine::PreparationType type = isLoad ? AK::SoundEngine::Preparation_Load : AK::SoundEngine::Preparation_Unload;
+            result = AK::SoundEngine::PrepareEvent(type, &request->eventId, 1, &WWiseAudioEngine::onRequestDone, request);
+        }
+        else if (isLoad) {
+            AkBankID bankId;
+            result = AK::SoundEngine::LoadBank(request->bankName.c_str(), &WWiseAudioEngine::onRequestDone, request, bankId);
+        }
+        else {
+            result = AK::SoundEngine::UnloadBank(request->bankName.c_str(), nullptr, &WWiseAudioEngine::onRequestDone, request);
+        }
+
+        if (result != AK_Success) {
+            // Never queued, so the callback won't come
+            std::cout << "AK: Could not queue " << (isLoad ? "load" : "unload") << " of "
+                << (isEvent ? "event " + std::to_string(eventId) : "bank " + bankName)
+                << ". Error code: " << result << std::endl;
+            delete request;
+            entry.state = isLoad ? LoadState::Failed : LoadState::Unloaded;
+            return;
+        }
+
+        entry.state = isLoad ? LoadState::Loading : LoadState::Unloading;
+        m_memoryStats.pending++;
+    }
+
+    // Runs on Wwise's bank thread
+    void WWiseAudioEngine::onRequestDone(AkUInt32 bankId, const void* inMemoryBankPtr, AKRESULT result, void* cookie) {
+        PendingRequest* request = static_cast<PendingRequest*>(cookie);
+        request->result = result;
+
+        std::lock_guard<std::mutex> lock(request->engine->m_completedMutex);
+        request->engine->m_completed.push_back(request);
+    }
+
+    void WWiseAudioEngine::applyCompletedRequests() {
+        std::vector<PendingRequest*> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            if (m_completed.empty()) return;
+            completed.swap(m_completed);
+        }
+
+        for (PendingRequest* request : completed) {
+            m_memoryStats.pending--;
+            LoadEntry& entry = request->isEvent ? m_events[request->eventId] : m_banks[request->bankName];
+
+            if (request->isLoad) {
+                if (request->result != AK_Success) {
+                    std::cout << "AK: Failed to load "
+                        << (request->isEvent ? "event " + std::to_string(request->eventId) : "bank " + request->bankName)
+                        << ". Error code: " << request->result << std::endl;
+                    entry.state = entry.refCount > 0 ? LoadState::Failed : LoadState::Unloaded;
+                }
+                else {
+                    entry.state = LoadState::Loaded;
+                    // Released while it was loading
+                    if (entry.refCount == 0) {
+                        startRequest(entry, request->isEvent, request->bankName, request->eventId, false);
+                    }
+                }
+            }
+            else {
+                entry.state = LoadState::Unloaded;
+                // Acquired again while it was unloading
+                if (entry.refCount > 0) {
+                    startRequest(entry, request->isEvent, request->bankName, request->eventId, true);
+                }
+            }
+            delete request;
+        }
+    }
+
+    void WWiseAudioEngine::updateMemoryStats() {
+        AkMemGlobalStats globalStats;
+        AK::MemoryMgr::GetGlobalStats(globalStats);
+        m_memoryStats.used = globalStats.uUsed;
+        m_memoryStats.peak = globalStats.uMax;
+        m_memoryStats.budget = m_memoryBudget;
+
+        m_memoryStats.banksLoaded = 0;
+        for (const auto& pair : m_banks) {
+            if (pair.second.state == LoadState::Loaded) m_memoryStats.banksLoaded++;
+        }
+        m_memoryStats.eventsPrepared = 0;
+        for (const auto& pair : m_events) {
+            if (pair.second.state == LoadState::Loaded) m_memoryStats.eventsPrepared++;
+        }
+
+        // Only warn when it first goes over, not every time the stats are refreshed
+        bool overBudget = m_memoryBudget > 0 && m_memoryStats.used > m_memoryBudget * 9 / 10;
+        if (overBudget && !m_reportedOverBudget) {
+            std::cout << "AK: Audio memory at " << m_memoryStats.used / (1024 * 1024) << " MB of the "
+                << m_memoryBudget / (1024 * 1024) << " MB budget (" << m_memoryStats.banksLoaded << " banks, "
+                << m_memoryStats.eventsPrepared << " prepared events)." << std::endl;
+        }
+        m_reportedOverBudget = overBudget;
     }
 
     void WWiseAudioEngine::cleanup() {
         if (m_isInitialized) {
             AK::SoundEngine::Term();
 
-            m_lowLevelIO.Term();
+            // Term flushes the bank queue, anything left over is never getting applied
+            {
+                std::lock_guard<std::mutex> lock(m_completedMutex);
+                for (PendingRequest* request : m_completed) {
+                    delete request;
+                }
+                m_completed.clear();
+            }
+            m_banks.clear();
+            m_events.clear();
+            m_memoryStats = MemoryStats();
+
+            m_lowLevelIO->term();
             if (AK::IAkStreamMgr::Get())
                 AK::IAkStreamMgr::Get()->Destroy();
 
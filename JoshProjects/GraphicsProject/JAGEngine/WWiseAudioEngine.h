@@ -11,7 +11,11 @@
 #include <AkFilePackage.h>
 #include <AkFilePackageLUT.h>
 #include <Wwise_IDs.h>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // Default paths - will be overridden if provided in init()
 #define DEFAULT_WWISE_BANK_PATH AKTEXT("../WwiseProjects/RacingGame/GeneratedSoundBanks/Windows/")
@@ -19,6 +23,30 @@
 #define DEFAULT_BANKNAME_MAIN L"Main.bnk"
 
 namespace JAGEngine {
+    // The streaming device and file lookup Wwise reads banks through. A test can hand
+    // WWiseAudioEngine its own to serve banks from memory, hold loads back or fail them,
+    // and drive the bank bookkeeping without anything on disk.
+    class AudioLowLevelIO {
+    public:
+        virtual ~AudioLowLevelIO() = default;
+
+        // Creates the device with the stream manager and registers the file resolver
+        virtual AKRESULT init(const AkDeviceSettings& deviceSettings) = 0;
+        virtual void setBasePath(const AkOSChar* bankPath) = 0;
+        virtual void term() = 0;
+    };
+
+    // Reads banks from files (or file packages) under the bank path
+    class FilePackageLowLevelIO : public AudioLowLevelIO {
+    public:
+        AKRESULT init(const AkDeviceSettings& deviceSettings) override { return m_io.Init(deviceSettings); }
+        void setBasePath(const AkOSChar* bankPath) override { m_io.SetBasePath(bankPath); }
+        void term() override { m_io.Term(); }
+
+    private:
+        CAkFilePackageLowLevelIODeferred m_io;
+    };
+
     class WWiseAudioEngine
     {
     public:
@@ -41,20 +69,85 @@ namespace JAGEngine {
         void cleanup();
         bool isInitialized() const { return m_isInitialized; }
 
+        // ==========================================================
+        // Banks and prepared events
+        // ==========================================================
+        //
+        // Both are reference counted. The first acquire starts an async LoadBank /
+        // PrepareEvent and the last release starts the matching unload, so a level can
+        // ask for what it needs on entry and give it back on exit without waiting on
+        // disk. Completions arrive on Wwise's bank thread and are applied in update().
+
+        struct MemoryStats {
+            AkUInt64 used = 0;
+            AkUInt64 peak = 0;
+            AkUInt64 budget = 0;   // 0 when no budget is set
+            int banksLoaded = 0;
+            int eventsPrepared = 0;
+            int pending = 0;       // Loads and unloads still in flight
+        };
+
+        // Caps Wwise's total allocations. Has to be set before init().
+        void setMemoryBudget(AkUInt64 bytes) { m_memoryBudget = bytes; }
+        // Replaces the file I/O banks are read through. Has to be set before init().
+        void setLowLevelIO(std::unique_ptr<AudioLowLevelIO> lowLevelIO) { m_lowLevelIO = std::move(lowLevelIO); }
+        const MemoryStats& getMemoryStats() const { return m_memoryStats; }
+
+        void acquireBank(const char* bankName);
+        void releaseBank(const char* bankName);
+        bool isBankLoaded(const char* bankName) const;
+
+        void acquireEvent(AkUniqueID eventId);
+        void releaseEvent(AkUniqueID eventId);
+        bool isEventPrepared(AkUniqueID eventId) const;
+
+        // True while any load or unload is in flight
+        bool isLoading() const { return m_memoryStats.pending > 0; }
+
         // Getters for current paths
         const AkOSChar* getBankPath() const { return m_bankPath; }
         const wchar_t* getInitBankName() const { return m_initBankName; }
         const wchar_t* getMainBankName() const { return m_mainBankName; }
 
     private:
+        enum class LoadState { Unloaded, Loading, Loaded, Unloading, Failed };
+
+        struct LoadEntry {
+            int refCount = 0;
+            LoadState state = LoadState::Unloaded;
+        };
+
+        // Passed to Wwise as the callback cookie and handed back through m_completed
+        struct PendingRequest {
+            WWiseAudioEngine* engine;
+            bool isEvent;
+            bool isLoad;
+            std::string bankName;
+            AkUniqueID eventId;
+            AKRESULT result;
+        };
+
+        static void onRequestDone(AkUInt32 bankId, const void* inMemoryBankPtr, AKRESULT result, void* cookie);
+        void applyCompletedRequests();
+        void startRequest(LoadEntry& entry, bool isEvent, const std::string& bankName, AkUniqueID eventId, bool isLoad);
+        void updateMemoryStats();
+
         // Common initialization code shared by all init methods
         bool initializeEngine();
         bool loadBanks();
 
         bool m_isInitialized = false;
-        CAkFilePackageLowLevelIODeferred m_lowLevelIO;
+        std::unique_ptr<AudioLowLevelIO> m_lowLevelIO;
         uint32_t m_frameCounter = 0;
 
+        std::unordered_map<std::string, LoadEntry> m_banks;
+        std::unordered_map<AkUniqueID, LoadEntry> m_events;
+        std::mutex m_completedMutex;
+        std::vector<PendingRequest*> m_completed;
+        AkUInt64 m_memoryBudget = 0;
+        MemoryStats m_memoryStats;
+        bool m_reportedOverBudget = false;
+
         // Paths storage
         AkOSChar m_bankPath[256];
         wchar_t m_initBankName[64];
@@ -409,7 +409,7 @@ glm::vec2 AIDriver::findClosestSplinePoint() const {
   auto debugInfo = m_car->getDebugInfo();
   glm::vec2 carPos(debugInfo.position);
 
-  auto splinePoints = m_car->getTrack()->getSplinePoints(200);
+  const auto& splinePoints = m_car->getTrack()->getSplinePoints(200);
   float minDist = std::numeric_limits<float>::max();
   glm::vec2 closestPoint;
 
@@ -438,7 +438,7 @@ glm::vec2 AIDriver::calculateLookAheadPoint() const {
   // Cap maximum lookahead to prevent looking too far ahead
   adjustedLookAhead = glm::clamp(adjustedLookAhead, 50.0f, 350.0f);
 
-  auto splinePoints = m_car->getTrack()->getSplinePoints(200);
+  const auto& splinePoints = m_car->getTrack()->getSplinePoints(200);
   bool isClockwise = !m_car->getTrack()->isDefaultDirection();
 
   // Find closest point index
@@ -629,22 +629,13 @@ void AIDriver::scanForObjects() {
   glm::vec2 carPos(debugInfo.position);
   glm::vec2 carForward(std::cos(debugInfo.angle), std::sin(debugInfo.angle));
 
-  // Keep track of already detected object pointers
-  std::set<const PlaceableObject*> detectedObjects;
-
+  // getNearbyObjects already returns each object once
   auto nearbyObjects = m_objectManager->getNearbyObjects(carPos, SensorData::SENSOR_RANGE);
   if (DEBUG_OUTPUT) {
     std::cout << "Found " << nearbyObjects.size() << " nearby objects" << std::endl;
   }
 
   for (const auto* obj : nearbyObjects) {
-    if (detectedObjects.find(obj) != detectedObjects.end()) {
-      if (DEBUG_OUTPUT) {
-        std::cout << "Skipping already detected object" << std::endl;
-      }
-      continue;
-    }
-
     float pathDistance, pathAngle;
     if (isObjectInPath(obj->getPosition(), 10.0f, carPos, carForward, &pathDistance, &pathAngle)) {
       if (pathDistance < SensorData::SENSOR_RANGE) {
@@ -660,8 +651,6 @@ void AIDriver::scanForObjects() {
         reading.angleToObject = pathAngle;
         reading.isLeftSide = pathAngle > 0;
         m_sensorData.readings.push_back(reading);
-
-        detectedObjects.insert(obj);
       }
     }
   }
@@ -825,7 +814,7 @@ void AIDriver::updateStuckState(float deltaTime) {
 glm::vec2 AIDriver::getTrackDirectionAtPosition(const glm::vec2& position) const {
   if (!m_car || !m_car->getTrack()) return glm::vec2(1.0f, 0.0f);
 
-  auto splinePoints = m_car->getTrack()->getSplinePoints(200);
+  const auto& splinePoints = m_car->getTrack()->getSplinePoints(200);
   size_t closestIdx = 0;
   float minDist = FLT_MAX;
 
@@ -29,10 +29,14 @@ bool AudioEngine::init() {
   std::cout << "Initializing Racing Audio Engine...\n";
 
   m_audioEngine = std::make_unique<JAGEngine::WWiseAudioEngine>();
+  m_audioEngine->setMemoryBudget(RacingAudio::AUDIO_MEMORY_BUDGET);
   if (!m_audioEngine->init()) {
     std::cout << "Failed to initialize base audio engine!\n";
     return false;
   }
+  if (!m_carBackend) {
+    m_carBackend = std::make_unique<WwiseCarAudioBackend>();
+  }
 
   // Initialize racing-specific audio settings
   std::cout << "Registering audio game objects...\n";
@@ -270,16 +274,10 @@ void AudioEngine::setTireSurfaceType(int surfaceType) {
   m_currentSurfaceType = surfaceType;
 }
 
-void AudioEngine::updateTireSkidSound(Car* car, float speedRatio, float driftState) {
-  auto it = m_carAudioIds.find(car);
-  if (it == m_carAudioIds.end()) return;
-
-  AkGameObjectID audioId = it->second;
-  static std::unordered_map<Car*, bool> isSkidPlaying;
-
+void AudioEngine::updateTireSkidSound(CarAudioData& data, float speedRatio, float driftState) {
   // Calculate surface ratios
   std::array<int, 5> surfaceCounts = { 0, 0, 0, 0, 0 };
-  const auto& wheelStates = car->getWheelStates();
+  const auto& wheelStates = data.car->getWheelStates();
   for (const auto& state : wheelStates) {
     surfaceCounts[static_cast<int>(state.surface)]++;
   }
@@ -289,51 +287,62 @@ void AudioEngine::updateTireSkidSound(Car* car, float speedRatio, float driftSta
   float grassRatio = (surfaceCounts[4] + surfaceCounts[3] * 0.5f) / 4.0f;
 
   if (dirtRatio > 0.0f || grassRatio > 0.0f || driftState > 0.0f) {
-    if (!isSkidPlaying[car]) {
-      AK::SoundEngine::PostEvent(AK::EVENTS::PLAY_CAR_TIRE_SKID_1, audioId);
-      isSkidPlaying[car] = true;
+    if (!data.isSkidPlaying) {
+      m_carBackend->postEvent(AK::EVENTS::PLAY_CAR_TIRE_SKID_1, data.audioId);
+      data.isSkidPlaying = true;
     }
 
     // Road skid with master volume
-    float skidVolume = std::pow(driftState, 2.0f) * 100.0f;
+    float driftSquared = driftState * driftState;
+    float skidVolume = driftSquared * 100.0f;
     float roadVolume = skidVolume * roadRatio;
-    AK::SoundEngine::SetRTPCValue("Tire_Road_Volume", roadVolume, audioId);
-    AK::SoundEngine::SetRTPCValue("Tire_Skid_Volume", skidVolume, audioId);
+    setCarRtpc(data, RTPC_TIRE_ROAD_VOLUME, roadVolume);
+    setCarRtpc(data, RTPC_TIRE_SKID_VOLUME, skidVolume);
 
     // Speed-based volume for dirt/grass (50% of max)
     float speedVolume = 50.0f * std::sqrt(speedRatio);
     // Additional volume when drifting (50% of max)
-    float addSkidVolume = 50.0f * std::pow(driftState, 2.0f);
+    float addSkidVolume = 50.0f * driftSquared;
 
-    AK::SoundEngine::SetRTPCValue("Tire_Dirt_Volume", (speedVolume + addSkidVolume) * dirtRatio, audioId);
-    AK::SoundEngine::SetRTPCValue("Tire_Grass_Volume", (speedVolume + addSkidVolume) * grassRatio, audioId);
-    AK::SoundEngine::SetRTPCValue("Tire_Skid_Pitch", speedRatio * 100.0f, audioId);
+    setCarRtpc(data, RTPC_TIRE_DIRT_VOLUME, (speedVolume + addSkidVolume) * dirtRatio);
+    setCarRtpc(data, RTPC_TIRE_GRASS_VOLUME, (speedVolume + addSkidVolume) * grassRatio);
+    setCarRtpc(data, RTPC_TIRE_SKID_PITCH, speedRatio * 100.0f);
   }
-  else if (isSkidPlaying[car]) {
-    AK::SoundEngine::PostEvent(AK::EVENTS::STOP_CAR_TIRE_SKID_1, audioId);
-    isSkidPlaying[car] = false;
+  else if (data.isSkidPlaying) {
+    m_carBackend->postEvent(AK::EVENTS::STOP_CAR_TIRE_SKID_1, data.audioId);
+    data.isSkidPlaying = false;
   }
 }
 
-void AudioEngine::updateScrapeSound(Car* car) {
-  if (!car) return;
-  AkGameObjectID audioId = car->getAudioId();
-
+void AudioEngine::updateScrapeSound(CarAudioData& data) {
   // Check if the car is scraping
-  bool scraping = car->isScrapingBarrier();
+  bool scraping = data.car->isScrapingBarrier();
 
-  if (scraping && !m_isScrapePlaying[car]) {
+  if (scraping && !data.isScrapePlaying) {
     // Start the scrape loop if not already playing
-    AK::SoundEngine::PostEvent(AK::EVENTS::PLAY_SCRAPE_SFX, audioId);
-    m_isScrapePlaying[car] = true;
+    m_carBackend->postEvent(AK::EVENTS::PLAY_SCRAPE_SFX, data.audioId);
+    data.isScrapePlaying = true;
   }
-  else if (!scraping && m_isScrapePlaying[car]) {
+  else if (!scraping && data.isScrapePlaying) {
     // Stop the scrape loop if it is playing
-    AK::SoundEngine::PostEvent(AK::EVENTS::STOP_SCRAPE_SFX, audioId);
-    m_isScrapePlaying[car] = false;
+    m_carBackend->postEvent(AK::EVENTS::STOP_SCRAPE_SFX, data.audioId);
+    data.isScrapePlaying = false;
   }
 }
 
+// Skid and scrape only play on fully updated cars
+void AudioEngine::stopCarLoops(CarAudioData& data) {
+  if (data.isSkidPlaying) {
+    m_carBackend->postEvent(AK::EVENTS::STOP_CAR_TIRE_SKID_1, data.audioId);
+    data.isSkidPlaying = false;
+  }
+  if (data.isScrapePlaying) {
+    m_carBackend->postEvent(AK::EVENTS::STOP_SCRAPE_SFX, data.audioId);
+    data.isScrapePlaying = false;
+  }
+  data.car->setScrapingBarrier(false);
+}
+
 void AudioEngine::setDefaultListener(const Vec2& position, float rotation) {
   AkListenerPosition listenerPos;
 
@@ -416,11 +425,21 @@ void AudioEngine::setMusicVolume(float volume) {
   m_musicVolume = volume;
 }
 
+AudioEngine::CarAudioData* AudioEngine::findCarAudio(Car* car) {
+  if (!car) return nullptr;
+  int slot = car->getAudioSlot();
+  if (slot < 0 || slot >= static_cast<int>(m_carAudio.size()) || m_carAudio[slot].car != car) {
+    return nullptr;
+  }
+  return &m_carAudio[slot];
+}
+
 void AudioEngine::initializeCarAudio(Car* car) {
   if (!car) {
     std::cout << "ERROR: Null car when initializing car audio!" << std::endl;
     return;
   }
+  if (!m_carBackend) return;
 
   // Check if the car already has a valid audio ID.
   if (car->getAudioId() == AK_INVALID_GAME_OBJECT) {
@@ -430,25 +449,38 @@ void AudioEngine::initializeCarAudio(Car* car) {
   AkGameObjectID audioId = car->getAudioId();
   std::cout << "Initializing audio for car " << static_cast<unsigned>(audioId) << std::endl;
 
-  // Set up our car audio data.
+  // Set up our car audio data, reusing the slot if this car already has one.
+  CarAudioData* existing = findCarAudio(car);
+  if (!existing) {
+    car->setAudioSlot(static_cast<int>(m_carAudio.size()));
+    m_carAudio.emplace_back();
+    existing = &m_carAudio.back();
+  }
+  CarAudioData& audioData = *existing;
   auto info = car->getDebugInfo();
-  CarAudioData audioData;
+  audioData = CarAudioData();
+  audioData.car = car;
   audioData.audioId = audioId;
   audioData.lastPosition = Vec2(info.position.x, info.position.y);
   audioData.lastDistanceToListener = 0.0f;
-  m_carAudioData[car] = audioData;
+  audioData.sentRtpc.fill(NAN);
 
   // Register the car's game object with Wwise.
-  AKRESULT result = AK::SoundEngine::RegisterGameObj(audioId, "CarEngine");
+  bool registered = m_carBackend->registerObject(audioId, "CarEngine");
   if (DEBUG_OUTPUT) {
-    std::cout << "RegisterGameObj result: " << result << std::endl;
-    if (result != AK_Success) {
-      std::cout << "Failed to register car audio object. Result: " << result << std::endl;
+    if (!registered) {
+      std::cout << "Failed to register car audio object" << std::endl;
       return;
     }
     std::cout << "Successfully registered car audio object" << std::endl;
   }
 
+  startEngineLoops(audioData);
+}
+
+void AudioEngine::startEngineLoops(CarAudioData& data) {
+  AkGameObjectID audioId = data.audioId;
+
   // Generate random offsets for idle and rev sounds.
   float idleOffset = static_cast<float>(rand()) / RAND_MAX * 3.0f;  // 0 to 3 seconds
   float revOffset = static_cast<float>(rand()) / RAND_MAX * 3.0f;   // 0 to 3 seconds
@@ -457,17 +489,8 @@ void AudioEngine::initializeCarAudio(Car* car) {
   AkTimeMs idleSeekTime = static_cast<AkTimeMs>(idleOffset * 1000);
   AkTimeMs revSeekTime = static_cast<AkTimeMs>(revOffset * 1000);
 
-  // (Optional) Create playback position structures if needed.
-  AkSegmentInfo idleSegment;
-  idleSegment.iCurrentPosition = idleSeekTime;
-  AkSegmentInfo revSegment;
-  revSegment.iCurrentPosition = revSeekTime;
-
   // Start playing the idle sound (looping).
-  AkPlayingID idleId = AK::SoundEngine::PostEvent(
-    AK::EVENTS::PLAY_ENGINE_IDLE_SFX_1,
-    audioId
-  );
+  AkPlayingID idleId = m_carBackend->postEvent(AK::EVENTS::PLAY_ENGINE_IDLE_SFX_1, audioId);
   if (DEBUG_OUTPUT) {
     std::cout << "Posted idle sound event, ID: " << idleId
       << " Event ID: " << AK::EVENTS::PLAY_ENGINE_IDLE_SFX_1
@@ -477,19 +500,11 @@ void AudioEngine::initializeCarAudio(Car* car) {
     }
   }
   if (idleId != AK_INVALID_PLAYING_ID) {
-    AK::SoundEngine::SeekOnEvent(
-      AK::EVENTS::PLAY_ENGINE_IDLE_SFX_1,
-      audioId,
-      idleSeekTime,
-      false
-    );
+    m_carBackend->seekOnEvent(AK::EVENTS::PLAY_ENGINE_IDLE_SFX_1, audioId, idleSeekTime);
   }
 
   // Start playing the rev sound (initially at 0 volume).
-  AkPlayingID revId = AK::SoundEngine::PostEvent(
-    AK::EVENTS::PLAY_ENGINE_REV_SFX_1,
-    audioId
-  );
+  AkPlayingID revId = m_carBackend->postEvent(AK::EVENTS::PLAY_ENGINE_REV_SFX_1, audioId);
   if (DEBUG_OUTPUT) {
     std::cout << "Posted rev sound event, ID: " << revId
       << " Event ID: " << AK::EVENTS::PLAY_ENGINE_REV_SFX_1
@@ -499,56 +514,124 @@ void AudioEngine::initializeCarAudio(Car* car) {
     }
   }
   if (revId != AK_INVALID_PLAYING_ID) {
-    AK::SoundEngine::SeekOnEvent(
-      AK::EVENTS::PLAY_ENGINE_REV_SFX_1,
-      audioId,
-      revSeekTime,
-      false
-    );
+    m_carBackend->seekOnEvent(AK::EVENTS::PLAY_ENGINE_REV_SFX_1, audioId, revSeekTime);
   }
 
-  // Store the audio ID in our map.
-  m_carAudioIds[car] = audioId;
-  if (DEBUG_OUTPUT) {
-    std::cout << "Stored car audio ID in map" << std::endl;
-  }
-
-  // Set initial RTPC values.
-  AK::SoundEngine::SetRTPCValue("Engine_Idle_Volume", 100.0f, audioId);
-  AK::SoundEngine::SetRTPCValue("Engine_Rev_Volume", 0.0f, audioId);
-  AK::SoundEngine::SetRTPCValue("Engine_Rev_Pitch", 100.0f, audioId);  // Base pitch
+  // Set initial RTPC values. Everything else goes out again on the next update.
+  data.sentRtpc.fill(NAN);
+  setCarRtpc(data, RTPC_ENGINE_IDLE_VOLUME, 100.0f);
+  setCarRtpc(data, RTPC_ENGINE_REV_VOLUME, 0.0f);
+  setCarRtpc(data, RTPC_ENGINE_REV_PITCH, 100.0f);  // Base pitch
 
   if (DEBUG_OUTPUT) {
     std::cout << "Set initial volumes and pitch" << std::endl;
   }
 }
 
+void AudioEngine::setCarRtpc(CarAudioData& data, CarRtpc rtpc, float value) {
+  static const AkRtpcID RTPC_IDS[CAR_RTPC_COUNT] = {
+    AK::GAME_PARAMETERS::ENGINE_IDLE_VOLUME,
+    AK::GAME_PARAMETERS::ENGINE_REV_VOLUME,
+    AK::GAME_PARAMETERS::ENGINE_REV_PITCH,
+    AK::GAME_PARAMETERS::ENGINE_HIGHPASS_FILTER,
+    AK::GAME_PARAMETERS::ENGINE_REV_DOPPLER_EFFECT,
+    AK::GAME_PARAMETERS::TIRE_ROAD_VOLUME,
+    AK::GAME_PARAMETERS::TIRE_SKID_VOLUME,
+    AK::GAME_PARAMETERS::TIRE_DIRT_VOLUME,
+    AK::GAME_PARAMETERS::TIRE_GRASS_VOLUME,
+    AK::GAME_PARAMETERS::TIRE_SKID_PITCH
+  };
 
-void AudioEngine::updateCarAudio(Car* car, const Vec2& listenerPos) {
-  // Basic checks
-  if (!m_audioEngine) return;
-
-  // Get audio data
-  auto audioIt = m_carAudioIds.find(car);
-  auto dataIt = m_carAudioData.find(car);
-  if (audioIt == m_carAudioIds.end() || dataIt == m_carAudioData.end()) return;
+  if (!CarAudioLOD::shouldSendRtpc(data.sentRtpc[rtpc], value)) {
+    m_carAudioStats.rtpcSkipped++;
+    return;
+  }
+  data.sentRtpc[rtpc] = value;
+  m_carAudioStats.rtpcWrites++;
+  m_carBackend->setRtpc(RTPC_IDS[rtpc], value, data.audioId);
+}
 
-  AkGameObjectID audioId = audioIt->second;
-  auto& audioData = dataIt->second;
-  auto info = car->getDebugInfo();
+void AudioEngine::updateCarAudio(const std::vector<std::unique_ptr<Car>>& cars, const Vec2& listenerPos) {
+  // Basic checks
+  if (!m_carBackend) return;
+
+  m_carAudioFrame++;
+  m_carAudioStats = CarAudioStats();
+
+  // Gather positions and distances first so cars can be ranked against each other
+  m_frameSlots.clear();
+  m_frameInfo.clear();
+  m_frameDistances.clear();
+  m_frameTiers.clear();
+  for (const auto& car : cars) {
+    CarAudioData* data = findCarAudio(car.get());
+    if (!data) continue;
+
+    auto info = car->getDebugInfo();
+    float dx = info.position.x - listenerPos.x;
+    float dy = info.position.y - listenerPos.y;
+
+    CarAudioFrame frame;
+    frame.position = Vec2(info.position.x, info.position.y);
+    frame.angle = info.angle;
+    frame.forwardSpeed = info.forwardSpeed;
+    frame.bodyId = info.bodyId;
+
+    m_frameSlots.push_back(car->getAudioSlot());
+    m_frameInfo.push_back(frame);
+    m_frameDistances.push_back(std::sqrt(dx * dx + dy * dy));
+    m_frameTiers.push_back(data->tier);
+  }
+
+  CarAudioLOD::assignTiers(m_frameDistances, m_frameTiers, m_lodOrder);
+
+  for (size_t i = 0; i < m_frameSlots.size(); i++) {
+    CarAudioData& data = m_carAudio[m_frameSlots[i]];
+    CarAudioTier tier = m_frameTiers[i];
+    float distance = m_frameDistances[i];
+
+    if (tier == CarAudioTier::Virtual) {
+      if (data.tier != CarAudioTier::Virtual) {
+        // Out of earshot, drop its voices rather than mixing them at zero volume
+        stopCarLoops(data);
+        m_carBackend->stopAll(data.audioId);
+      }
+      data.tier = tier;
+      m_carAudioStats.virtualCars++;
+      continue;
+    }
 
-  // Get current car position
-  Vec2 currentPos(info.position.x, info.position.y);
+    if (data.tier == CarAudioTier::Virtual) {
+      startEngineLoops(data);
+      // Don't read the distance jump since it went virtual as Doppler
+      data.lastDistanceToListener = 0.0f;
+    }
 
-  // Calculate current distance to listener
-  float currentDistance = std::sqrt(
-    std::pow(currentPos.x - listenerPos.x, 2) +
-    std::pow(currentPos.y - listenerPos.y, 2)
-  );
+    if (tier == CarAudioTier::Full) {
+      data.tier = tier;
+      updateFullCarAudio(data, m_frameInfo[i], distance);
+      m_carAudioStats.fullCars++;
+    }
+    else {
+      if (data.tier == CarAudioTier::Full) {
+        stopCarLoops(data);
+      }
+      data.tier = tier;
+      if (CarAudioLOD::isReducedUpdateFrame(m_frameSlots[i], m_carAudioFrame)) {
+        updateReducedCarAudio(data, m_frameInfo[i], distance);
+      }
+      else {
+        data.lastDistanceToListener = distance;
+      }
+      m_carAudioStats.reducedCars++;
+    }
+  }
+}
 
+void AudioEngine::updateFullCarAudio(CarAudioData& data, const CarAudioFrame& frame, float currentDistance) {
   // Calculate highpass filter value based on distance (0-1 range)
   float highpassValue = std::min<float>(currentDistance / 500.0f, 1.0f) * 100.0f;
-  AK::SoundEngine::SetRTPCValue("Engine_Highpass_Filter", highpassValue, audioId);
+  setCarRtpc(data, RTPC_ENGINE_HIGHPASS, highpassValue);
 
   if (DEBUG_OUTPUT) {
     std::cout << "Distance: " << currentDistance
@@ -557,8 +640,8 @@ void AudioEngine::updateCarAudio(Car* car, const Vec2& listenerPos) {
 
   // Calculate Doppler effect
   float dopplerValue = 50.0f;  // No pitch shift by default
-  if (audioData.lastDistanceToListener > 0.0f) {
-    float distanceChange = currentDistance - audioData.lastDistanceToListener;
+  if (data.lastDistanceToListener > 0.0f) {
+    float distanceChange = currentDistance - data.lastDistanceToListener;
     float relativeVelocity = -distanceChange * 60.0f;
     relativeVelocity *= m_dopplerIntensity;
     dopplerValue = 50.0f + (relativeVelocity * 50.0f);
@@ -566,30 +649,53 @@ void AudioEngine::updateCarAudio(Car* car, const Vec2& listenerPos) {
   }
 
   // Store current values for next update
-  audioData.lastPosition = currentPos;
-  audioData.lastDistanceToListener = currentDistance;
+  data.lastPosition = frame.position;
+  data.lastDistanceToListener = currentDistance;
 
   // Update Doppler RTPC
-  AK::SoundEngine::SetRTPCValue(
-    "Engine_Rev_Doppler_Effect",
-    dopplerValue,
-    audioId
-  );
+  setCarRtpc(data, RTPC_ENGINE_DOPPLER, dopplerValue);
+
+  setCarPosition(data.audioId, frame);
+
+  // Continue with RTPC updates
+  float speedRatio = std::abs(frame.forwardSpeed) / (500.0f);
+  updateCarEngineState(data, speedRatio);
+  updateTireSkidSound(data, std::min<float>(1.0f, speedRatio), data.car->getProperties().driftState);
+
+  // Update scraping flag, then the scrape sound
+  data.car->setScrapingBarrier(isScrapingBarrier(data.car, frame.bodyId));
+  updateScrapeSound(data);
+}
+
+// Far enough down the list that it only needs to sound roughly right
+void AudioEngine::updateReducedCarAudio(CarAudioData& data, const CarAudioFrame& frame, float currentDistance) {
+  float highpassValue = std::min<float>(currentDistance / 500.0f, 1.0f) * 100.0f;
+  setCarRtpc(data, RTPC_ENGINE_HIGHPASS, highpassValue);
+  // Distance deltas span several frames here, so no Doppler
+  setCarRtpc(data, RTPC_ENGINE_DOPPLER, 50.0f);
+
+  data.lastPosition = frame.position;
+  data.lastDistanceToListener = currentDistance;
+
+  setCarPosition(data.audioId, frame);
+  updateCarEngineState(data, std::abs(frame.forwardSpeed) / (500.0f));
+}
 
+void AudioEngine::setCarPosition(AkGameObjectID audioId, const CarAudioFrame& frame) {
   // Create sound position
   AkSoundPosition soundPos;
   float positionScale = 1.0f;
 
   // Position
   AkVector position;
-  position.X = info.position.x * positionScale;
-  position.Y = -info.position.y * positionScale;
+  position.X = frame.position.x * positionScale;
+  position.Y = -frame.position.y * positionScale;
   position.Z = 0.0f;
 
   // Forward vector
   AkVector forward;
-  forward.X = cos(-info.angle);
-  forward.Y = sin(-info.angle);
+  forward.X = cos(-frame.angle);
+  forward.Y = sin(-frame.angle);
   forward.Z = 0.0f;
 
   // Up vector (Z-up for 2D)
@@ -605,81 +711,63 @@ void AudioEngine::updateCarAudio(Car* car, const Vec2& listenerPos) {
       << position.X << ", " << position.Y << ")" << std::endl;
   }
 
-  AKRESULT result = AK::SoundEngine::SetPosition(audioId, soundPos);
-  if (DEBUG_OUTPUT) {
-    if (result != AK_Success) {
-      std::cout << "Failed to set car position" << std::endl;
-    }
-  }
-
-  // Continue with RTPC updates
-  float speedRatio = abs(info.forwardSpeed) / (500.0f);
-  updateCarEngineState(car, speedRatio);
-
-
-  // Update scraping flag using the C API
-  bool scraping = false;
-  b2BodyId bodyId = car->getDebugInfo().bodyId;
+  m_carBackend->setPosition(audioId, soundPos);
+}
 
-  // Get our car pointer from the body’s user data.
+bool AudioEngine::isScrapingBarrier(Car* car, b2BodyId bodyId) {
+  // Get our car pointer from the body's user data.
   void* carUserData = b2Body_GetUserData(bodyId);
 
   // Get contact data for this body.
   int capacity = b2Body_GetContactCapacity(bodyId);
-  if (capacity > 0) {
-    // Allocate an array for contacts.
-    std::vector<b2ContactData> contacts(capacity);
-    int contactCount = b2Body_GetContactData(bodyId, contacts.data(), capacity);
-
-    for (int i = 0; i < contactCount; i++) {
-      b2ContactData contact = contacts[i];
-      // Use the manifold's pointCount as a proxy for "touching".
-      if (contact.manifold.pointCount == 0) {
-        continue;
-      }
+  if (capacity <= 0) return false;
 
-      b2ShapeId shapeA = contact.shapeIdA;
-      b2ShapeId shapeB = contact.shapeIdB;
-      b2BodyId bodyA = b2Shape_GetBody(shapeA);
-      b2BodyId bodyB = b2Shape_GetBody(shapeB);
+  // Reused between cars and frames.
+  if (static_cast<int>(m_contactBuffer.size()) < capacity) {
+    m_contactBuffer.resize(capacity);
+  }
+  int contactCount = b2Body_GetContactData(bodyId, m_contactBuffer.data(), capacity);
 
-      // Retrieve user data for both bodies.
-      void* userDataA = b2Body_GetUserData(bodyA);
-      void* userDataB = b2Body_GetUserData(bodyB);
+  for (int i = 0; i < contactCount; i++) {
+    const b2ContactData& contact = m_contactBuffer[i];
+    // Use the manifold's pointCount as a proxy for "touching".
+    if (contact.manifold.pointCount == 0) {
+      continue;
+    }
 
-      b2ShapeId otherShape;
-      // Determine which shape is _not_ attached to our car.
-      if (userDataA == carUserData) {
-        otherShape = shapeB;
-      }
-      else if (userDataB == carUserData) {
-        otherShape = shapeA;
-      }
-      else {
-        // Neither shape belongs to our car; skip.
-        continue;
-      }
+    b2ShapeId shapeA = contact.shapeIdA;
+    b2ShapeId shapeB = contact.shapeIdB;
+    b2BodyId bodyA = b2Shape_GetBody(shapeA);
+    b2BodyId bodyB = b2Shape_GetBody(shapeB);
 
-      // Get the filter data from the "other" shape.
-      b2Filter filter = b2Shape_GetFilter(otherShape);
-      // If the filter's category includes the barrier flag, we are scraping.
-      if (filter.categoryBits & CATEGORY_BARRIER) {
-        scraping = true;
-        break;
-      }
+    // Retrieve user data for both bodies.
+    void* userDataA = b2Body_GetUserData(bodyA);
+    void* userDataB = b2Body_GetUserData(bodyB);
+
+    b2ShapeId otherShape;
+    // Determine which shape is _not_ attached to our car.
+    if (userDataA == carUserData) {
+      otherShape = shapeB;
+    }
+    else if (userDataB == carUserData) {
+      otherShape = shapeA;
+    }
+    else {
+      // Neither shape belongs to our car; skip.
+      continue;
     }
-  }
-  car->setScrapingBarrier(scraping);
 
-  // Update the scrape sound
-  updateScrapeSound(car);
+    // Get the filter data from the "other" shape.
+    b2Filter filter = b2Shape_GetFilter(otherShape);
+    // If the filter's category includes the barrier flag, we are scraping.
+    if (filter.categoryBits & CATEGORY_BARRIER) {
+      return true;
+    }
+  }
+  return false;
 }
 
-void AudioEngine::updateCarEngineState(Car* car, float speedRatio) {
-  auto it = m_carAudioIds.find(car);
-  if (it == m_carAudioIds.end()) return;
-  AkGameObjectID audioId = it->second;
-
+void AudioEngine::updateCarEngineState(CarAudioData& data, float speedRatio) {
   speedRatio = std::min<float>(1.0f, std::max<float>(0.0f, speedRatio));
 
   // Start idle at 50%, surge up to 150% at low speeds, then drop to near 0 at high speeds 
@@ -690,55 +778,50 @@ void AudioEngine::updateCarEngineState(Car* car, float speedRatio) {
   else {
     idleMultiplier = 1.5f - std::pow(speedRatio, 0.7f) * 1.5f; // Steep drop
   }
-  
+
   // Only apply multiplier to idle volume
-  float idleVolume = (100.0f * (1.0f - std::sqrt(speedRatio))) * idleMultiplier;
+  float speedRoot = std::sqrt(speedRatio);
+  float idleVolume = (100.0f * (1.0f - speedRoot)) * idleMultiplier;
   idleVolume = std::min<float>(100.0f, std::max<float>(0.0f, idleVolume));
-  float revVolume = 100.0f * std::sqrt(speedRatio); // Rev unchanged
+  float revVolume = 100.0f * speedRoot; // Rev unchanged
   revVolume = std::min<float>(100.0f, revVolume);
 
-  AKRESULT idleResult = AK::SoundEngine::SetRTPCValue(
-    "Engine_Idle_Volume",
-    idleVolume,
-    audioId
-  );
-
-  AKRESULT revResult = AK::SoundEngine::SetRTPCValue(
-    "Engine_Rev_Volume",
-    revVolume,
-    audioId
-  );
+  setCarRtpc(data, RTPC_ENGINE_IDLE_VOLUME, idleVolume);
+  setCarRtpc(data, RTPC_ENGINE_REV_VOLUME, revVolume);
 
   float pitchValue = speedRatio * 100.0f;
-  AK::SoundEngine::SetRTPCValue("Engine_Rev_Pitch", pitchValue, audioId);
-
-  updateTireSkidSound(car, speedRatio, car->getProperties().driftState);
+  setCarRtpc(data, RTPC_ENGINE_REV_PITCH, pitchValue);
 
   if (DEBUG_OUTPUT) {
-    std::cout << "Car " << audioId
-      << " RTPC update - Result: Idle=" << idleResult
-      << " Rev=" << revResult
-      << " Values: Idle=" << idleVolume
+    std::cout << "Car " << data.audioId
+      << " RTPC update - Values: Idle=" << idleVolume
       << " Rev=" << revVolume
       << " Pitch=" << pitchValue << std::endl;
   }
 }
 
 void AudioEngine::removeCarAudio(Car* car) {
-  auto it = m_carAudioIds.find(car);
-  if (it == m_carAudioIds.end())
+  CarAudioData* data = findCarAudio(car);
+  if (!data)
     return;
 
-  AkGameObjectID audioId = it->second;
+  AkGameObjectID audioId = data->audioId;
 
   // Stop all sounds on this game object.
-  AK::SoundEngine::StopAll(audioId);
+  m_carBackend->stopAll(audioId);
   // Ensure the commands are flushed.
-  AK::SoundEngine::RenderAudio();
+  m_carBackend->flush();
   // Unregister the game object.
-  AK::SoundEngine::UnregisterGameObj(audioId);
+  m_carBackend->unregisterObject(audioId);
 
-  m_carAudioIds.erase(it);
+  // Keep the array dense: move the last car into this slot.
+  int slot = car->getAudioSlot();
+  if (slot != static_cast<int>(m_carAudio.size()) - 1) {
+    m_carAudio[slot] = m_carAudio.back();
+    m_carAudio[slot].car->setAudioSlot(slot);
+  }
+  m_carAudio.pop_back();
+  car->setAudioSlot(-1);
 
   if (DEBUG_OUTPUT) {
     std::cout << "Removed audio for car " << audioId << std::endl;
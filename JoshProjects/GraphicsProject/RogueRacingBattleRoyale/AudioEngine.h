@@ -6,7 +6,10 @@
 #include <unordered_map>
 #include "RacingAudioDefs.h"
 #include <array>
+#include <vector>
 #include "PhysicsSystem.h"
+#include "CarAudioLOD.h"
+#include "CarAudioBackend.h"
 
 class Car;
 
@@ -63,16 +66,20 @@ public:
   void setEngineRPM(float rpm);
   void setCarSpeed(float speed);
   void setTireSurfaceType(int surfaceType);
-  void updateTireSkidSound(Car* car, float speedRatio, float driftState);
-  void updateScrapeSound(Car* car);
 
   void setDefaultListener(const Vec2& position, float rotation); // not used ATM
   void setObjectPosition(AkGameObjectID id, const Vec2& position) const;
 
   void initializeCarAudio(Car* car);
-  void updateCarAudio(Car* car, const Vec2& listenerPos);
+  // Updates every car in the list. Cars are ranked by distance so only the nearest
+  // CarAudioLOD::MAX_FULL_CARS get the full update; the rest are thinned out or
+  // virtualised, so the cost stays flat as the field grows.
+  void updateCarAudio(const std::vector<std::unique_ptr<Car>>& cars, const Vec2& listenerPos);
   void removeCarAudio(Car* car);
   void resetNextCarAudioId();
+  // Where the car audio's sound engine calls go. init() installs WwiseCarAudioBackend
+  // unless one is already set; NullCarAudioBackend runs the car audio without Wwise.
+  void setCarAudioBackend(std::unique_ptr<CarAudioBackend> backend) { m_carBackend = std::move(backend); }
 
   // Volume controls
   void setMasterVolume(float volume);
@@ -85,23 +92,82 @@ public:
   float getMusicVolume() { return m_musicVolume; }
   const std::vector<MusicTrack>& getAvailableTracks() const { return AVAILABLE_MUSIC; }
 
+  // Cars per tier after the last updateCarAudio, and RTPC writes sent / skipped by it
+  struct CarAudioStats {
+    int fullCars = 0;
+    int reducedCars = 0;
+    int virtualCars = 0;
+    int rtpcWrites = 0;
+    int rtpcSkipped = 0;
+  };
+  const CarAudioStats& getCarAudioStats() const { return m_carAudioStats; }
+
   JAGEngine::WWiseAudioEngine* getWWiseEngine() { return m_audioEngine.get(); }
 
 private:
+  // Per-car RTPCs, in the order they're stored in CarAudioData::sentRtpc
+  enum CarRtpc {
+    RTPC_ENGINE_IDLE_VOLUME,
+    RTPC_ENGINE_REV_VOLUME,
+    RTPC_ENGINE_REV_PITCH,
+    RTPC_ENGINE_HIGHPASS,
+    RTPC_ENGINE_DOPPLER,
+    RTPC_TIRE_ROAD_VOLUME,
+    RTPC_TIRE_SKID_VOLUME,
+    RTPC_TIRE_DIRT_VOLUME,
+    RTPC_TIRE_GRASS_VOLUME,
+    RTPC_TIRE_SKID_PITCH,
+    CAR_RTPC_COUNT
+  };
+
+  // What updateCarAudio reads from each car once per frame
+  struct CarAudioFrame {
+    Vec2 position;
+    float angle = 0.0f;
+    float forwardSpeed = 0.0f;
+    b2BodyId bodyId;
+  };
+
   struct CarAudioData {
-    AkGameObjectID audioId;
+    Car* car = nullptr;
+    AkGameObjectID audioId = AK_INVALID_GAME_OBJECT;
     Vec2 lastPosition;
-    float lastDistanceToListener;
+    float lastDistanceToListener = 0.0f;
+    CarAudioTier tier = CarAudioTier::Reduced;
+    bool isSkidPlaying = false;
+    bool isScrapePlaying = false;
+    // Last value written per RTPC, NaN when it has to be sent regardless
+    std::array<float, CAR_RTPC_COUNT> sentRtpc;
   };
-  std::unordered_map<Car*, CarAudioData> m_carAudioData;
+  // Dense, indexed by Car::getAudioSlot(). Removal swaps the last car into the hole.
+  std::vector<CarAudioData> m_carAudio;
   float m_dopplerIntensity = 1.0f;
 
   static constexpr bool DEBUG_OUTPUT = false;
 
   std::unique_ptr<JAGEngine::WWiseAudioEngine> m_audioEngine;
-  void updateCarEngineState(Car* car, float speedRatio);
-  std::unordered_map<Car*, AkGameObjectID> m_carAudioIds;
-  std::unordered_map<Car*, bool> m_isScrapePlaying;
+  std::unique_ptr<CarAudioBackend> m_carBackend;
+  CarAudioData* findCarAudio(Car* car);
+  void startEngineLoops(CarAudioData& data);
+  void setCarRtpc(CarAudioData& data, CarRtpc rtpc, float value);
+  void updateFullCarAudio(CarAudioData& data, const CarAudioFrame& frame, float distance);
+  void updateReducedCarAudio(CarAudioData& data, const CarAudioFrame& frame, float distance);
+  void setCarPosition(AkGameObjectID audioId, const CarAudioFrame& frame);
+  void updateCarEngineState(CarAudioData& data, float speedRatio);
+  void updateTireSkidSound(CarAudioData& data, float speedRatio, float driftState);
+  void updateScrapeSound(CarAudioData& data);
+  void stopCarLoops(CarAudioData& data);
+  bool isScrapingBarrier(Car* car, b2BodyId bodyId);
+
+  // Scratch for updateCarAudio, kept to avoid reallocating every frame
+  std::vector<int> m_frameSlots;
+  std::vector<CarAudioFrame> m_frameInfo;
+  std::vector<float> m_frameDistances;
+  std::vector<CarAudioTier> m_frameTiers;
+  std::vector<size_t> m_lodOrder;
+  std::vector<b2ContactData> m_contactBuffer;
+  uint32_t m_carAudioFrame = 0;
+  CarAudioStats m_carAudioStats;
 
   bool m_isBoostPlaying;
   bool m_isEnginePlaying;
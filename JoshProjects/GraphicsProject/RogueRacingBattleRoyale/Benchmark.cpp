@@ -0,0 +1,221 @@
+//Benchmark.cpp
+
+#include "Benchmark.h"
+#include "AudioEngine.h"
+#include "Car.h"
+#include "CarAudioBackend.h"
+#include "PhysicsSystem.h"
+#include <JAGEngine/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+  // Jobs go out in batches smaller than a worker queue, or run() would start running
+  // them inline once the queue fills up
+  const int ENQUEUE_BATCH = 1000;
+  const int ENQUEUE_BATCHES = 200;
+  const uint32_t PARALLEL_FOR_COUNT = 1 << 22;
+  const uint32_t PARALLEL_FOR_GRAIN = 4096;
+  const int PARALLEL_FOR_PASSES = 20;
+  const int NUM_BODIES = 4000;
+  const float ARENA_SIZE = 200.0f;
+  const int PHYSICS_WARMUP_STEPS = 30;
+  const int PHYSICS_STEPS = 120;
+  const int NUM_AUDIO_CARS = 64;
+  const int CAR_AUDIO_FRAMES = 600;
+
+  double msSince(std::chrono::steady_clock::time_point startTime) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  }
+
+  // Average cost of run() for an empty job, and of running it to completion
+  void measureEnqueue() {
+    JAGEngine::JobSystem& jobSystem = JAGEngine::JobSystem::getInstance();
+    JAGEngine::Job job;
+    job.function = [](void*, uint32_t, uint32_t) {};
+
+    double enqueueMs = 0.0;
+    double totalMs = 0.0;
+    for (int batch = 0; batch < ENQUEUE_BATCHES; batch++) {
+      JAGEngine::JobCounter counter;
+      job.counter = &counter;
+      auto startTime = std::chrono::steady_clock::now();
+      for (int i = 0; i < ENQUEUE_BATCH; i++) {
+        jobSystem.run(job);
+      }
+      enqueueMs += msSince(startTime);
+      jobSystem.wait(counter);
+      totalMs += msSince(startTime);
+    }
+
+    const double numJobs = (double)ENQUEUE_BATCH * ENQUEUE_BATCHES;
+    std::printf("enqueue: %.0f ns per job, %.0f ns per job run to completion\n",
+      enqueueMs * 1e6 / numJobs, totalMs * 1e6 / numJobs);
+  }
+
+  double measureParallelFor(std::vector<float>& values) {
+    JAGEngine::JobSystem& jobSystem = JAGEngine::JobSystem::getInstance();
+    auto startTime = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < PARALLEL_FOR_PASSES; pass++) {
+      jobSystem.parallelFor(PARALLEL_FOR_COUNT, PARALLEL_FOR_GRAIN, [&values](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+          values[i] = std::sqrt(values[i] * values[i] + 1.0f);
+        }
+      });
+    }
+    return msSince(startTime) / PARALLEL_FOR_PASSES;
+  }
+
+  // Circles bouncing around a walled arena with sleep off, so every step has the same
+  // contacts for the solver
+  double measurePhysicsStep() {
+    PhysicsSystem physics;
+    physics.init(0.0f, 0.0f);
+
+    b2BodyId walls = physics.createStaticBody(0.0f, 0.0f);
+    b2ShapeDef wallDef = b2DefaultShapeDef();
+    const float halfSize = ARENA_SIZE * 0.5f;
+    b2Polygon wallBoxes[4] = {
+      b2MakeOffsetBox(halfSize, 1.0f, b2Vec2{ 0.0f, -halfSize }, b2Rot_identity),
+      b2MakeOffsetBox(halfSize, 1.0f, b2Vec2{ 0.0f, halfSize }, b2Rot_identity),
+      b2MakeOffsetBox(1.0f, halfSize, b2Vec2{ -halfSize, 0.0f }, b2Rot_identity),
+      b2MakeOffsetBox(1.0f, halfSize, b2Vec2{ halfSize, 0.0f }, b2Rot_identity),
+    };
+    for (const b2Polygon& wallBox : wallBoxes) {
+      b2CreatePolygonShape(walls, &wallDef, &wallBox);
+    }
+
+    std::mt19937 randomEngine(1);
+    std::uniform_real_distribution<float> randPos(-halfSize + 2.0f, halfSize - 2.0f);
+    std::uniform_real_distribution<float> randVel(-20.0f, 20.0f);
+    for (int i = 0; i < NUM_BODIES; i++) {
+      b2BodyId body = physics.createDynamicBody(randPos(randomEngine), randPos(randomEngine));
+      physics.createCircleShape(body, 1.0f, CATEGORY_PUSHABLE, 0xFFFF, CollisionType::PUSHABLE);
+      b2Body_SetLinearVelocity(body, b2Vec2{ randVel(randomEngine), randVel(randomEngine) });
+    }
+
+    const float timeStep = 1.0f / 60.0f;
+    for (int i = 0; i < PHYSICS_WARMUP_STEPS; i++) {
+      physics.update(timeStep);
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < PHYSICS_STEPS; i++) {
+      physics.update(timeStep);
+    }
+    double ms = msSince(startTime) / PHYSICS_STEPS;
+
+    physics.cleanup();
+    return ms;
+  }
+
+  // updateCarAudio for a field of cars driving around the listener, with the sound
+  // engine calls going to NullCarAudioBackend so only the LOD and RTPC work is timed
+  double measureCarAudio(AudioEngine::CarAudioStats& stats) {
+    // Cars log their setup and speed every frame; keep the output to the timings
+    std::cout.setstate(std::ios::failbit);
+
+    PhysicsSystem physics;
+    physics.init(0.0f, 0.0f);
+    AudioEngine audio;
+    audio.setCarAudioBackend(std::make_unique<NullCarAudioBackend>());
+
+    std::mt19937 randomEngine(1);
+    std::uniform_real_distribution<float> randPos(-ARENA_SIZE * 5.0f, ARENA_SIZE * 5.0f);
+    std::uniform_real_distribution<float> randVel(-300.0f, 300.0f);
+    std::vector<std::unique_ptr<Car>> cars;
+    for (int i = 0; i < NUM_AUDIO_CARS; i++) {
+      b2BodyId body = physics.createDynamicBody(randPos(randomEngine), randPos(randomEngine));
+      physics.createPillShape(body, 15.0f, 15.0f, CATEGORY_CAR, 0, CollisionType::DEFAULT);
+      b2Body_SetLinearVelocity(body, b2Vec2{ randVel(randomEngine), randVel(randomEngine) });
+      cars.push_back(std::make_unique<Car>(body));
+      audio.initializeCarAudio(cars.back().get());
+    }
+
+    // Everyone floors it, and every third car drifts so the skid loop gets used too
+    InputState driving;
+    driving.accelerating = true;
+    InputState drifting = driving;
+    drifting.braking = true;
+    drifting.turningLeft = true;
+
+    const float timeStep = 1.0f / 60.0f;
+    double ms = 0.0;
+    for (int i = 0; i < CAR_AUDIO_FRAMES; i++) {
+      for (size_t c = 0; c < cars.size(); c++) {
+        cars[c]->update(c % 3 == 0 ? drifting : driving);
+      }
+      physics.update(timeStep);
+      Car::DebugInfo listener = cars[0]->getDebugInfo();
+      auto startTime = std::chrono::steady_clock::now();
+      audio.updateCarAudio(cars, Vec2(listener.position.x, listener.position.y));
+      ms += msSince(startTime);
+    }
+    stats = audio.getCarAudioStats();
+
+    for (auto& car : cars) {
+      audio.removeCarAudio(car.get());
+    }
+    cars.clear();
+    physics.cleanup();
+    std::cout.clear();
+    return ms / CAR_AUDIO_FRAMES;
+  }
+}
+
+int runBenchmark(int argc, char** argv) {
+  int maxThreads = argc > 0 ? std::atoi(argv[0]) : (int)std::thread::hardware_concurrency();
+  if (maxThreads <= 0) {
+    std::printf("Usage: RogueRacingBattleRoyale --benchmark [threads]\n");
+    return 1;
+  }
+
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2) {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+
+  std::vector<float> values(PARALLEL_FOR_COUNT, 1.0f);
+  double baseParallelForMs = 0.0;
+  double basePhysicsMs = 0.0;
+  std::printf("parallelFor over %u floats, physics step with %d bodies\n", PARALLEL_FOR_COUNT, NUM_BODIES);
+  for (int threads : threadCounts) {
+    // The calling thread counts as one. A single thread leaves the JobSystem off, so
+    // jobs and physics tasks run inline like they did before it existed.
+    JAGEngine::JobSystem& jobSystem = JAGEngine::JobSystem::getInstance();
+    if (threads > 1) {
+      jobSystem.init(threads - 1);
+    }
+    if (threads == maxThreads) {
+      measureEnqueue();
+    }
+
+    double parallelForMs = measureParallelFor(values);
+    double physicsMs = measurePhysicsStep();
+    if (threads == 1) {
+      baseParallelForMs = parallelForMs;
+      basePhysicsMs = physicsMs;
+    }
+    std::printf("%3d threads: parallelFor %7.3f ms (%.2fx)  physics %7.3f ms (%.2fx)\n", threads,
+      parallelForMs, baseParallelForMs / parallelForMs, physicsMs, basePhysicsMs / physicsMs);
+
+    if (jobSystem.isInitialized()) {
+      jobSystem.endFrame();
+      jobSystem.destroy();
+    }
+  }
+
+  AudioEngine::CarAudioStats stats;
+  double carAudioMs = measureCarAudio(stats);
+  std::printf("car audio, %d cars: %.4f ms per update (last frame: %d full, %d reduced, %d virtual, "
+    "%d RTPC writes, %d skipped)\n", NUM_AUDIO_CARS, carAudioMs, stats.fullCars, stats.reducedCars,
+    stats.virtualCars, stats.rtpcWrites, stats.rtpcSkipped);
+  return 0;
+}
@@ -0,0 +1,11 @@
+//Benchmark.h
+
+#pragma once
+
+// Headless timing run, started with "RogueRacingBattleRoyale --benchmark [threads]".
+// Measures the JobSystem's enqueue latency, then parallelFor and a crowded physics
+// step at 1, 2, 4... threads up to threads (every hardware thread by default), and
+// prints each one's speedup over a single thread. Then times updateCarAudio for a field
+// of cars with NullCarAudioBackend standing in for Wwise.
+// Returns the exit code for main.
+int runBenchmark(int argc, char** argv);
@@ -159,7 +159,7 @@ void Car::updateStartLineCrossing(const SplineTrack* track) {
     if (!track) return;
     const TrackNode* startNode = track->getStartLineNode();
     if (!startNode) return;
-    auto splinePoints = track->getSplinePoints(200);
+    const auto& splinePoints = track->getSplinePoints(200);
     if (splinePoints.empty()) return;
 
     // Get current position, previous position, and velocity.
@@ -371,7 +371,7 @@ void Car::applyLapBonuses() {
 
 float Car::calculateLapProgress(const SplineTrack* track) {
   if (!track) return 0.0f;
-  auto splinePoints = track->getSplinePoints(200);
+  const auto& splinePoints = track->getSplinePoints(200);
   if (splinePoints.empty()) return 0.0f;
 
   // Find start line index first
@@ -165,6 +165,9 @@ public:
   //AkGameObjectID getAudioId() const { return static_cast<AkGameObjectID>(m_bodyId.index1); }
   AkGameObjectID getAudioId() const { return m_audioId; }
   void setAudioId(AkGameObjectID id) { m_audioId = id; }
+  // Index into AudioEngine's car audio array, -1 when the car has no audio
+  int getAudioSlot() const { return m_audioSlot; }
+  void setAudioSlot(int slot) { m_audioSlot = slot; }
 
   float getTotalRaceProgress() const;
 
@@ -210,5 +213,6 @@ private:
 
   AudioEngine* m_audioEngine = nullptr;
   AkGameObjectID m_audioId = AK_INVALID_GAME_OBJECT;
+  int m_audioSlot = -1;
 
 };
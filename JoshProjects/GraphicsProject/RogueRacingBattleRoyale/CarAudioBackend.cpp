@@ -0,0 +1,36 @@
+// CarAudioBackend.cpp
+
+#include "CarAudioBackend.h"
+#include <AK/SoundEngine/Common/AkSoundEngine.h>
+
+bool WwiseCarAudioBackend::registerObject(AkGameObjectID objectId, const char* name) {
+  return AK::SoundEngine::RegisterGameObj(objectId, name) == AK_Success;
+}
+
+void WwiseCarAudioBackend::unregisterObject(AkGameObjectID objectId) {
+  AK::SoundEngine::UnregisterGameObj(objectId);
+}
+
+AkPlayingID WwiseCarAudioBackend::postEvent(AkUniqueID eventId, AkGameObjectID objectId) {
+  return AK::SoundEngine::PostEvent(eventId, objectId);
+}
+
+void WwiseCarAudioBackend::seekOnEvent(AkUniqueID eventId, AkGameObjectID objectId, AkTimeMs position) {
+  AK::SoundEngine::SeekOnEvent(eventId, objectId, position, false);
+}
+
+void WwiseCarAudioBackend::stopAll(AkGameObjectID objectId) {
+  AK::SoundEngine::StopAll(objectId);
+}
+
+void WwiseCarAudioBackend::setRtpc(AkRtpcID rtpcId, float value, AkGameObjectID objectId) {
+  AK::SoundEngine::SetRTPCValue(rtpcId, value, objectId);
+}
+
+void WwiseCarAudioBackend::setPosition(AkGameObjectID objectId, const AkSoundPosition& position) {
+  AK::SoundEngine::SetPosition(objectId, position);
+}
+
+void WwiseCarAudioBackend::flush() {
+  AK::SoundEngine::RenderAudio();
+}
@@ -0,0 +1,51 @@
+// CarAudioBackend.h
+
+#pragma once
+#include <AK/SoundEngine/Common/AkTypes.h>
+
+// The sound engine calls made for car audio. AudioEngine's car code only talks to this,
+// so the LOD and RTPC logic can be run with NullCarAudioBackend and no Wwise running.
+class CarAudioBackend {
+public:
+  virtual ~CarAudioBackend() = default;
+
+  virtual bool registerObject(AkGameObjectID objectId, const char* name) = 0;
+  virtual void unregisterObject(AkGameObjectID objectId) = 0;
+  virtual AkPlayingID postEvent(AkUniqueID eventId, AkGameObjectID objectId) = 0;
+  virtual void seekOnEvent(AkUniqueID eventId, AkGameObjectID objectId, AkTimeMs position) = 0;
+  // Stops every voice on the object, used when a car goes virtual or is removed
+  virtual void stopAll(AkGameObjectID objectId) = 0;
+  virtual void setRtpc(AkRtpcID rtpcId, float value, AkGameObjectID objectId) = 0;
+  virtual void setPosition(AkGameObjectID objectId, const AkSoundPosition& position) = 0;
+  // Pushes queued commands through, so a stop lands before the object goes away
+  virtual void flush() = 0;
+};
+
+// Forwards to AK::SoundEngine
+class WwiseCarAudioBackend : public CarAudioBackend {
+public:
+  bool registerObject(AkGameObjectID objectId, const char* name) override;
+  void unregisterObject(AkGameObjectID objectId) override;
+  AkPlayingID postEvent(AkUniqueID eventId, AkGameObjectID objectId) override;
+  void seekOnEvent(AkUniqueID eventId, AkGameObjectID objectId, AkTimeMs position) override;
+  void stopAll(AkGameObjectID objectId) override;
+  void setRtpc(AkRtpcID rtpcId, float value, AkGameObjectID objectId) override;
+  void setPosition(AkGameObjectID objectId, const AkSoundPosition& position) override;
+  void flush() override;
+};
+
+// Does nothing. Events report as playing so the same paths run as with Wwise.
+class NullCarAudioBackend : public CarAudioBackend {
+public:
+  bool registerObject(AkGameObjectID, const char*) override { return true; }
+  void unregisterObject(AkGameObjectID) override {}
+  AkPlayingID postEvent(AkUniqueID, AkGameObjectID) override { return ++m_lastPlayingId; }
+  void seekOnEvent(AkUniqueID, AkGameObjectID, AkTimeMs) override {}
+  void stopAll(AkGameObjectID) override {}
+  void setRtpc(AkRtpcID, float, AkGameObjectID) override {}
+  void setPosition(AkGameObjectID, const AkSoundPosition&) override {}
+  void flush() override {}
+
+private:
+  AkPlayingID m_lastPlayingId = 0;
+};
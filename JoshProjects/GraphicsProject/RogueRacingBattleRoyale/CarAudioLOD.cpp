@@ -0,0 +1,34 @@
+// CarAudioLOD.cpp
+
+#include "CarAudioLOD.h"
+#include <algorithm>
+
+namespace CarAudioLOD {
+
+  void assignTiers(const std::vector<float>& distances, std::vector<CarAudioTier>& tiers, std::vector<size_t>& order) {
+    tiers.resize(distances.size(), CarAudioTier::Reduced);
+    order.clear();
+
+    for (size_t i = 0; i < distances.size(); i++) {
+      float limit = tiers[i] == CarAudioTier::Virtual ? DEVIRTUALIZE_DISTANCE : VIRTUAL_DISTANCE;
+      if (distances[i] > limit) {
+        tiers[i] = CarAudioTier::Virtual;
+      }
+      else {
+        tiers[i] = CarAudioTier::Reduced;
+        order.push_back(i);
+      }
+    }
+
+    // Only the nearest few need sorting out, nth_element keeps this O(n)
+    size_t fullCount = std::min(order.size(), MAX_FULL_CARS);
+    if (fullCount < order.size()) {
+      std::nth_element(order.begin(), order.begin() + fullCount, order.end(),
+        [&distances](size_t a, size_t b) { return distances[a] < distances[b]; });
+    }
+    for (size_t i = 0; i < fullCount; i++) {
+      tiers[order[i]] = CarAudioTier::Full;
+    }
+  }
+
+}
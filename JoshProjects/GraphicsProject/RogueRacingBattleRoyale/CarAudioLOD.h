@@ -0,0 +1,41 @@
+// CarAudioLOD.h
+
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// How much work a car's audio gets this frame. Kept free of Wwise so the choice can be
+// checked on its own.
+enum class CarAudioTier {
+  Full,     // Every RTPC, position, skid and scrape, every frame
+  Reduced,  // Position and engine RTPCs only, every few frames
+  Virtual   // Voices stopped until the car comes back in range
+};
+
+namespace CarAudioLOD {
+  // Cars that get the full update, nearest first (the player's car is distance 0)
+  static constexpr size_t MAX_FULL_CARS = 8;
+  // Engines past this are inaudible (the highpass is already at max from 500)
+  static constexpr float VIRTUAL_DISTANCE = 1500.0f;
+  // A virtual car has to come this close before its voices restart, so a car sitting
+  // on the boundary doesn't restart its loops every other frame
+  static constexpr float DEVIRTUALIZE_DISTANCE = 1350.0f;
+  // Reduced cars are updated once every this many frames, staggered by slot
+  static constexpr uint32_t REDUCED_UPDATE_INTERVAL = 4;
+  // RTPCs are 0-100; smaller changes than this aren't sent
+  static constexpr float RTPC_CHANGE_THRESHOLD = 0.5f;
+
+  // Sets tiers[i] from distances[i] and the car's previous tier. order is scratch space.
+  void assignTiers(const std::vector<float>& distances, std::vector<CarAudioTier>& tiers, std::vector<size_t>& order);
+
+  inline bool isReducedUpdateFrame(size_t slot, uint32_t frame) {
+    return (slot + frame) % REDUCED_UPDATE_INTERVAL == 0;
+  }
+
+  // lastSent is NaN until the first write
+  inline bool shouldSendRtpc(float lastSent, float value) {
+    return std::isnan(lastSent) || std::fabs(value - lastSent) >= RTPC_CHANGE_THRESHOLD;
+  }
+}
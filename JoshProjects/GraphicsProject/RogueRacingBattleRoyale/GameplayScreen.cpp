@@ -233,7 +233,7 @@ void GameplayScreen::draw() {
 }
 
 void GameplayScreen::update() {
-  const float timeStep = 1.0f / 60.0f;
+  const float timeStep = m_game->getFixedTimeStep();
 
   // Debug physics state before update
   if (b2Body_IsValid(m_playerCarBody)) {
@@ -275,7 +275,7 @@ void LevelEditorScreen::onExit() {
 void LevelEditorScreen::update() {
   // Update the no-start-line message timer
   if (m_showNoStartLineMessage) {
-    m_messageTimer -= 1.0f / 60.0f; // (You might later want to use a real deltaTime)
+    m_messageTimer -= m_game->getFixedTimeStep();
     if (m_messageTimer <= 0)
       m_showNoStartLineMessage = false;
   }
@@ -1088,7 +1088,7 @@ void LevelEditorScreen::handleInput() {
   // Camera movement in editor mode
   if (!m_testMode && !imguiWantsKeyboard && m_canMoveCamera) {
     glm::vec2 cameraMove(0.0f);
-    float deltaTime = 1.0f / 60.0f;
+    float deltaTime = m_game->getFixedTimeStep();
 
     // Scale camera speed based on zoom level
     float zoomScale = m_camera.getScale();
@@ -1345,7 +1345,7 @@ int LevelEditorScreen::getPreviousScreenIndex() const {
 
 
 glm::vec2 LevelEditorScreen::findClosestSplinePoint(const glm::vec2& mousePos) {
-  auto splinePoints = m_track->getSplinePoints(200);
+  const auto& splinePoints = m_track->getSplinePoints(200);
   float minDist = FLT_MAX;
   glm::vec2 closestPoint;
 
@@ -2344,7 +2344,7 @@ void LevelEditorScreen::updateAIDrivers() {
   if (!m_testMode || !m_enableAI) return;
 
   // Add frame delta time to accumulator
-  float frameTime = 1.0f / 60.0f;
+  float frameTime = m_game->getFixedTimeStep();
   m_aiUpdateAccumulator += frameTime;
 
   // Update all AI drivers if enough time has accumulated
@@ -2404,6 +2404,7 @@ void LevelEditorScreen::drawTestModeUI() {
 
     // Performance debug toggle
     ImGui::Checkbox("Show Performance Debug", &m_showPerformanceWindow);
+    ImGui::Checkbox("Show Profiler Timeline", &m_showProfilerWindow);
 
     if (m_readyToStart && !m_raceCountdown->isCountingDown() && !m_raceCountdown->hasFinished()) {
       ImGui::SliderInt("Number of Laps", &m_totalLaps, 1, 10);
@@ -2959,7 +2960,7 @@ LevelEditorScreen::CarTrackingInfo LevelEditorScreen::calculateCarTrackingInfo(c
   float minDistSq = FLT_MAX;
 
   // Get spline points
-  auto splinePoints = m_track->getSplinePoints(200);
+  const auto& splinePoints = m_track->getSplinePoints(200);
   if (splinePoints.empty()) return info;
 
   // Find closest segment and interpolated point
@@ -3043,7 +3044,7 @@ void LevelEditorScreen::updateTestMode() {
     return;
 
   TIME_SCOPE("Total Frame");
-  const float fixedTimeStep = 1.0f / 60.0f;
+  const float fixedTimeStep = m_game->getFixedTimeStep();
 
   // Always update countdown.
   if (m_raceCountdown) {
@@ -3152,9 +3153,7 @@ void LevelEditorScreen::updateTestMode() {
       auto playerInfo = m_testCars[0]->getDebugInfo();
       Vec2 listenerPos(playerInfo.position.x, playerInfo.position.y);
       audioEngine.setDefaultListener(listenerPos, playerInfo.angle);
-      for (const auto& car : m_testCars) {
-        audioEngine.updateCarAudio(car.get(), listenerPos);
-      }
+      audioEngine.updateCarAudio(m_testCars, listenerPos);
     }
   }  // End of game logic update.
 
@@ -3188,7 +3187,7 @@ void LevelEditorScreen::updateRaceMode() {
     return;
 
   TIME_SCOPE("Total Frame");
-  const float fixedTimeStep = 1.0f / 60.0f;
+  const float fixedTimeStep = m_game->getFixedTimeStep();
 
   // Always update countdown.
   if (m_raceCountdown) {
@@ -3297,9 +3296,7 @@ void LevelEditorScreen::updateRaceMode() {
       auto playerInfo = m_testCars[0]->getDebugInfo();
       Vec2 listenerPos(playerInfo.position.x, playerInfo.position.y);
       audioEngine.setDefaultListener(listenerPos, playerInfo.angle);
-      for (const auto& car : m_testCars) {
-        audioEngine.updateCarAudio(car.get(), listenerPos);
-      }
+      audioEngine.updateCarAudio(m_testCars, listenerPos);
     }
   }  // End of game logic update.
 
@@ -3474,7 +3471,7 @@ void LevelEditorScreen::drawCarTrackingDebug() {
 glm::vec2 LevelEditorScreen::calculateLookAheadPoint(const CarTrackingInfo& carInfo) const {
   if (!m_track) return carInfo.closestSplinePoint;
 
-  auto splinePoints = m_track->getSplinePoints(400);
+  const auto& splinePoints = m_track->getSplinePoints(400);
   if (splinePoints.empty()) return carInfo.closestSplinePoint;
 
   // Find the current spline segment
@@ -3540,6 +3537,10 @@ glm::vec2 LevelEditorScreen::calculateLookAheadPoint(const CarTrackingInfo& carI
 }
 
 void LevelEditorScreen::drawPerformanceWindow() {
+  if (m_showProfilerWindow) {
+    JAGEngine::Profiler::getInstance().drawImGui(&m_showProfilerWindow);
+  }
+
   if (!m_showPerformanceWindow) return;
 
   ImGui::SetNextWindowPos(ImVec2(10, 500), ImGuiCond_FirstUseEver);
@@ -330,6 +330,7 @@ private:
 
   // Performance debug
   bool m_showPerformanceWindow = false;
+  bool m_showProfilerWindow = false;
   void drawPerformanceWindow();
 
   // Leveling
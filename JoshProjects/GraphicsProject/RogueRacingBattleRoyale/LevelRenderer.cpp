@@ -381,7 +381,7 @@ void LevelRenderer::renderObjects(const glm::mat4& cameraMatrix, ObjectManager*
       // Calculate preview rotation for objects that should auto-align
       float previewRotation = previewObj->getRotation();
       if (previewObj->shouldAutoAlignToTrack() && track) {
-        std::vector<SplineTrack::SplinePointInfo> splinePoints = track->getSplinePoints(200);
+        const std::vector<SplineTrack::SplinePointInfo>& splinePoints = track->getSplinePoints(200);
         float minDist = std::numeric_limits<float>::max();
         size_t closestIdx = 0;
 
@@ -435,7 +435,7 @@ void LevelRenderer::drawRoadEdges(SplineTrack* track) {
   const auto& nodes = track->getNodes();
   if (nodes.empty()) return;
 
-  auto splinePoints = track->getSplinePoints(200);
+  const auto& splinePoints = track->getSplinePoints(200);
   std::vector<glm::vec2> leftEdgePoints, rightEdgePoints;
   std::vector<glm::vec2> leftOffroadPoints, rightOffroadPoints;
 
@@ -3,10 +3,17 @@
 #include <JAGEngine/IMainGame.h>
 
 #include "App.h"
+#include "Benchmark.h"
 #include <cstdlib>
+#include <cstring>
 #include <ctime>  
 
 int main(int argc, char** argv) {
+  // "--benchmark" times the job system and physics headless instead of starting the game
+  if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0) {
+    return runBenchmark(argc - 2, argv + 2);
+  }
+
   std::srand(static_cast<unsigned int>(std::time(nullptr)));
   App app;
   app.run();
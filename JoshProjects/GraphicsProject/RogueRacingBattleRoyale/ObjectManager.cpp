@@ -5,6 +5,7 @@
 #include <set>
 #include <iostream>
 #include <algorithm>
+#include <JAGEngine/Memory.h>
 
 ObjectManager::ObjectManager(SplineTrack* track, PhysicsSystem* physicsSystem)
   : m_track(track)
@@ -36,7 +37,7 @@ void ObjectManager::addObject(size_t templateIndex, const glm::vec2& position) {
 
   // Handle track alignment for objects that need it
   if (newObject->shouldAutoAlignToTrack() && m_track) {
-    auto splinePoints = m_track->getSplinePoints(200);
+    const auto& splinePoints = m_track->getSplinePoints(200);
     float minDist = std::numeric_limits<float>::max();
     size_t closestIdx = 0;
 
@@ -86,7 +87,7 @@ PlaceableObject* ObjectManager::getObjectAtPosition(const glm::vec2& position) {
 bool ObjectManager::isValidPlacement(const PlaceableObject* obj, const glm::vec2& position) const {
   if (!obj || !m_track) return false;
 
-  auto splinePoints = m_track->getSplinePoints(100);
+  const auto& splinePoints = m_track->getSplinePoints(100);
   float minDist = std::numeric_limits<float>::max();
   SplineTrack::SplinePointInfo nearestPoint;
 
@@ -384,7 +385,7 @@ std::vector<const PlaceableObject*> ObjectManager::getNearbyObjects(const glm::v
   int centerX = static_cast<int>(std::floor(pos.x / CELL_SIZE));
   int centerY = static_cast<int>(std::floor(pos.y / CELL_SIZE));
 
-  std::set<const PlaceableObject*> uniqueObjects;
+  JAGEngine::FrameSet<const PlaceableObject*> uniqueObjects(JAGEngine::frameResource());
 
   for (int y = centerY - cellRadius; y <= centerY + cellRadius; y++) {
     for (int x = centerX - cellRadius; x <= centerX + cellRadius; x++) {
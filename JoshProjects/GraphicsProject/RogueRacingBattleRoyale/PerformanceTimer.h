@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <memory>
 #include <cfloat>
+#include <JAGEngine/Profiler.h>
 
 // Forward declare the timer class
 class PerformanceTimer;
@@ -32,6 +33,7 @@ public:
     uint32_t frameCount = 0;       // Number of frames measured
     static const int HISTORY_SIZE = 60;  // Keep last 60 frames for average
     std::vector<float> history;    // Circular buffer of recent timings
+    float historySum = 0.0f;       // Running sum of history, so the average is O(1)
 
     TimingData() : history(HISTORY_SIZE, 0.0f) {}
   };
@@ -59,17 +61,15 @@ public:
     data.minTime = std::min<float>(data.minTime, duration);
     data.maxTime = std::max<float>(data.maxTime, duration);
 
-    // Update history buffer
-    data.history[data.frameCount % TimingData::HISTORY_SIZE] = duration;
+    // Update history buffer and running sum
+    float& slot = data.history[data.frameCount % TimingData::HISTORY_SIZE];
+    data.historySum += duration - slot;
+    slot = duration;
     data.frameCount++;
 
     // Calculate moving average
-    float sum = 0.0f;
-    int count = std::min<float>(TimingData::HISTORY_SIZE, static_cast<int>(data.frameCount));
-    for (int i = 0; i < count; i++) {
-      sum += data.history[i];
-    }
-    data.averageTime = sum / count;
+    int count = std::min<int>(TimingData::HISTORY_SIZE, static_cast<int>(data.frameCount));
+    data.averageTime = data.historySum / count;
   }
 
   const TimingData& getTimingData(const std::string& name) const {
@@ -109,7 +109,8 @@ inline ScopedTimer::~ScopedTimer() {
   m_timer.endTimer(m_name);
 }
 
-// Macro that creates a scoped timer
-#define TIME_FUNCTION() ScopedTimer scopedTimer##__FUNCTION__(__FUNCTION__, PerformanceTimer::getInstance())
-#define TIME_SCOPE(name) ScopedTimer scopedTimer##__LINE__(name, PerformanceTimer::getInstance())
+// Macro that creates a scoped timer. These also feed the engine profiler timeline,
+// so names must be string literals.
+#define TIME_FUNCTION() JAG_PROFILE_FUNCTION(); ScopedTimer JAG_PROFILE_CONCAT(scopedTimer, __LINE__)(__FUNCTION__, PerformanceTimer::getInstance())
+#define TIME_SCOPE(name) JAG_PROFILE_SCOPE(name); ScopedTimer JAG_PROFILE_CONCAT(scopedTimer, __LINE__)(name, PerformanceTimer::getInstance())
 
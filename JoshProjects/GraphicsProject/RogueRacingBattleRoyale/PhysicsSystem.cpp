@@ -8,6 +8,7 @@
 #include <cmath>
 #include <algorithm>
 #include "AudioEngine.h"
+#include <JAGEngine/JobSystem.h>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
@@ -28,6 +29,8 @@ void PhysicsSystem::init(float gravityX, float gravityY) {
   worldDef.enqueueTask = enqueueTask;
   worldDef.finishTask = finishTask;
   worldDef.userTaskContext = this;
+  m_workerCount = std::min(std::max<int>(1, (int)JAGEngine::JobSystem::getInstance().getNumThreads()), MAX_PHYSICS_WORKERS);
+  worldDef.workerCount = m_workerCount;
   worldDef.enableContinuous = true;
   worldDef.restitutionThreshold = 0.5f;
   worldDef.contactPushoutVelocity = 3.0f;
@@ -56,6 +59,7 @@ void PhysicsSystem::update(float timeStep) {
         std::cerr << "World became invalid during step!" << std::endl;
         return;
       }
+      m_taskCount = 0;
       b2World_Step(m_worldId, fixedTimeStep, 1);
     }
 
@@ -252,8 +256,50 @@ bool PhysicsSystem::checkIsPowerup(b2BodyId bodyId) {
 
 void* PhysicsSystem::enqueueTask(b2TaskCallback* task, int32_t itemCount,
   int32_t minRange, void* taskContext, void* userContext) {
-  task(0, itemCount, 0, taskContext);
-  return nullptr;
+  PhysicsSystem* physics = static_cast<PhysicsSystem*>(userContext);
+  JAGEngine::JobSystem& jobSystem = JAGEngine::JobSystem::getInstance();
+
+  // Run inline when there's nobody to share with or we're out of task slots. Box2D
+  // keeps scratch space per worker index, so a thread index past the world's worker
+  // count (more than MAX_PHYSICS_WORKERS threads) can't run physics either.
+  if (!jobSystem.isInitialized() || (int)jobSystem.getNumThreads() > physics->m_workerCount ||
+    physics->m_taskCount == MAX_PHYSICS_TASKS) {
+    task(0, itemCount, 0, taskContext);
+    return nullptr;
+  }
+
+  // Single tasks (the solver workers, island split and tree rebuild all come in as 1, 1)
+  // have to run alongside each other, so only small ranges are worth doing here
+  bool isSingleTask = itemCount == 1 && minRange == 1;
+  if (!isSingleTask && itemCount <= minRange) {
+    task(0, itemCount, 0, taskContext);
+    return nullptr;
+  }
+
+  PhysicsTask& physicsTask = physics->m_tasks[physics->m_taskCount++];
+  physicsTask.task = task;
+  physicsTask.taskContext = taskContext;
+
+  JAGEngine::JobFunction runTask = [](void* data, uint32_t begin, uint32_t end) {
+    PhysicsTask* physicsTask = static_cast<PhysicsTask*>(data);
+    uint32_t workerIndex = (uint32_t)std::max(0, JAGEngine::JobSystem::getThreadIndex());
+    physicsTask->task((int32_t)begin, (int32_t)end, workerIndex, physicsTask->taskContext);
+  };
+
+  if (isSingleTask) {
+    JAGEngine::Job job;
+    job.function = runTask;
+    job.data = &physicsTask;
+    job.begin = 0;
+    job.end = 1;
+    job.counter = &physicsTask.counter;
+    jobSystem.run(job);
+  }
+  else {
+    jobSystem.parallelFor(runTask, &physicsTask, (uint32_t)itemCount, (uint32_t)std::max(1, minRange), physicsTask.counter);
+  }
+
+  return &physicsTask;
 }
 
 bool PhysicsSystem::isValidBody(b2BodyId bodyId) {
@@ -496,7 +542,8 @@ void* PhysicsSystem::tryGetUserData(b2BodyId bodyId) {
 }
 
 void PhysicsSystem::finishTask(void* taskPtr, void* userContext) {
-  // Nothing to do in single-threaded mode
+  PhysicsTask* physicsTask = static_cast<PhysicsTask*>(taskPtr);
+  JAGEngine::JobSystem::getInstance().wait(physicsTask->counter);
 }
 
 void PhysicsSystem::synchronizeTransforms() {
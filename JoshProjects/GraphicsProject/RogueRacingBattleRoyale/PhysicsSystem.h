@@ -6,6 +6,7 @@
 #include <memory>
 #include "ObjectProperties.h"
 #include "PhysicsCategories.h"
+#include <JAGEngine/JobSystem.h>
 
 class Car;
 class PlaceableObject;
@@ -77,6 +78,20 @@ private:
     void* taskContext, void* userContext);
   static void finishTask(void* taskPtr, void* userContext);
 
+  // Box2D tasks handed to the engine job system, reused every step
+  struct PhysicsTask {
+    b2TaskCallback* task = nullptr;
+    void* taskContext = nullptr;
+    JAGEngine::JobCounter counter;
+  };
+  // b2_maxWorkers in Box2D's core.h, which isn't part of its public headers
+  static constexpr int MAX_PHYSICS_WORKERS = 64;
+  // One solver task per worker each step plus a handful of range tasks
+  static constexpr int MAX_PHYSICS_TASKS = MAX_PHYSICS_WORKERS * 2;
+  PhysicsTask m_tasks[MAX_PHYSICS_TASKS];
+  int m_taskCount = 0;
+  int m_workerCount = 1;
+
   AudioEngine* m_audioEngine = nullptr;
 
 };
@@ -1,8 +1,8 @@
 // RaceTimer.cpp
 
 #include "RaceTimer.h"
-#include <iomanip>
-#include <sstream>
+#include <cmath>
+#include <cstdio>
 
 RaceTimer::RaceTimer() :
   m_elapsedTime(0.0f),
@@ -13,6 +13,8 @@ RaceTimer::RaceTimer() :
 }
 
 void RaceTimer::init(const char* fontPath, int fontSize) {
+  m_timeText.clear();
+  m_lapText.clear();
   m_font = std::make_unique<JAGEngine::SpriteFont>();
   m_font->init(fontPath, fontSize);
 }
@@ -36,24 +38,19 @@ void RaceTimer::update(float deltaTime) {
   }
 }
 
-std::string RaceTimer::formatTime() const {
+void RaceTimer::formatTime(char* buffer, size_t size) const {
   int hours = static_cast<int>(m_elapsedTime / 3600.0f);
   int minutes = static_cast<int>((m_elapsedTime / 60.0f)) % 60;
   int seconds = static_cast<int>(m_elapsedTime) % 60;
   int milliseconds = static_cast<int>((m_elapsedTime - std::floor(m_elapsedTime)) * 1000.0f);
 
-  std::stringstream ss;
-
   // Only show hours if we've reached 1 hour
   if (hours > 0) {
-    ss << std::setfill('0') << std::setw(2) << hours << ":";
+    snprintf(buffer, size, "%02d:%02d:%02d.%03d", hours, minutes, seconds, milliseconds);
+  }
+  else {
+    snprintf(buffer, size, "%02d:%02d.%03d", minutes, seconds, milliseconds);
   }
-
-  ss << std::setfill('0') << std::setw(2) << minutes << ":"
-    << std::setfill('0') << std::setw(2) << seconds << "."
-    << std::setfill('0') << std::setw(3) << milliseconds;
-
-  return ss.str();
 }
 
 void RaceTimer::draw(JAGEngine::SpriteBatch& batch, const JAGEngine::Camera2D& camera, int currentLap, int totalLaps) {
@@ -65,7 +62,9 @@ void RaceTimer::draw(JAGEngine::SpriteBatch& batch, const JAGEngine::Camera2D& c
   //std::cout << "Drawing race timer - Time: " << formatTime() << std::endl;
 
   // Draw the timer text
-  drawCenteredText(batch, camera, formatTime());
+  char timeText[32];
+  formatTime(timeText, sizeof(timeText));
+  drawCenteredText(batch, camera, timeText);
 
   // Draw lap count if provided
   if (currentLap >= 0 && totalLaps > 0) {
@@ -75,7 +74,7 @@ void RaceTimer::draw(JAGEngine::SpriteBatch& batch, const JAGEngine::Camera2D& c
 
 void RaceTimer::drawCenteredText(JAGEngine::SpriteBatch& batch,
   const JAGEngine::Camera2D& camera,
-  const std::string& text) {
+  const char* text) {
   // Calculate top-middle position (assuming camera position is center of screen)
   glm::vec2 screenDims = camera.getScreenDimensions();
   glm::vec2 topMiddle(
@@ -83,13 +82,13 @@ void RaceTimer::drawCenteredText(JAGEngine::SpriteBatch& batch,
     camera.getPosition().y + screenDims.y - 110.0f  // Top Y with small padding
   );
 
-  m_font->draw(batch,
-    text.c_str(),
-    topMiddle,
+  m_timeText.setText(*m_font,
+    text,
     glm::vec2(2.0f),  // Smaller scale for timer display
     0.0f,
     JAGEngine::ColorRGBA8(255, 255, 255, 255),  // White color
     JAGEngine::Justification::MIDDLE);
+  m_timeText.draw(batch, topMiddle);
 }
 
 void RaceTimer::drawLapCount(JAGEngine::SpriteBatch& batch,
@@ -104,12 +103,13 @@ void RaceTimer::drawLapCount(JAGEngine::SpriteBatch& batch,
     camera.getPosition().y + screenDims.y - 220.0f
   );
 
-  std::string text = "Lap " + std::to_string(currentLap) + "/" + std::to_string(totalLaps);
-  m_font->draw(batch,
-    text.c_str(),
-    pos,
+  char text[32];
+  snprintf(text, sizeof(text), "Lap %d/%d", currentLap, totalLaps);
+  m_lapText.setText(*m_font,
+    text,
     glm::vec2(2.0f),
     0.0f,
     JAGEngine::ColorRGBA8(255, 255, 255, 255),
     JAGEngine::Justification::MIDDLE);
+  m_lapText.draw(batch, pos);
 }
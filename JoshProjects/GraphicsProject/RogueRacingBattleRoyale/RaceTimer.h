@@ -11,7 +11,11 @@ class RaceTimer {
 public:
   RaceTimer();
   void init(const char* fontPath, int fontSize);
-  void setFont(JAGEngine::SpriteFont* font) { m_font.reset(font); }
+  void setFont(JAGEngine::SpriteFont* font) {
+    m_font.reset(font);
+    m_timeText.clear();
+    m_lapText.clear();
+  }
   void start();
   void stop();
   void reset();
@@ -23,11 +27,14 @@ public:
 
 private:
   std::unique_ptr<JAGEngine::SpriteFont> m_font;
+  // Kept between frames so only the digits that changed get new glyphs
+  JAGEngine::TextLayout m_timeText;
+  JAGEngine::TextLayout m_lapText;
   float m_elapsedTime;
   bool m_isRunning;
   static constexpr float MS_PRECISION = 100.0f;
 
-  std::string formatTime() const;
-  void drawCenteredText(JAGEngine::SpriteBatch& batch, const JAGEngine::Camera2D& camera, const std::string& text);
+  void formatTime(char* buffer, size_t size) const;
+  void drawCenteredText(JAGEngine::SpriteBatch& batch, const JAGEngine::Camera2D& camera, const char* text);
   void drawLapCount(JAGEngine::SpriteBatch& batch, const JAGEngine::Camera2D& camera, int currentLap, int totalLaps);
 };
@@ -20,6 +20,11 @@ namespace RacingAudio {
 
   static const AkRtpcID RTPC_COLLISION_VELOCITY = AK::GAME_PARAMETERS::COLLISION_VELOCITY;
   static const AkRtpcID RTPC_COLLISION_MASS = AK::GAME_PARAMETERS::COLLISION_MASS;
+
+  // Cap on everything Wwise allocates. Main.bnk keeps all of its media in memory and
+  // the music alone is about 84 MB of it. Past the cap Wwise fails the allocation
+  // (and the sound) instead of growing, and a warning is printed at 90%.
+  static const AkUInt64 AUDIO_MEMORY_BUDGET = 128ull * 1024 * 1024;
 }
 
 // Bank definitions
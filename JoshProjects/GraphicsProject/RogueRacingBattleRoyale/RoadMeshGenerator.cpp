@@ -115,7 +115,7 @@ RoadMeshGenerator::BarrierMeshData& RoadMeshGenerator::BarrierMeshData::operator
 
 RoadMeshGenerator::BarrierMeshData RoadMeshGenerator::generateBarrierMesh(const SplineTrack& track, int baseLOD) {
   BarrierMeshData mesh;
-  auto splinePoints = track.getSplinePoints(baseLOD);
+  const auto& splinePoints = track.getSplinePoints(baseLOD);
 
   if (splinePoints.size() < 2) return mesh;
 
@@ -399,7 +399,7 @@ glm::vec2 RoadMeshGenerator::calculateSmoothPerpendicular(
 
 RoadMeshGenerator::MeshData RoadMeshGenerator::generateRoadMesh(const SplineTrack& track, int baseLOD) {
   MeshData mesh;
-  auto splinePoints = track.getSplinePoints(baseLOD);
+  const auto& splinePoints = track.getSplinePoints(baseLOD);
 
   if (splinePoints.size() < 2) {
     std::cout << "Not enough spline points to generate mesh\n";
@@ -540,7 +540,7 @@ RoadMeshGenerator::StartLineMeshData RoadMeshGenerator::generateStartLineMesh(co
 
 RoadMeshGenerator::OffroadMeshData RoadMeshGenerator::generateOffroadMesh(const SplineTrack& track, int baseLOD) {
   OffroadMeshData mesh;
-  auto splinePoints = track.getSplinePoints(baseLOD);
+  const auto& splinePoints = track.getSplinePoints(baseLOD);
 
   if (splinePoints.size() < 2) return mesh;
 
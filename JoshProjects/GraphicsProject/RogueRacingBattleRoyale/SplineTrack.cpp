@@ -76,7 +76,7 @@ std::vector<SplineTrack::StartPosition> SplineTrack::calculateStartPositions() c
   const TrackNode* startNode = getStartLineNode();
   if (!startNode || m_nodes.size() < 4) return positions;
 
-  auto splinePoints = getSplinePoints(200);
+  const auto& splinePoints = getSplinePoints(200);
   if (splinePoints.empty()) return positions;
 
   // Find start line index
@@ -251,9 +251,10 @@ std::vector<SplineTrack::SplinePointInfo> SplineTrack::buildSplinePoints(int sub
   return points;
 }
 
-std::vector<SplineTrack::SplinePointInfo> SplineTrack::getSplinePoints(int subdivisions) const {
+const std::vector<SplineTrack::SplinePointInfo>& SplineTrack::getSplinePoints(int subdivisions) const {
+  static const std::vector<SplinePointInfo> s_empty;
   if (!m_cacheValid || m_nodes.empty() || subdivisions <= 0) {
-    return std::vector<SplinePointInfo>();
+    return s_empty;
   }
 
   // Check if we have this subdivision level cached
@@ -263,8 +264,8 @@ std::vector<SplineTrack::SplinePointInfo> SplineTrack::getSplinePoints(int subdi
   }
 
   // Build and cache the spline points for this subdivision level
-  auto points = buildSplinePoints(subdivisions);
-  m_splinePointCache[subdivisions] = points;
+  auto& points = m_splinePointCache[subdivisions];
+  points = buildSplinePoints(subdivisions);
   return points;
 }
 
@@ -340,7 +341,7 @@ glm::vec2 SplineTrack::getTrackDirectionAtNode(const TrackNode* node) const {
   if (!node || m_nodes.size() < 4) return glm::vec2(1, 0);
 
   // Get detailed spline points
-  auto splinePoints = getSplinePoints(200);  // High-resolution spline
+  const auto& splinePoints = getSplinePoints(200);  // High-resolution spline
   if (splinePoints.empty()) return glm::vec2(1, 0);
 
   // Find the index of the spline point closest to the node
@@ -379,7 +380,7 @@ glm::vec2 SplineTrack::getTrackDirectionAtNode(const TrackNode* node) const {
 std::vector<glm::vec2> SplineTrack::getBarrierVertices() const {
   std::vector<glm::vec2> barrierVertices;
 
-  auto splinePoints = getSplinePoints(200);  // Use appropriate subdivisions
+  const auto& splinePoints = getSplinePoints(200);  // Use appropriate subdivisions
 
   if (splinePoints.size() < 2) return barrierVertices;
 
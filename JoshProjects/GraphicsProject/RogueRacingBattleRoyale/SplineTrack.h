@@ -42,7 +42,8 @@ public:
       return m_startConfig.isClockwise ? "Clockwise" : "Counter-clockwise";
   }
   TrackNode* getNodeAtPosition(const glm::vec2& position, float threshold = 10.0f);
-  std::vector<SplinePointInfo> getSplinePoints(int subdivisions = 50) const;
+  // Cached per subdivision level. The reference stays valid until the track is edited.
+  const std::vector<SplinePointInfo>& getSplinePoints(int subdivisions = 50) const;
   const std::vector<TrackNode>& getNodes() const { return m_nodes; }
   std::vector<TrackNode>& getNodes() { return m_nodes; }
 
@@ -106,7 +106,7 @@ void WheelCollider::detectSurface() {
 
   SplineTrack* track = car->getTrack();
 
-  auto splinePoints = track->getSplinePoints(50);
+  const auto& splinePoints = track->getSplinePoints(50);
   if (splinePoints.empty()) {
     m_currentSurface = Surface::Grass;
     return;
@@ -14,17 +14,35 @@ void Agent::draw(JAGEngine::SpriteBatch& m_spriteBatch) {
   m_spriteBatch.draw(destRect, uvRect, m_textureID, 0.0f, _color, m_direction);
 }
 
-void Agent::collideWithLevel(const std::vector<std::string>& levelData) {
-  std::vector<glm::vec2> collideTilePositions;
-
-  // Check the four corners of the agent
-  checkTilePosition(levelData, collideTilePositions, _position.x - AGENT_WIDTH / 2, _position.y - AGENT_WIDTH / 2);
-  checkTilePosition(levelData, collideTilePositions, _position.x + AGENT_WIDTH / 2, _position.y - AGENT_WIDTH / 2);
-  checkTilePosition(levelData, collideTilePositions, _position.x - AGENT_WIDTH / 2, _position.y + AGENT_WIDTH / 2);
-  checkTilePosition(levelData, collideTilePositions, _position.x + AGENT_WIDTH / 2, _position.y + AGENT_WIDTH / 2);
+void Agent::collideWithLevel(const Level& level) {
+  // Agents are narrower than a tile, so the four corners are in at most a 2x2 block
+  const int left = static_cast<int>(std::floor((_position.x - AGENT_WIDTH / 2) / TILE_WIDTH));
+  const int right = static_cast<int>(std::floor((_position.x + AGENT_WIDTH / 2) / TILE_WIDTH));
+  const int bottom = static_cast<int>(std::floor((_position.y - AGENT_WIDTH / 2) / TILE_WIDTH));
+  const int top = static_cast<int>(std::floor((_position.y + AGENT_WIDTH / 2) / TILE_WIDTH));
+
+  // A bit per corner, dropping corners that share a tile with an earlier one
+  unsigned int solidCorners = level.isSolid(left, bottom) |
+    (level.isSolid(right, bottom) << 1) |
+    (level.isSolid(left, top) << 2) |
+    (level.isSolid(right, top) << 3);
+  if (left == right) solidCorners &= 0x5;
+  if (bottom == top) solidCorners &= 0x3;
+
+  // Nearly every call is out in the open and stops here
+  if (solidCorners == 0) {
+    return;
+  }
 
-  for (int i = 0; i < collideTilePositions.size(); i++) {
-    collideWithTile(collideTilePositions[i]);
+  // Every corner is tested before any is resolved, so pushing out of one tile can't
+  // hide another
+  const int tileXs[2] = { left, right };
+  const int tileYs[2] = { bottom, top };
+  for (int corner = 0; corner < 4; corner++) {
+    if (solidCorners & (1u << corner)) {
+      collideWithTile(glm::vec2(tileXs[corner & 1] * TILE_WIDTH + TILE_WIDTH / 2.0f,
+        tileYs[corner >> 1] * TILE_WIDTH + TILE_WIDTH / 2.0f));
+    }
   }
 }
 
@@ -62,22 +80,6 @@ bool Agent::collideWithAgent(Agent* agent) {
 
 }
 
-void Agent::checkTilePosition(const std::vector<std::string>& levelData,
-  std::vector<glm::vec2>& collideTilePositions,
-  float x, float y) {
-  glm::vec2 cornerPos = glm::vec2(std::floor(x / TILE_WIDTH),
-    std::floor(y / TILE_WIDTH));
-
-  if (cornerPos.y >= 0 && cornerPos.y < levelData.size() &&
-    cornerPos.x >= 0 && cornerPos.x < levelData[cornerPos.y].size()) {
-    if (levelData[cornerPos.y][cornerPos.x] != '.') {
-      collideTilePositions.emplace_back(cornerPos.x * TILE_WIDTH + TILE_WIDTH / 2.0f,
-        cornerPos.y * TILE_WIDTH + TILE_WIDTH / 2.0f);
-    }
-  }
-
-}
-
 void Agent::collideWithTile(glm::vec2 tilePos) {
 
   const float TILE_RADIUS = TILE_WIDTH / 2.0f;
@@ -10,6 +10,9 @@ const float AGENT_RADIUS = AGENT_WIDTH / 2.0f;
 
 class Zombie;
 class Human;
+class FlowField;
+class Level;
+class LineOfSight;
 
 class Agent
 {
@@ -17,12 +20,15 @@ public:
   Agent();
   virtual ~Agent();
 
-  virtual void update(const std::vector<std::string>& levelData,
+  virtual void update(const Level& level,
     std::vector<Human*>& humans,
     std::vector<Zombie*>& zombies,
+    const FlowField& humanField,
+    const FlowField& zombieField,
+    LineOfSight& lineOfSight,
     float deltaTime) = 0;
 
-  void collideWithLevel(const std::vector<std::string>& levelData);
+  void collideWithLevel(const Level& level);
 
   bool collideWithAgent(Agent* agent);
 
@@ -34,8 +40,6 @@ public:
   
 protected:
 
-  void checkTilePosition(const std::vector<std::string>& levelData, std::vector<glm::vec2>& collideTilePositions, float x, float y);
-
   void collideWithTile(glm::vec2 tilePos);
 
   glm::vec2 _position;
@@ -0,0 +1,139 @@
+//AgentGrid.cpp
+
+#include "AgentGrid.h"
+#include "Bullet.h"
+#include "Human.h"
+#include "Zombie.h"
+#include "Level.h"
+
+#include <algorithm>
+#include <cmath>
+
+AgentGrid::AgentGrid() {
+}
+
+AgentGrid::~AgentGrid() {
+}
+
+void AgentGrid::init(int numXCells, int numYCells) {
+  m_numXCells = std::max(numXCells, 1);
+  m_numYCells = std::max(numYCells, 1);
+  m_cellStarts.assign(m_numXCells * m_numYCells + 1, 0);
+  m_unsorted.clear();
+  m_entries.clear();
+}
+
+void AgentGrid::build(const std::vector<Human*>& humans, const std::vector<Zombie*>& zombies) {
+  m_unsorted.clear();
+  m_agentCells.clear();
+  for (int i = 0; i < humans.size(); i++) {
+    addEntry(humans[i], i, false);
+  }
+  for (int i = 0; i < zombies.size(); i++) {
+    addEntry(zombies[i], i, true);
+  }
+
+  // Count the agents in each cell, shifted by one so the prefix sum below leaves
+  // each cell's start in place
+  const int numCells = m_numXCells * m_numYCells;
+  std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0);
+  for (int cell : m_agentCells) {
+    m_cellStarts[cell + 1]++;
+  }
+  for (int c = 0; c < numCells; c++) {
+    m_cellStarts[c + 1] += m_cellStarts[c];
+  }
+
+  m_entries.resize(m_unsorted.size());
+  for (int i = 0; i < m_unsorted.size(); i++) {
+    m_entries[m_cellStarts[m_agentCells[i]]++] = m_unsorted[i];
+  }
+
+  // The scatter moved every start to the next cell's start, shift them back
+  for (int c = numCells; c > 0; c--) {
+    m_cellStarts[c] = m_cellStarts[c - 1];
+  }
+  m_cellStarts[0] = 0;
+}
+
+void AgentGrid::findPairs(std::vector<Pair>& pairs) const {
+  pairs.clear();
+
+  // Each cell pairs with itself and the four neighbours after it, so every pair of
+  // neighbouring cells comes up once
+  const int NUM_NEIGHBOURS = 4;
+  const int NEIGHBOUR_X[NUM_NEIGHBOURS] = { 1, -1, 0, 1 };
+  const int NEIGHBOUR_Y[NUM_NEIGHBOURS] = { 0, 1, 1, 1 };
+
+  for (int y = 0; y < m_numYCells; y++) {
+    for (int x = 0; x < m_numXCells; x++) {
+      const int cell = y * m_numXCells + x;
+      const int cellEnd = m_cellStarts[cell + 1];
+      for (int a = m_cellStarts[cell]; a < cellEnd; a++) {
+        for (int b = a + 1; b < cellEnd; b++) {
+          pairs.push_back(Pair{ a, b });
+        }
+        for (int n = 0; n < NUM_NEIGHBOURS; n++) {
+          int nx = x + NEIGHBOUR_X[n];
+          int ny = y + NEIGHBOUR_Y[n];
+          if (nx < 0 || nx >= m_numXCells || ny >= m_numYCells) {
+            continue;
+          }
+          int neighbour = ny * m_numXCells + nx;
+          for (int b = m_cellStarts[neighbour]; b < m_cellStarts[neighbour + 1]; b++) {
+            pairs.push_back(Pair{ a, b });
+          }
+        }
+      }
+    }
+  }
+}
+
+void AgentGrid::findNear(const glm::vec2& pos, std::vector<int>& entries) const {
+  entries.clear();
+  const int cell = getCellIndex(pos);
+  const int x = cell % m_numXCells;
+  const int y = cell / m_numXCells;
+
+  // Cells in a row are stored back to back, so each row of three is one range
+  const int firstX = std::max(x - 1, 0);
+  const int lastX = std::min(x + 1, m_numXCells - 1);
+  for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, m_numYCells - 1); ny++) {
+    int begin = m_cellStarts[ny * m_numXCells + firstX];
+    int end = m_cellStarts[ny * m_numXCells + lastX + 1];
+    for (int e = begin; e < end; e++) {
+      entries.push_back(e);
+    }
+  }
+}
+
+AgentGrid::Entry* AgentGrid::findBulletHit(Bullet& bullet, const Agent* ignore, std::vector<int>& nearby) {
+  Entry* hit = nullptr;
+  findNear(bullet.getPosition(), nearby);
+  for (int e : nearby) {
+    Entry* entry = &m_entries[e];
+    if (!entry->isAlive || entry->agent == ignore || (hit && !entry->isZombie)) {
+      continue;
+    }
+    if (bullet.collideWithAgent(entry->agent)) {
+      hit = entry;
+      if (hit->isZombie) {
+        break;
+      }
+    }
+  }
+  return hit;
+}
+
+int AgentGrid::getCellIndex(const glm::vec2& pos) const {
+  int x = static_cast<int>(std::floor(pos.x / TILE_WIDTH));
+  int y = static_cast<int>(std::floor(pos.y / TILE_WIDTH));
+  x = std::min(std::max(x, 0), m_numXCells - 1);
+  y = std::min(std::max(y, 0), m_numYCells - 1);
+  return y * m_numXCells + x;
+}
+
+void AgentGrid::addEntry(Agent* agent, int index, bool isZombie) {
+  m_unsorted.push_back(Entry{ agent, index, isZombie, true });
+  m_agentCells.push_back(getCellIndex(agent->getPosition()));
+}
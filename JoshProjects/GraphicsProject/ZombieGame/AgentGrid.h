@@ -0,0 +1,82 @@
+//AgentGrid.h
+
+#pragma once
+
+#include "Agent.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+class Bullet;
+class Human;
+class Zombie;
+
+// Buckets every human and zombie by the level tile under it, so collisions only test
+// agents in neighbouring tiles instead of every agent against every other. Agents and
+// bullets are both narrower than a tile, so anything touching an agent is at most one
+// tile away.
+class AgentGrid
+{
+public:
+  struct Entry {
+    Agent* agent;
+    int index;     ///< Index into the humans or zombies the grid was built from
+    bool isZombie;
+    bool isAlive;  ///< Cleared when the agent is killed or turned, so later queries skip it
+  };
+
+  struct Pair {
+    int a;
+    int b;
+  };
+
+  AgentGrid();
+  ~AgentGrid();
+
+  /// One cell per level tile. Agents off the level go in the edge cells.
+  void init(int numXCells, int numYCells);
+
+  /// Buckets every agent with a counting sort. Earlier entries and pairs are invalid
+  /// afterwards.
+  void build(const std::vector<Human*>& humans, const std::vector<Zombie*>& zombies);
+
+  /// Every two entries in the same or neighbouring cells, each pair once. Whether they
+  /// actually touch is up to the caller.
+  void findPairs(std::vector<Pair>& pairs) const;
+  /// Entries in the 3x3 cells around pos
+  void findNear(const glm::vec2& pos, std::vector<int>& entries) const;
+
+  /// Pushes apart every two live entries that overlap and calls onTouch(a, b) for each
+  /// pair, in order. Entries that onTouch marks dead are skipped from then on.
+  template <typename OnTouch>
+  void collidePairs(std::vector<Pair>& pairs, OnTouch&& onTouch) {
+    findPairs(pairs);
+    for (const Pair& pair : pairs) {
+      Entry& a = m_entries[pair.a];
+      Entry& b = m_entries[pair.b];
+      if (!a.isAlive || !b.isAlive) {
+        continue;
+      }
+      if (a.agent->collideWithAgent(b.agent)) {
+        onTouch(a, b);
+      }
+    }
+  }
+
+  /// The live entry the bullet hits, or nullptr. Zombies take the hit before humans, and
+  /// ignore (the player, say) is never hit. nearby is scratch for findNear.
+  Entry* findBulletHit(Bullet& bullet, const Agent* ignore, std::vector<int>& nearby);
+
+  Entry& getEntry(int entry) { return m_entries[entry]; }
+  int getNumEntries() const { return static_cast<int>(m_entries.size()); }
+
+private:
+  int getCellIndex(const glm::vec2& pos) const;
+  void addEntry(Agent* agent, int index, bool isZombie);
+
+  int m_numXCells = 0;
+  int m_numYCells = 0;
+  std::vector<int> m_cellStarts; ///< First entry of each cell plus an end marker
+  std::vector<int> m_agentCells; ///< Cell of each agent before sorting
+  std::vector<Entry> m_unsorted; ///< Scratch for build
+  std::vector<Entry> m_entries;  ///< Every agent, sorted by cell
+};
@@ -0,0 +1,130 @@
+//Benchmark.cpp
+
+#include "Benchmark.h"
+#include "AgentGrid.h"
+#include "Bullet.h"
+#include "Human.h"
+#include "Level.h"
+#include "Zombie.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+  const int ZOMBIE_COUNTS[] = { 500, 2000, 10000 };
+  const int ZOMBIES_PER_HUMAN = 10;
+  const int NUM_BULLETS = 1000;
+  const int DEFAULT_STEPS = 10;
+  const int LEVEL_WIDTH = 128;
+  const int LEVEL_HEIGHT = 44;
+
+  // init() loads a texture, which needs a window. Only the position matters here.
+  class BenchmarkHuman : public Human {
+  public:
+    explicit BenchmarkHuman(const glm::vec2& pos) { _position = pos; }
+  };
+
+  class BenchmarkZombie : public Zombie {
+  public:
+    explicit BenchmarkZombie(const glm::vec2& pos) { _position = pos; }
+  };
+
+  struct BenchmarkResult {
+    double buildMs;
+    double pairMs;
+    double bulletMs;
+    int numTouching; ///< Touching agent pairs in the last step
+    int numHits;     ///< Bullets that hit something in the last step
+  };
+
+  double msSince(std::chrono::steady_clock::time_point startTime) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  }
+
+  BenchmarkResult runSteps(int numZombies, int steps) {
+    // Fixed seed so runs can be compared. Some agents start just off the level, like
+    // ones pushed out by a crowd.
+    std::mt19937 randomEngine(1);
+    std::uniform_real_distribution<float> randX(-50.0f, LEVEL_WIDTH * TILE_WIDTH + 50.0f);
+    std::uniform_real_distribution<float> randY(-50.0f, LEVEL_HEIGHT * TILE_WIDTH + 50.0f);
+    std::uniform_real_distribution<float> randDir(-1.0f, 1.0f);
+
+    std::vector<Human*> humans;
+    std::vector<Zombie*> zombies;
+    for (int i = 0; i < numZombies; i++) {
+      zombies.push_back(new BenchmarkZombie(glm::vec2(randX(randomEngine), randY(randomEngine))));
+    }
+    for (int i = 0; i < numZombies / ZOMBIES_PER_HUMAN; i++) {
+      humans.push_back(new BenchmarkHuman(glm::vec2(randX(randomEngine), randY(randomEngine))));
+    }
+    std::vector<Bullet> bullets;
+    for (int i = 0; i < NUM_BULLETS; i++) {
+      glm::vec2 direction(randDir(randomEngine), randDir(randomEngine));
+      bullets.emplace_back(glm::vec2(randX(randomEngine), randY(randomEngine)), direction, 10.0f, 20.0f);
+    }
+
+    AgentGrid agentGrid;
+    agentGrid.init(LEVEL_WIDTH, LEVEL_HEIGHT);
+    std::vector<AgentGrid::Pair> agentPairs;
+    std::vector<int> nearbyAgents;
+
+    BenchmarkResult result = {};
+    for (int step = 0; step < steps; step++) {
+      auto startTime = std::chrono::steady_clock::now();
+      agentGrid.build(humans, zombies);
+      result.buildMs += msSince(startTime);
+
+      // The collision pass from MainGame::updateAgents, minus the biting. Collisions push
+      // the agents apart, so later steps have fewer touching pairs.
+      startTime = std::chrono::steady_clock::now();
+      result.numTouching = 0;
+      agentGrid.collidePairs(agentPairs, [&](AgentGrid::Entry&, AgentGrid::Entry&) {
+        result.numTouching++;
+      });
+      result.pairMs += msSince(startTime);
+
+      // The hit test from MainGame::updateBullets, minus the damage, with the grid rebuilt
+      // after the agents moved
+      agentGrid.build(humans, zombies);
+      startTime = std::chrono::steady_clock::now();
+      result.numHits = 0;
+      for (Bullet& bullet : bullets) {
+        if (agentGrid.findBulletHit(bullet, nullptr, nearbyAgents)) {
+          result.numHits++;
+        }
+      }
+      result.bulletMs += msSince(startTime);
+    }
+
+    result.buildMs /= steps;
+    result.pairMs /= steps;
+    result.bulletMs /= steps;
+
+    for (Human* human : humans) {
+      delete human;
+    }
+    for (Zombie* zombie : zombies) {
+      delete zombie;
+    }
+    return result;
+  }
+}
+
+int runBenchmark(int argc, char** argv) {
+  int steps = argc > 0 ? std::atoi(argv[0]) : DEFAULT_STEPS;
+  if (steps <= 0) {
+    std::printf("Usage: ZombieGame --benchmark [steps]\n");
+    return 1;
+  }
+
+  std::printf("%d steps on a %dx%d level, %d bullets\n", steps, LEVEL_WIDTH, LEVEL_HEIGHT, NUM_BULLETS);
+  std::printf("  agents     build     pairs   bullets   touching   hits\n");
+  for (int numZombies : ZOMBIE_COUNTS) {
+    BenchmarkResult result = runSteps(numZombies, steps);
+    int numAgents = numZombies + numZombies / ZOMBIES_PER_HUMAN;
+    std::printf("%8d  %6.3f ms %6.3f ms %6.3f ms %10d %6d\n", numAgents, result.buildMs, result.pairMs,
+      result.bulletMs, result.numTouching, result.numHits);
+  }
+  return 0;
+}
@@ -0,0 +1,10 @@
+//Benchmark.h
+
+#pragma once
+
+// Headless timing run, started with "ZombieGame --benchmark [steps]". Scatters 550,
+// 2200 and 11000 agents (a human for every ten zombies) over a 128x44 tile level
+// without opening a window, and prints the ms per step of the AgentGrid build, the
+// agent pair pass and a pass of 1000 bullets for each.
+// Returns the exit code for main.
+int runBenchmark(int argc, char** argv);
@@ -18,9 +18,9 @@ Bullet::~Bullet() {
 
 }
 
-bool Bullet::update(const std::vector<std::string>& levelData, float deltaTime) {
+bool Bullet::update(const Level& level, float deltaTime) {
   _position += _direction * _speed * deltaTime;
-  return collideWithWorld(levelData);
+  return collideWithWorld(level);
 }
 
 void Bullet::draw(JAGEngine::SpriteBatch& spriteBatch) {
@@ -34,19 +34,13 @@ void Bullet::draw(JAGEngine::SpriteBatch& spriteBatch) {
   spriteBatch.draw(destRect, uvRect, JAGEngine::ResourceManager::getTexture("Textures/zombie_game/bullet.png").id, 0.0f, color);
 }
 
-bool Bullet::collideWithWorld(const std::vector<std::string>& levelData) {
+bool Bullet::collideWithWorld(const Level& level) {
   glm::ivec2 gridPosition;
   gridPosition.x = floor(_position.x / (float)TILE_WIDTH);
   gridPosition.y = floor(_position.y / (float)TILE_WIDTH);
 
-  // Check if the bullet is out of bounds
-  if (gridPosition.y < 0 || gridPosition.y >= levelData.size() ||
-    gridPosition.x < 0 || gridPosition.x >= levelData[0].size()) {
-    return true; // Collided (out of bounds)
-  }
-
-  // Check if the bullet hit a wall
-  return (levelData[gridPosition.y][gridPosition.x] != '.');
+  // Check if the bullet hit a wall, out of bounds counts too
+  return level.isSolid(gridPosition.x, gridPosition.y);
 }
 
 bool Bullet::collideWithAgent(Agent* agent) {
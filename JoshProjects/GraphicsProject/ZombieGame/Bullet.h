@@ -9,6 +9,7 @@
 class Human;
 class Zombie;
 class Agent;
+class Level;
 
 const int BULLET_RADIUS = 10;
 
@@ -18,7 +19,7 @@ public:
   Bullet(glm::vec2 position, glm::vec2 direction, float damage, float speed);
   ~Bullet();
 
-  bool update(const std::vector<std::string>& levelData, float deltaTime);
+  bool update(const Level& level, float deltaTime);
 
   void draw(JAGEngine::SpriteBatch& spriteBatch);
 
@@ -29,7 +30,7 @@ public:
   glm::vec2 getPosition() const { return _position; }
 
 private:
-  bool collideWithWorld(const std::vector<std::string>& levelData);
+  bool collideWithWorld(const Level& level);
 
   int _damage;
   glm::vec2 _position;
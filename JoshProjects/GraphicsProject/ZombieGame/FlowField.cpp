@@ -0,0 +1,180 @@
+//FlowField.cpp
+
+#include "FlowField.h"
+#include "Level.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  const int UNREACHED = -1;
+  const float UNREACHABLE_DISTANCE = 9999999.0f;
+
+  // Orthogonal steps first, so straight corridors don't zig zag
+  const int NUM_STEPS = 8;
+  const int STEP_X[NUM_STEPS] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+  const int STEP_Y[NUM_STEPS] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+  glm::vec2 safeNormalize(const glm::vec2& v) {
+    float length = glm::length(v);
+    if (length < 0.0001f) {
+      return glm::vec2(0.0f);
+    }
+    return v / length;
+  }
+}
+
+FlowField::FlowField() {
+}
+
+FlowField::~FlowField() {
+}
+
+void FlowField::init(const Level& level) {
+  m_width = level.getWidth();
+  m_height = level.getHeight();
+
+  const int numTiles = m_width * m_height;
+  m_walkable.resize(numTiles);
+  for (int y = 0; y < m_height; y++) {
+    for (int x = 0; x < m_width; x++) {
+      m_walkable[y * m_width + x] = !level.isSolid(x, y);
+    }
+  }
+
+  m_distances.assign(numTiles, UNREACHED);
+  m_nearestSources.assign(numTiles, UNREACHED);
+  m_nextTiles.assign(numTiles, UNREACHED);
+  m_queue.reserve(numTiles);
+  m_sources.clear();
+}
+
+void FlowField::build(const std::vector<glm::vec2>& sources) {
+  m_sources = sources;
+  std::fill(m_distances.begin(), m_distances.end(), UNREACHED);
+  m_queue.clear();
+
+  // Every source starts in the queue, so each tile ends up with the closest one
+  for (int i = 0; i < static_cast<int>(m_sources.size()); i++) {
+    int tile = getTileIndex(m_sources[i]);
+    if (tile == -1 || !m_walkable[tile] || m_distances[tile] != UNREACHED) {
+      continue;
+    }
+    m_distances[tile] = 0;
+    m_nearestSources[tile] = i;
+    m_nextTiles[tile] = tile;
+    m_queue.push_back(tile);
+  }
+
+  // Every tile is queued at most once, so the queue is just a cursor into the vector
+  for (size_t head = 0; head < m_queue.size(); head++) {
+    const int tile = m_queue[head];
+    const int x = tile % m_width;
+    const int y = tile / m_width;
+    for (int s = 0; s < NUM_STEPS; s++) {
+      if (!canStep(x, y, STEP_X[s], STEP_Y[s])) {
+        continue;
+      }
+      int neighbour = tile + STEP_Y[s] * m_width + STEP_X[s];
+      if (m_distances[neighbour] != UNREACHED) {
+        continue;
+      }
+      m_distances[neighbour] = m_distances[tile] + 1;
+      m_nearestSources[neighbour] = m_nearestSources[tile];
+      m_nextTiles[neighbour] = tile;
+      m_queue.push_back(neighbour);
+    }
+  }
+}
+
+bool FlowField::isReachable(const glm::vec2& pos) const {
+  int tile = getTileIndex(pos);
+  return tile != -1 && m_distances[tile] != UNREACHED;
+}
+
+float FlowField::getDistance(const glm::vec2& pos) const {
+  int tile = getTileIndex(pos);
+  if (tile == -1 || m_distances[tile] == UNREACHED) {
+    return UNREACHABLE_DISTANCE;
+  }
+  if (m_distances[tile] == 0) {
+    return glm::distance(pos, m_sources[m_nearestSources[tile]]);
+  }
+  return static_cast<float>(m_distances[tile] * TILE_WIDTH);
+}
+
+int FlowField::getNearestSource(const glm::vec2& pos) const {
+  int tile = getTileIndex(pos);
+  if (tile == -1 || m_distances[tile] == UNREACHED) {
+    return -1;
+  }
+  return m_nearestSources[tile];
+}
+
+glm::vec2 FlowField::getDirection(const glm::vec2& pos) const {
+  int tile = getTileIndex(pos);
+  if (tile == -1 || m_distances[tile] == UNREACHED) {
+    return glm::vec2(0.0f);
+  }
+
+  // Once the source is in this tile or the next there are no walls left in the way
+  int nextTile = m_nextTiles[tile];
+  if (m_distances[nextTile] == 0) {
+    return safeNormalize(m_sources[m_nearestSources[tile]] - pos);
+  }
+  return safeNormalize(getTileCenter(nextTile) - pos);
+}
+
+glm::vec2 FlowField::getFleeDirection(const glm::vec2& pos) const {
+  int tile = getTileIndex(pos);
+  if (tile == -1 || m_distances[tile] == UNREACHED) {
+    return glm::vec2(0.0f);
+  }
+
+  const int x = tile % m_width;
+  const int y = tile / m_width;
+  int bestTile = tile;
+  for (int s = 0; s < NUM_STEPS; s++) {
+    if (!canStep(x, y, STEP_X[s], STEP_Y[s])) {
+      continue;
+    }
+    int neighbour = tile + STEP_Y[s] * m_width + STEP_X[s];
+    if (m_distances[neighbour] > m_distances[bestTile]) {
+      bestTile = neighbour;
+    }
+  }
+
+  if (bestTile == tile) {
+    return safeNormalize(pos - m_sources[m_nearestSources[tile]]);
+  }
+  return safeNormalize(getTileCenter(bestTile) - pos);
+}
+
+int FlowField::getTileIndex(const glm::vec2& pos) const {
+  int x = static_cast<int>(std::floor(pos.x / TILE_WIDTH));
+  int y = static_cast<int>(std::floor(pos.y / TILE_WIDTH));
+  if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+    return -1;
+  }
+  return y * m_width + x;
+}
+
+glm::vec2 FlowField::getTileCenter(int tile) const {
+  return glm::vec2((tile % m_width) * TILE_WIDTH + TILE_WIDTH / 2.0f,
+    (tile / m_width) * TILE_WIDTH + TILE_WIDTH / 2.0f);
+}
+
+bool FlowField::canStep(int x, int y, int dx, int dy) const {
+  int nx = x + dx;
+  int ny = y + dy;
+  if (nx < 0 || nx >= m_width || ny < 0 || ny >= m_height) {
+    return false;
+  }
+  if (!m_walkable[ny * m_width + nx]) {
+    return false;
+  }
+  if (dx != 0 && dy != 0) {
+    return m_walkable[y * m_width + nx] && m_walkable[ny * m_width + x];
+  }
+  return true;
+}
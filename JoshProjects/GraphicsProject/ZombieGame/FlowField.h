@@ -0,0 +1,58 @@
+//FlowField.h
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+class Level;
+
+// Path distance from every walkable tile to the nearest of a set of agents, built with
+// one breadth first search from all of them at once. Steps go to all 8 neighbours, but
+// never diagonally past a wall corner. Following the field walks around walls, and
+// every agent looks up its next step in O(1) no matter how many sources there are.
+class FlowField
+{
+public:
+  FlowField();
+  ~FlowField();
+
+  /// Takes the walls from the level
+  void init(const Level& level);
+
+  /// Refills the field from the agents at these positions. Sources on a wall or off the
+  /// level are skipped.
+  void build(const std::vector<glm::vec2>& sources);
+
+  /// False if no source can be walked to from here
+  bool isReachable(const glm::vec2& pos) const;
+  /// Path length to the nearest source in world units, huge if unreachable
+  float getDistance(const glm::vec2& pos) const;
+  /// Index into the last build's sources of the nearest one, -1 if unreachable
+  int getNearestSource(const glm::vec2& pos) const;
+
+  /// Unit vector for the next step toward the nearest source. Heads for the centre of
+  /// the next tile so agents keep clear of wall corners, and straight at the source
+  /// once they share a tile. Zero if unreachable.
+  glm::vec2 getDirection(const glm::vec2& pos) const;
+  /// Unit vector for the next step away from every source. Heads straight away from
+  /// the nearest one when cornered. Zero if unreachable.
+  glm::vec2 getFleeDirection(const glm::vec2& pos) const;
+
+private:
+  /// Tile under pos, -1 if off the level
+  int getTileIndex(const glm::vec2& pos) const;
+  glm::vec2 getTileCenter(int tile) const;
+  /// Whether a step from tile (x, y) by (dx, dy) stays on the level and off the walls. A
+  /// diagonal also needs both tiles it passes between to be walkable.
+  bool canStep(int x, int y, int dx, int dy) const;
+
+  int m_width = 0;
+  int m_height = 0;
+  std::vector<unsigned char> m_walkable;
+  std::vector<int> m_distances;      ///< Tile steps to the nearest source
+  std::vector<int> m_nearestSources; ///< Source each tile was reached from
+  std::vector<int> m_nextTiles;      ///< Neighbour the search reached each tile from
+  std::vector<int> m_queue;          ///< BFS queue, kept between builds
+  std::vector<glm::vec2> m_sources;
+};
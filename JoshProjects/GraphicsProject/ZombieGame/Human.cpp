@@ -2,6 +2,7 @@
 
 #include "Human.h"
 #include "Zombie.h"
+#include "FlowField.h"
 #include <random>
 #include <ctime>
 #include <SDL/SDL.h>
@@ -24,26 +25,26 @@ Human::~Human() {
 
 }
 
-void Human::update(const std::vector<std::string>& levelData,
+void Human::update(const Level& level,
   std::vector<Human*>& humans,
   std::vector<Zombie*>& zombies,
+  const FlowField& humanField,
+  const FlowField& zombieField,
+  LineOfSight& lineOfSight,
   float deltaTime) {
   const int UPDATE_CAP = 60;
-  Zombie* closestZombie = getNearestZombie(zombies);
-  float closestDistance = 99999.0f;
   static std::mt19937 randomEngine(time(nullptr));
   static std::uniform_real_distribution<float> randRotate(-90.0f, 90.0f);
 
-  // Calculate the distance to the closest zombie if one exists
-  if (closestZombie != nullptr) {
-    glm::vec2 zombiePosition = closestZombie->getPosition();
-    closestDistance = glm::distance(zombiePosition, _position);
+  // Zombies behind a wall are only as close as the walk around it
+  glm::vec2 fleeDirection(0.0f);
+  if (zombieField.getDistance(_position) < FLEE_DISTANCE) {
+    fleeDirection = zombieField.getFleeDirection(_position);
   }
 
   // flee
-  if (closestZombie != nullptr && closestDistance < FLEE_DISTANCE) {
-    glm::vec2 direction = glm::normalize(_position - closestZombie->getPosition());
-    _position += direction * _speed * deltaTime;
+  if (fleeDirection != glm::vec2(0.0f)) {
+    _position += fleeDirection * _speed * deltaTime;
   }
   else {
     // random movement
@@ -63,7 +64,7 @@ void Human::update(const std::vector<std::string>& levelData,
     }
   }
 
-  collideWithLevel(levelData);
+  collideWithLevel(level);
 }
 
 void Human::init(float speed, glm::vec2 pos) {
@@ -88,21 +89,3 @@ void Human::init(float speed, glm::vec2 pos) {
   m_direction = glm::normalize(m_direction);
   m_textureID = JAGEngine::ResourceManager::getTexture("Textures/zombie_game/spr_npc.png").id;
 }
-
-
-Zombie* Human::getNearestZombie(std::vector<Zombie*>& zombies) {
-  Zombie* closestZombie = nullptr;
-  float smallestDistance = 99999;
-
-  for (int i = 0; i < zombies.size(); i++) {
-    glm::vec2 distVec = zombies[i]->getPosition() - _position;
-    float distance = glm::length(distVec);
-
-    if (distance < smallestDistance) {
-      smallestDistance = distance;
-      closestZombie = zombies[i];
-    }
-  }
-
-  return closestZombie;
-}
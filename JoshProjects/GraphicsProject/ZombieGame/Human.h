@@ -11,9 +11,12 @@ public:
   Human();
   virtual ~Human();
   void init(float speed, glm::vec2 pos);
-  virtual void update(const std::vector<std::string>& levelData,
+  virtual void update(const Level& level,
     std::vector<Human*>& humans,
     std::vector<Zombie*>& zombies,
+    const FlowField& humanField,
+    const FlowField& zombieField,
+    LineOfSight& lineOfSight,
     float deltaTime) override;
 
   // Add these public methods
@@ -21,7 +24,6 @@ public:
   void incrementZombify(float amount) { _zombify += amount; }
 
 private:
-  Zombie* getNearestZombie(std::vector<Zombie*>& zombies);
   int _frames;
   int _nextUpdateFrame;
   float _zombify = 0.0f;
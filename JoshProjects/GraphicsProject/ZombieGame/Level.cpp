@@ -2,7 +2,10 @@
 #include <JAGEngine/JAGErrors.h>
 #include <fstream>
 #include <JAGEngine/ResourceManager.h>
+#include <JAGEngine/Camera2D.h>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 Level::Level(const std::string& fileName) {
   std::ifstream file;
@@ -15,94 +18,156 @@ Level::Level(const std::string& fileName) {
   file >> tmp >> _numHumans;
   std::getline(file, tmp); //throw away the rest of the 1st line
   //read the level data;
+  std::vector<std::string> rows;
   while (std::getline(file, tmp)) {
-    _levelData.push_back(tmp);
+    rows.push_back(tmp);
+  }
+  if (rows.empty()) {
+    throw std::runtime_error("No tiles in " + fileName);
   }
 
-  std::cout << "Level data loaded. Width: " << _levelData[0].size() << ", Height: " << _levelData.size() << std::endl;
+  m_height = static_cast<int>(rows.size());
+  for (const std::string& row : rows) {
+    m_width = std::max(m_width, static_cast<int>(row.size()));
+  }
+  m_rowWords = (m_width + 63) / 64;
 
-  m_spriteBatch.init();
-  m_spriteBatch.begin();
-  glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
-  JAGEngine::ColorRGBA8 whiteColor;
-  whiteColor.r = 255;
-  whiteColor.g = 255;
-  whiteColor.b = 255;
-  whiteColor.a = 255;
-  //render all the tiles
-  for (int y = 0; y < _levelData.size(); y++) {
-    for (int x = 0; x < _levelData[y].size(); x++) {
-      char tile = _levelData[y][x];
-      //get destination rect
-      glm::vec4 destRect(x * TILE_WIDTH, y * TILE_WIDTH, TILE_WIDTH, TILE_WIDTH);
-      switch (tile) {
+  // Rows can be ragged, anything past the end of one is solid
+  m_tiles.assign(m_width * m_height, static_cast<uint8_t>(TileType::UNKNOWN));
+  m_solidBits.assign(m_rowWords * m_height, ~0ull);
+
+  for (int y = 0; y < m_height; y++) {
+    for (int x = 0; x < static_cast<int>(rows[y].size()); x++) {
+      char symbol = rows[y][x];
+      TileType tile = TileType::UNKNOWN;
+      switch (symbol) {
       case '#':
-      {
-        auto texture = JAGEngine::ResourceManager::getTexture("Textures/zombie_game/spr_stone.png");
-        if (texture.id == 0) {
-          std::cout << "Failed to load texture: Textures/zombie_game/spr_stone.png" << std::endl;
-        }
-        else {
-          m_spriteBatch.draw(destRect, uvRect, texture.id, 0.0f, whiteColor);
-        }
-      }
-      break;
+        tile = TileType::STONE;
+        break;
       case 'B':
-      {
-        auto texture = JAGEngine::ResourceManager::getTexture("Textures/zombie_game/spr_brick.png");
-        if (texture.id == 0) {
-          std::cout << "Failed to load texture: Textures/zombie_game/spr_brick.png" << std::endl;
-        }
-        else {
-          m_spriteBatch.draw(destRect, uvRect, texture.id, 0.0f, whiteColor);
-        }
-      }
-      break;
+        tile = TileType::BRICK;
+        break;
       case 'W':
-      {
-        auto texture = JAGEngine::ResourceManager::getTexture("Textures/zombie_game/spr_wood.png");
-        if (texture.id == 0) {
-          std::cout << "Failed to load texture: Textures/zombie_game/spr_wood.png" << std::endl;
-        }
-        else {
-          m_spriteBatch.draw(destRect, uvRect, texture.id, 0.0f, whiteColor);
-        }
-      }
-      break;
+        tile = TileType::WOOD;
+        break;
       case 'Z':
-        _levelData[y][x] = '.';
+        tile = TileType::EMPTY;
         m_zombiestartPositions.emplace_back(x * TILE_WIDTH, y * TILE_WIDTH);
         break;
       case '@':
-        _levelData[y][x] = '.';
+        tile = TileType::EMPTY;
         _startPlayerPos.x = x * TILE_WIDTH;
         _startPlayerPos.y = y * TILE_WIDTH;
         break;
       case '.':
+        tile = TileType::EMPTY;
         break;
       default:
-        std::printf("Unexpected Symbol %c at (%d,%d)", tile, x, y);
+        std::printf("Unexpected Symbol %c at (%d,%d)", symbol, x, y);
         break;
       }
+
+      m_tiles[y * m_width + x] = static_cast<uint8_t>(tile);
+      if (tile == TileType::EMPTY) {
+        m_solidBits[y * m_rowWords + (x >> 6)] &= ~(1ull << (x & 63));
+      }
     }
   }
-  m_spriteBatch.end();
 
-  std::cout << "Level initialization complete. Zombies: " << m_zombiestartPositions.size()
+  std::cout << "Level data loaded. Width: " << m_width << ", Height: " << m_height
+    << ", Zombies: " << m_zombiestartPositions.size()
     << ", Player start: (" << _startPlayerPos.x << ", " << _startPlayerPos.y << ")" << std::endl;
 }
 
 Level::~Level() {
 }
 
-void Level::draw() {
-  m_spriteBatch.renderBatch();
+void Level::init() {
+  glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
+  JAGEngine::ColorRGBA8 whiteColor;
+  whiteColor.r = 255;
+  whiteColor.g = 255;
+  whiteColor.b = 255;
+  whiteColor.a = 255;
+
+  const char* TILE_TEXTURES[] = {
+    nullptr,
+    "Textures/zombie_game/spr_stone.png",
+    "Textures/zombie_game/spr_brick.png",
+    "Textures/zombie_game/spr_wood.png",
+    nullptr
+  };
+
+  GLuint textureIDs[sizeof(TILE_TEXTURES) / sizeof(TILE_TEXTURES[0])] = {};
+  for (int t = 0; t < sizeof(TILE_TEXTURES) / sizeof(TILE_TEXTURES[0]); t++) {
+    if (TILE_TEXTURES[t] == nullptr) {
+      continue;
+    }
+    textureIDs[t] = JAGEngine::ResourceManager::getTexture(TILE_TEXTURES[t]).id;
+    if (textureIDs[t] == 0) {
+      std::cout << "Failed to load texture: " << TILE_TEXTURES[t] << std::endl;
+    }
+  }
+
+  // Each chunk gets its own batch, uploaded once here and only drawn after that
+  m_numXChunks = (m_width + CHUNK_TILES - 1) / CHUNK_TILES;
+  m_numYChunks = (m_height + CHUNK_TILES - 1) / CHUNK_TILES;
+  m_chunks.clear();
+  m_chunks.resize(m_numXChunks * m_numYChunks);
+
+  for (int chunkY = 0; chunkY < m_numYChunks; chunkY++) {
+    for (int chunkX = 0; chunkX < m_numXChunks; chunkX++) {
+      std::unique_ptr<JAGEngine::SpriteBatch> chunk;
+
+      //render all the tiles in the chunk
+      const int endY = std::min((chunkY + 1) * CHUNK_TILES, m_height);
+      const int endX = std::min((chunkX + 1) * CHUNK_TILES, m_width);
+      for (int y = chunkY * CHUNK_TILES; y < endY; y++) {
+        for (int x = chunkX * CHUNK_TILES; x < endX; x++) {
+          GLuint textureID = textureIDs[m_tiles[y * m_width + x]];
+          if (textureID == 0) {
+            continue;
+          }
+          if (chunk == nullptr) {
+            chunk = std::make_unique<JAGEngine::SpriteBatch>();
+            chunk->init();
+            chunk->begin();
+          }
+          //get destination rect
+          glm::vec4 destRect(x * TILE_WIDTH, y * TILE_WIDTH, TILE_WIDTH, TILE_WIDTH);
+          chunk->draw(destRect, uvRect, textureID, 0.0f, whiteColor);
+        }
+      }
+
+      if (chunk != nullptr) {
+        chunk->end();
+        m_chunks[chunkY * m_numXChunks + chunkX] = std::move(chunk);
+      }
+    }
+  }
+
+  std::cout << "Level initialization complete." << std::endl;
 }
 
-int Level::getWidth() const {
-  if (_levelData.empty()) {
-    std::cerr << "Error: Level data is empty!" << std::endl;
-    return 0;
+void Level::draw(const JAGEngine::Camera2D& camera) {
+  // Work out the chunk range from the view rectangle instead of testing every chunk,
+  // so the cost depends on the screen size and not the level size
+  const float CHUNK_WIDTH = static_cast<float>(CHUNK_TILES * TILE_WIDTH);
+  const glm::vec2 halfView = camera.getViewDimensions() * 0.5f;
+  const glm::vec2 viewMin = camera.getPosition() - halfView;
+  const glm::vec2 viewMax = camera.getPosition() + halfView;
+
+  const int firstX = std::max(static_cast<int>(std::floor(viewMin.x / CHUNK_WIDTH)), 0);
+  const int firstY = std::max(static_cast<int>(std::floor(viewMin.y / CHUNK_WIDTH)), 0);
+  const int lastX = std::min(static_cast<int>(std::floor(viewMax.x / CHUNK_WIDTH)), m_numXChunks - 1);
+  const int lastY = std::min(static_cast<int>(std::floor(viewMax.y / CHUNK_WIDTH)), m_numYChunks - 1);
+
+  for (int y = firstY; y <= lastY; y++) {
+    for (int x = firstX; x <= lastX; x++) {
+      JAGEngine::SpriteBatch* chunk = m_chunks[y * m_numXChunks + x].get();
+      if (chunk != nullptr) {
+        chunk->renderBatch();
+      }
+    }
   }
-  return _levelData[0].size();
 }
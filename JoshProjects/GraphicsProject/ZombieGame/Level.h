@@ -3,35 +3,64 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <JAGEngine/SpriteBatch.h>
 
+namespace JAGEngine {
+  class Camera2D;
+}
+
 const int TILE_WIDTH = 64;
+const int CHUNK_TILES = 16; //chunks are CHUNK_TILES x CHUNK_TILES tiles
+
+enum class TileType : uint8_t { EMPTY, STONE, BRICK, WOOD, UNKNOWN };
 
 class Level
 {
 public:
+  /// Reads the level file into a byte per tile and a bit per solid tile. Doesn't touch
+  /// GL, so the next level can be loaded on another thread.
   Level(const std::string& fileName);
   ~Level();
 
-  void draw();
-
+  /// Builds a static batch of tile sprites per chunk, call on the main thread before
+  /// the first draw
+  void init();
+  /// Draws only the chunks inside the camera's view
+  void draw(const JAGEngine::Camera2D& camera);
 
   //getters
-  int getWidth() const;
-  int getHeight() const { return _levelData.size(); }
+  int getWidth() const { return m_width; }
+  int getHeight() const { return m_height; }
+
+  TileType getTile(int x, int y) const { return static_cast<TileType>(m_tiles[y * m_width + x]); }
+  /// Walls and anything off the level are solid
+  bool isSolid(int x, int y) const {
+    if (static_cast<unsigned>(x) >= static_cast<unsigned>(m_width) ||
+        static_cast<unsigned>(y) >= static_cast<unsigned>(m_height)) {
+      return true;
+    }
+    return (m_solidBits[y * m_rowWords + (x >> 6)] >> (x & 63)) & 1;
+  }
 
-  const std::vector<std::string>& getLevelData() const { return _levelData; }
   glm::vec2 getStartPlayerPos() const { return _startPlayerPos; }
   const std::vector<glm::vec2>& getZombieStartPositions() const { return m_zombiestartPositions; }
   int getNumHumans() const { return _numHumans; }
 
 private:
-  std::vector<std::string> _levelData;
   int _numHumans;
+  int m_width = 0;
+  int m_height = 0;
+  int m_rowWords = 0;                ///< 64 bit words per row of m_solidBits
+  std::vector<uint8_t> m_tiles;      ///< TileType of each tile, row by row
+  std::vector<uint64_t> m_solidBits; ///< Bit per tile, set for walls
+
+  int m_numXChunks = 0;
+  int m_numYChunks = 0;
+  std::vector<std::unique_ptr<JAGEngine::SpriteBatch>> m_chunks; ///< Row by row, null if the chunk has no walls
 
-  JAGEngine::SpriteBatch m_spriteBatch;
   glm::vec2 _startPlayerPos;
   std::vector<glm::vec2> m_zombiestartPositions;
 };
-
@@ -0,0 +1,117 @@
+//LineOfSight.cpp
+
+#include "LineOfSight.h"
+#include "Level.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+LineOfSight::LineOfSight() {
+}
+
+LineOfSight::~LineOfSight() {
+}
+
+void LineOfSight::init(const Level& level) {
+  m_level = &level;
+  m_width = level.getWidth();
+  m_height = level.getHeight();
+
+  m_cache.assign(CACHE_SIZE, CacheEntry());
+  m_tick = 1;
+}
+
+void LineOfSight::beginTick() {
+  m_tick++;
+  // Entries from the last time the counter was here would look current
+  if (m_tick == 0) {
+    m_cache.assign(CACHE_SIZE, CacheEntry());
+    m_tick = 1;
+  }
+}
+
+bool LineOfSight::hasLineOfSight(const glm::vec2& start, const glm::vec2& end) const {
+  // Amanatides and Woo: step into whichever of the next vertical or horizontal tile
+  // boundaries the ray reaches first, so every tile crossed is checked exactly once
+  const glm::vec2 from = start / static_cast<float>(TILE_WIDTH);
+  const glm::vec2 to = end / static_cast<float>(TILE_WIDTH);
+  int x = static_cast<int>(std::floor(from.x));
+  int y = static_cast<int>(std::floor(from.y));
+  const int endX = static_cast<int>(std::floor(to.x));
+  const int endY = static_cast<int>(std::floor(to.y));
+
+  if (m_level->isSolid(x, y) || m_level->isSolid(endX, endY)) {
+    return false;
+  }
+
+  const glm::vec2 dir = to - from;
+  const int stepX = dir.x > 0.0f ? 1 : -1;
+  const int stepY = dir.y > 0.0f ? 1 : -1;
+  // Ray lengths, as fractions of the whole ray, to cross one tile along each axis
+  // and to reach the first boundary on each axis
+  const float deltaX = dir.x != 0.0f ? std::abs(1.0f / dir.x) : INFINITY;
+  const float deltaY = dir.y != 0.0f ? std::abs(1.0f / dir.y) : INFINITY;
+  float maxX = dir.x != 0.0f ? (stepX > 0 ? x + 1 - from.x : from.x - x) * deltaX : INFINITY;
+  float maxY = dir.y != 0.0f ? (stepY > 0 ? y + 1 - from.y : from.y - y) * deltaY : INFINITY;
+
+  // The ray crosses exactly this many boundaries, counting them instead of comparing
+  // against the end keeps float error from walking past it
+  int numSteps = std::abs(endX - x) + std::abs(endY - y);
+  for (int i = 0; i < numSteps; i++) {
+    if ((maxX < maxY && x != endX) || y == endY) {
+      x += stepX;
+      maxX += deltaX;
+    }
+    else {
+      y += stepY;
+      maxY += deltaY;
+    }
+    if (m_level->isSolid(x, y)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LineOfSight::canSee(const glm::vec2& from, const glm::vec2& to) {
+  const int fromTile = getTileIndex(from);
+  const int toTile = getTileIndex(to);
+  if (fromTile == -1 || toTile == -1) {
+    return false;
+  }
+
+  const uint64_t key = static_cast<uint64_t>(fromTile) * (m_width * m_height) + toTile;
+  // Fibonacci hashing spreads neighbouring tiles over the whole table, the top 14
+  // bits index all CACHE_SIZE entries
+  const uint32_t hash = static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 50);
+  for (int probe = 0; probe < MAX_PROBES; probe++) {
+    CacheEntry& entry = m_cache[(hash + probe) & (CACHE_SIZE - 1)];
+    if (entry.tick == m_tick && entry.key == key) {
+      return entry.isVisible;
+    }
+    if (entry.tick != m_tick) {
+      entry.key = key;
+      entry.tick = m_tick;
+      entry.isVisible = hasLineOfSight(getTileCenter(fromTile), getTileCenter(toTile));
+      return entry.isVisible;
+    }
+  }
+
+  // Too crowded this step, trace it without caching
+  return hasLineOfSight(getTileCenter(fromTile), getTileCenter(toTile));
+}
+
+glm::vec2 LineOfSight::getTileCenter(int tile) const {
+  return glm::vec2((tile % m_width) * TILE_WIDTH + TILE_WIDTH / 2.0f,
+    (tile / m_width) * TILE_WIDTH + TILE_WIDTH / 2.0f);
+}
+
+int LineOfSight::getTileIndex(const glm::vec2& pos) const {
+  int x = static_cast<int>(std::floor(pos.x / TILE_WIDTH));
+  int y = static_cast<int>(std::floor(pos.y / TILE_WIDTH));
+  if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+    return -1;
+  }
+  return y * m_width + x;
+}
@@ -0,0 +1,54 @@
+//LineOfSight.h
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Level;
+
+// Answers whether walls block the straight line between two points. Rays walk the
+// tiles they cross one at a time against the level's solid tile bits.
+class LineOfSight
+{
+public:
+  LineOfSight();
+  ~LineOfSight();
+
+  /// Traces against this level until init is called again, so it has to outlive
+  /// any queries
+  void init(const Level& level);
+
+  /// Forgets the cached results, call once per step after agents have moved
+  void beginTick();
+
+  /// Exact test between two points. Off the level counts as blocked.
+  bool hasLineOfSight(const glm::vec2& start, const glm::vec2& end) const;
+
+  /// Tests between the centres of the tiles under the two points and caches the result
+  /// for the rest of the step, so a horde checking the same few targets only traces
+  /// each pair of tiles once
+  bool canSee(const glm::vec2& from, const glm::vec2& to);
+
+private:
+  /// Entries live until the tick moves on, so the table never has to be cleared
+  struct CacheEntry {
+    uint64_t key = 0;
+    uint32_t tick = 0;
+    bool isVisible = false;
+  };
+  static const int CACHE_SIZE = 16384; ///< Power of two, has to match the hash in canSee
+  static const int MAX_PROBES = 8;
+
+  /// Tile under pos, -1 if off the level
+  int getTileIndex(const glm::vec2& pos) const;
+  glm::vec2 getTileCenter(int tile) const;
+
+  const Level* m_level = nullptr;
+  int m_width = 0;
+  int m_height = 0;
+
+  uint32_t m_tick = 1;
+  std::vector<CacheEntry> m_cache;
+};
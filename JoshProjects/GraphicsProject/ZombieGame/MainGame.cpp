@@ -13,6 +13,7 @@
 #include <random>
 #include <ctime>
 #include <algorithm>
+#include <functional>
 #include "JAGEngine/Vertex.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
@@ -25,6 +26,25 @@ const float PLAYER_SPEED = 3.6f;
 
 const float m_turnTime = 60.0f;
 
+namespace {
+  // Deletes the agents at these indices. Removes from the back first, so the agents
+  // swapped into the gaps were never on the list.
+  template<class T>
+  void removeAgents(std::vector<T*>& agents, std::vector<int>& indices) {
+    std::sort(indices.begin(), indices.end(), std::greater<int>());
+    for (int i : indices) {
+      delete agents[i];
+      agents[i] = agents.back();
+      agents.pop_back();
+    }
+    indices.clear();
+  }
+
+  std::string getLevelFileName(int level) {
+    return "Levels/Level" + std::to_string(level + 1) + ".txt";
+  }
+}
+
 MainGame::MainGame() :
   m_screenWidth(1024),
   m_screenHeight(768),
@@ -32,6 +52,7 @@ MainGame::MainGame() :
   m_gameState(GameState::PLAY),
   m_maxFPS(60.0f),
   m_player(nullptr),
+  m_currentLevel(0),
   m_numHumansKilled(0),
   m_numZombiesKilled(0)
 {
@@ -46,9 +67,7 @@ MainGame::MainGame() :
 }
 
 MainGame::~MainGame() {
-  for (int i = 0; i < m_levels.size(); i++) {
-    delete m_levels[i];
-  }
+  m_level.reset();
   if (m_spriteFont) {
     m_spriteFont->dispose();
     delete m_spriteFont;
@@ -175,68 +194,74 @@ void MainGame::gameLoop() {
 }
 
 void MainGame::updateAgents(float deltaTime) {
-  if (m_levels.empty() || m_levels[m_currentLevel] == nullptr) {
+  if (m_level == nullptr) {
     std::cerr << "Error: No valid level data available." << std::endl;
     m_gameState = GameState::EXIT;
     return;
   }
 
-  const std::vector<std::string>& levelData = m_levels[m_currentLevel]->getLevelData();
+  updateFlowFields();
+  m_lineOfSight.beginTick();
 
   // Update all humans
   for (int i = 0; i < m_humans.size(); i++) {
-    m_humans[i]->update(levelData, m_humans, m_zombies, deltaTime);
+    m_humans[i]->update(*m_level, m_humans, m_zombies, m_humanField, m_zombieField, m_lineOfSight, deltaTime);
   }
 
   // Update all zombies
   for (int i = 0; i < m_zombies.size(); i++) {
-    m_zombies[i]->update(levelData, m_humans, m_zombies, deltaTime);
+    m_zombies[i]->update(*m_level, m_humans, m_zombies, m_humanField, m_zombieField, m_lineOfSight, deltaTime);
   }
 
-  //zombie collision
-  for (int i = 0; i < m_zombies.size(); i++) {
-    //collide with zombies
-    for (int j = i + 1; j < m_zombies.size(); j++) {
-      m_zombies[i]->collideWithAgent(m_zombies[j]);
-    }
-    // Collide with humans
-    for (int j = 1; j < m_humans.size(); j++) {
-      if (m_zombies[i]->collideWithAgent(m_humans[j])) {
-        //add blood
-        addBlood((m_humans[j]->getPosition()+m_zombies[i]->getPosition())/2.0f, 1);
-        m_humans[j]->incrementZombify(1.0f * deltaTime);
-        if (m_humans[j]->getZombify() >= m_turnTime) {
-          // Add the new zombie
-          m_zombies.push_back(new Zombie);
-          m_zombies.back()->init(ZOMBIE_SPEED, m_humans[j]->getPosition());
-          // Delete the human
-          delete m_humans[j];
-          m_humans[j] = m_humans.back();
-          m_humans.pop_back();
-        }
-      }
+  //agent collision, only between agents in neighbouring tiles
+  m_agentGrid.build(m_humans, m_zombies);
+  m_agentGrid.collidePairs(m_agentPairs, [&](AgentGrid::Entry& a, AgentGrid::Entry& b) {
+    if (a.isZombie == b.isZombie) {
+      return;
     }
 
-    //collide with the player
-    if (m_zombies[i]->collideWithAgent(m_player)) {
+    //zombie bit a human
+    AgentGrid::Entry& human = a.isZombie ? b : a;
+    if (human.agent == m_player) {
       JAGEngine::fatalError("YOU LOSE");
     }
+    Human* bitten = m_humans[human.index];
+    addBlood((a.agent->getPosition() + b.agent->getPosition()) / 2.0f, 1);
+    bitten->incrementZombify(1.0f * deltaTime);
+    if (bitten->getZombify() >= m_turnTime) {
+      // Turn them once the pass is done, the grid still points at them
+      human.isAlive = false;
+      m_deadHumans.push_back(human.index);
+    }
+  });
+
+  for (int i : m_deadHumans) {
+    m_zombies.push_back(new Zombie);
+    m_zombies.back()->init(ZOMBIE_SPEED, m_humans[i]->getPosition());
   }
+  removeAgents(m_humans, m_deadHumans);
+}
 
-  //human collision
+void MainGame::updateFlowFields() {
+  // One search from every human at once replaces each zombie scanning every human,
+  // and paths go around walls instead of into them
+  m_agentPositions.clear();
   for (int i = 0; i < m_humans.size(); i++) {
-    for (int j = i + 1; j < m_humans.size(); j++) {
-      m_humans[i]->collideWithAgent(m_humans[j]);
-    }
+    m_agentPositions.push_back(m_humans[i]->getPosition());
   }
+  m_humanField.build(m_agentPositions);
 
-  //dont forget to update zombies
+  m_agentPositions.clear();
+  for (int i = 0; i < m_zombies.size(); i++) {
+    m_agentPositions.push_back(m_zombies[i]->getPosition());
+  }
+  m_zombieField.build(m_agentPositions);
 }
 
 void MainGame::updateBullets(float deltaTime) {
   //collide with world
   for (int i = 0; i < m_bullets.size();) {
-    if (m_bullets[i].update(m_levels[m_currentLevel]->getLevelData(), deltaTime)) {
+    if (m_bullets[i].update(*m_level, deltaTime)) {
       m_bullets[i] = m_bullets.back();
       m_bullets.pop_back();
     }
@@ -245,69 +270,38 @@ void MainGame::updateBullets(float deltaTime) {
     }
   }
 
-  bool wasBulletRemoved;
+  //collide with humans and zombies, only those in the tiles around each bullet
+  m_agentGrid.build(m_humans, m_zombies);
+  for (int i = 0; i < m_bullets.size();) {
+    AgentGrid::Entry* hit = m_agentGrid.findBulletHit(m_bullets[i], m_player, m_nearbyAgents);
+    if (hit == nullptr) {
+      i++;
+      continue;
+    }
 
-  //collide with humans and zombies
-  for (int i = 0; i < m_bullets.size(); i++) {
-    wasBulletRemoved = false;
-    //loop zombies
-    for (int j = 0; j < m_zombies.size();) {
-      //check collision
-      if (m_bullets[i].collideWithAgent(m_zombies[j])) {
-        //add blood
-        addBlood(m_bullets[i].getPosition(), 5);
-
-        //damage zombie and kill if out of health
-        if (m_zombies[j]->applyDamage(m_bullets[i].getDamage())) {
-          // if zombie dies remove him
-          delete m_zombies[j];
-          m_zombies[j] = m_zombies.back();
-          m_zombies.pop_back();
-          m_numZombiesKilled++;
-        }  else {
-          j++;
-        }
-
-        //remove the bullet
-        m_bullets[i] = m_bullets.back();
-        m_bullets.pop_back();
-        wasBulletRemoved = true;
-        break;
-      } else {
-        j++;
+    //add blood
+    addBlood(m_bullets[i].getPosition(), 5);
+
+    //damage the agent and kill if out of health
+    if (hit->agent->applyDamage(m_bullets[i].getDamage())) {
+      hit->isAlive = false;
+      if (hit->isZombie) {
+        m_deadZombies.push_back(hit->index);
+        m_numZombiesKilled++;
       }
-    }
-    //loop humans
-    if (wasBulletRemoved == false) {
-      for (int j = 1; j < m_humans.size();) {
-        //check collision
-        if (m_bullets[i].collideWithAgent(m_humans[j])) {
-          addBlood(m_bullets[i].getPosition(), 5);
-
-          //damage zombie and kill if out of health
-          if (m_humans[j]->applyDamage(m_bullets[i].getDamage())) {
-            // if zombie dies remove him
-            delete m_humans[j];
-            m_humans[j] = m_humans.back();
-            m_humans.pop_back();
-            m_numHumansKilled++;
-          }
-          else {
-            j++;
-          }
-
-          //remove the bullet
-          m_bullets[i] = m_bullets.back();
-          m_bullets.pop_back();
-          wasBulletRemoved = true;
-          break;
-        }
-        else {
-          j++;
-        }
+      else {
+        m_deadHumans.push_back(hit->index);
+        m_numHumansKilled++;
       }
     }
+
+    //remove the bullet
+    m_bullets[i] = m_bullets.back();
+    m_bullets.pop_back();
   }
+
+  removeAgents(m_zombies, m_deadZombies);
+  removeAgents(m_humans, m_deadHumans);
 }
 
 void MainGame::initShaders() {
@@ -421,10 +415,12 @@ void MainGame::processInput() {
 void MainGame::checkVictory() {
   if (m_zombies.empty()) {
     std::cout << "All zombies eliminated. Checking for next level..." << std::endl;
-    if (doesNextLevelExist()) {
+    // The next level has been loading since this one started, so it's usually ready
+    std::unique_ptr<Level> nextLevel = m_nextLevel.valid() ? m_nextLevel.get() : nullptr;
+    if (nextLevel != nullptr) {
       std::cout << "Next level exists. Proceeding to load..." << std::endl;
       try {
-        loadNextLevel();
+        loadNextLevel(std::move(nextLevel));
         std::cout << "Next level loaded successfully." << std::endl;
       }
       catch (const std::exception& e) {
@@ -435,13 +431,13 @@ void MainGame::checkVictory() {
     else {
       std::cout << "No more levels. Game completed." << std::endl;
       std::printf("*** You Win! ***\n You killed %d humans and %d zombies. There are %d/%d civilians remaining",
-        m_numHumansKilled, m_numZombiesKilled, m_humans.size() - 1, m_levels[m_currentLevel]->getNumHumans());
+        m_numHumansKilled, m_numZombiesKilled, m_humans.size() - 1, m_level->getNumHumans());
       m_gameState = GameState::EXIT;
     }
   }
 }
 
-void MainGame::loadNextLevel() {
+void MainGame::loadNextLevel(std::unique_ptr<Level> level) {
   m_currentLevel++;
   std::cout << "Loading level " << m_currentLevel + 1 << std::endl;
 
@@ -463,11 +459,8 @@ void MainGame::loadNextLevel() {
   // Clear bullets
   m_bullets.clear();
 
-  // Clear levels
-  for (auto& level : m_levels) {
-    delete level;
-  }
-  m_levels.clear();
+  // Swap in the preloaded level
+  m_level = std::move(level);
 
   // Reset player position
   if (m_player) {
@@ -487,10 +480,19 @@ void MainGame::loadNextLevel() {
   std::cout << "Next level loaded successfully." << std::endl;
 }
 
-bool MainGame::doesNextLevelExist() {
-  std::string nextLevelFileName = "Levels/Level" + std::to_string(m_currentLevel + 2) + ".txt";
-  std::ifstream file(nextLevelFileName);
-  return file.good();
+void MainGame::preloadNextLevel() {
+  // Levels only touch GL in init(), so parsing can happen while this one is played. A
+  // level that fails to load just means this is the last one.
+  std::string fileName = getLevelFileName(m_currentLevel + 1);
+  m_nextLevel = std::async(std::launch::async, [fileName]() -> std::unique_ptr<Level> {
+    try {
+      return std::make_unique<Level>(fileName);
+    }
+    catch (const std::exception& e) {
+      std::cout << "No next level: " << e.what() << std::endl;
+      return nullptr;
+    }
+  });
 }
 
 void MainGame::drawGame() {
@@ -515,7 +517,7 @@ void MainGame::drawGame() {
   glUniformMatrix4fv(pUniform, 1, GL_FALSE, &(projectionMatrix[0][0]));
 
   //draw the level
-  m_levels[m_currentLevel]->draw();
+  m_level->draw(m_camera);
 
   //begin drawing agents
   m_agentSpriteBatch.begin();
@@ -605,22 +607,44 @@ void MainGame::initLevel() {
 
   m_zombies.clear();
   m_bullets.clear();
-  std::string levelFileName = "Levels/Level" + std::to_string(m_currentLevel + 1) + ".txt";
-  std::cout << "Loading level: " << levelFileName << std::endl;
+  std::cout << "Loading level: " << getLevelFileName(m_currentLevel) << std::endl;
+
+  // Decode the gun sounds on the loader thread while the level is built. Gunfire is
+  // capped per gun so a held trigger can't take every channel from everything else.
+  std::vector<JAGEngine::SoundEffectDesc> gunSounds(3);
+  gunSounds[0].filePath = "Sound/shots/pistol1.ogg";
+  gunSounds[0].priority = 1;
+  gunSounds[0].maxInstances = 3;
+  gunSounds[1].filePath = "Sound/shots/shotgun1.ogg";
+  gunSounds[1].priority = 2;
+  gunSounds[1].maxInstances = 2;
+  gunSounds[2].filePath = "Sound/shots/m5.ogg";
+  gunSounds[2].priority = 1;
+  gunSounds[2].maxInstances = 4;
+  std::vector<JAGEngine::SoundEffect> gunEffects = m_audioEngine.loadSoundBank(gunSounds);
 
   try {
-    m_levels.push_back(new Level(levelFileName));
+    // Only the first level isn't preloaded
+    if (m_level == nullptr) {
+      m_level = std::make_unique<Level>(getLevelFileName(m_currentLevel));
+    }
+    m_level->init();
     std::cout << "Level object created." << std::endl;
 
-    int width = m_levels[0]->getWidth();
-    int height = m_levels[0]->getHeight();
+    int width = m_level->getWidth();
+    int height = m_level->getHeight();
     std::cout << "Level loaded. Width: " << width << ", Height: " << height << std::endl;
 
+    m_humanField.init(*m_level);
+    m_zombieField.init(*m_level);
+    m_agentGrid.init(width, height);
+    m_lineOfSight.init(*m_level);
+
     // Initialize player
     if (m_player == nullptr) {
       m_player = new Player();
     }
-    m_player->init(PLAYER_SPEED, m_levels[0]->getStartPlayerPos(), &m_inputManager, &m_camera, &m_bullets);
+    m_player->init(PLAYER_SPEED, m_level->getStartPlayerPos(), &m_inputManager, &m_camera, &m_bullets);
     std::cout << "Player initialized at position: " << m_player->getPosition().x << ", " << m_player->getPosition().y << std::endl;
 
     // Ensure player is in m_humans vector
@@ -636,7 +660,7 @@ void MainGame::initLevel() {
     std::uniform_int_distribution<int> randX(2, width - 2);
     std::uniform_int_distribution<int> randY(2, height - 2);
 
-    for (int i = 0; i < m_levels[0]->getNumHumans(); i++) {
+    for (int i = 0; i < m_level->getNumHumans(); i++) {
       m_humans.push_back(new Human);
       glm::vec2 pos(randX(randomEngine) * TILE_WIDTH, randY(randomEngine) * TILE_WIDTH);
       m_humans.back()->init(HUMAN_SPEED, pos);
@@ -644,7 +668,7 @@ void MainGame::initLevel() {
     std::cout << "Humans initialized. Total humans: " << m_humans.size() << std::endl;
 
     // Initialize zombies
-    const std::vector<glm::vec2>& zombiePositions = m_levels[0]->getZombieStartPositions();
+    const std::vector<glm::vec2>& zombiePositions = m_level->getZombieStartPositions();
     for (const auto& pos : zombiePositions) {
       m_zombies.push_back(new Zombie);
       m_zombies.back()->init(ZOMBIE_SPEED, pos);
@@ -652,14 +676,16 @@ void MainGame::initLevel() {
     std::cout << "Zombies initialized. Total zombies: " << m_zombies.size() << std::endl;
 
     // Set up player's guns
-    m_player->addGun(new Gun("Pistol", 20, 1, 0.15f, 40, 20.0f,
-                              m_audioEngine.loadSoundEffect("Sound/shots/pistol1.ogg")));
-    m_player->addGun(new Gun("Shotgun", 90, 20, 50.0f, 25, 25.0f,
-                              m_audioEngine.loadSoundEffect("Sound/shots/shotgun1.ogg")));
-    m_player->addGun(new Gun("MP5", 3, 1, 0.5f, 25, 30.0f,
-                              m_audioEngine.loadSoundEffect("Sound/shots/m5.ogg")));
+    m_player->addGun(new Gun("Pistol", 20, 1, 0.15f, 40, 20.0f, gunEffects[0]));
+    m_player->addGun(new Gun("Shotgun", 90, 20, 50.0f, 25, 25.0f, gunEffects[1]));
+    m_player->addGun(new Gun("MP5", 3, 1, 0.5f, 25, 30.0f, gunEffects[2]));
     std::cout << "Player's guns set up." << std::endl;
 
+    // Usually done by now; make sure the first shot doesn't go missing
+    m_audioEngine.waitForSoundBanks();
+
+    preloadNextLevel();
+
     std::cout << "Level initialization complete." << std::endl;
   }
   catch (const std::exception& e) {
@@ -25,8 +25,13 @@
 #include "Player.h"
 #include "Level.h"
 #include "Bullet.h"
+#include "FlowField.h"
+#include "AgentGrid.h"
+#include "LineOfSight.h"
 #include <vector>
 #include <cmath>
+#include <future>
+#include <memory>
 
 class Zombie;
 
@@ -48,11 +53,14 @@ private:
   void gameLoop();
 
   void updateAgents(float deltaTime);
+  /// Rebuilds the fields agents steer by from where everyone is this step
+  void updateFlowFields();
   void updateBullets(float deltaTime);
 
   void checkVictory();
-  void loadNextLevel();
-  bool doesNextLevelExist();
+  void loadNextLevel(std::unique_ptr<Level> level);
+  /// Starts loading the level after the current one on another thread
+  void preloadNextLevel();
 
   void processInput();
   void drawGame();
@@ -82,13 +90,25 @@ private:
   JAGEngine::InputManager m_inputManager;
   JAGEngine::FpsLimiter m_fpsLimiter;
 
-  std::vector<Level*> m_levels;
+  std::unique_ptr<Level> m_level;
+  std::future<std::unique_ptr<Level>> m_nextLevel; //null once loaded if there are no more levels
 
   Player* m_player;
   std::vector<Human*> m_humans;
   std::vector<Zombie*> m_zombies;
   std::vector<Bullet> m_bullets;
 
+  FlowField m_humanField;  //zombies chase down this one
+  FlowField m_zombieField; //humans flee up this one
+  LineOfSight m_lineOfSight;
+  std::vector<glm::vec2> m_agentPositions;
+
+  AgentGrid m_agentGrid;
+  std::vector<AgentGrid::Pair> m_agentPairs;
+  std::vector<int> m_nearbyAgents;
+  std::vector<int> m_deadHumans;  //killed or turned this step, removed once the grid is done
+  std::vector<int> m_deadZombies;
+
   JAGEngine::ResourceManager m_resourceManager;
   JAGEngine::SpriteFont* m_spriteFont;
 
@@ -33,9 +33,12 @@ void Player::addGun(Gun* gun) {
   }
 }
 
-void Player::update(const std::vector<std::string>& levelData,
+void Player::update(const Level& level,
   std::vector<Human*>& humans,
   std::vector<Zombie*>& zombies,
+  const FlowField& humanField,
+  const FlowField& zombieField,
+  LineOfSight& lineOfSight,
   float deltaTime) {
 
   float shift = 1.0f;
@@ -86,5 +89,5 @@ void Player::update(const std::vector<std::string>& levelData,
       deltaTime);
   }
 
-  collideWithLevel(levelData);
+  collideWithLevel(level);
 }
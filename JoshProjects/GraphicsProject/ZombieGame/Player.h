@@ -15,9 +15,12 @@ public:
   ~Player();
   void init(float speed, glm::vec2 pos, JAGEngine::InputManager* inputManager, JAGEngine::Camera2D* camera, std::vector<Bullet>* bullets);
   void addGun(Gun* gun);
-  void update(const std::vector<std::string>& levelData,
+  void update(const Level& level,
     std::vector<Human*>& humans,
     std::vector<Zombie*>& zombies,
+    const FlowField& humanField,
+    const FlowField& zombieField,
+    LineOfSight& lineOfSight,
     float deltaTime) override;
 
 private:
@@ -2,6 +2,8 @@
 
 #include "Zombie.h"
 #include "Human.h"
+#include "FlowField.h"
+#include "LineOfSight.h"
 #include <random>
 #include <ctime>
 #include <SDL/SDL.h>
@@ -13,8 +15,6 @@
 
 #include <glm/gtx/rotate_vector.hpp>
 
-const float TILE_WIDTH = 64.0f;
-
 Zombie::Zombie() :
   _frames(0),
   //m_direction(1.0f, 0.0f),
@@ -32,24 +32,30 @@ void Zombie::init(float speed, glm::vec2 pos) {
   m_textureID = JAGEngine::ResourceManager::getTexture("Textures/zombie_game/spr_npc.png").id;
 }
 
-void Zombie::update(const std::vector<std::string>& levelData,
+void Zombie::update(const Level& level,
   std::vector<Human*>& humans,
   std::vector<Zombie*>& zombies,
+  const FlowField& humanField,
+  const FlowField& zombieField,
+  LineOfSight& lineOfSight,
   float deltaTime) {
   const int UPDATE_CAP = 120;
-  float closestDistance = 99999.0f;
   static std::mt19937 randomEngine(time(nullptr));
   static std::uniform_real_distribution<float> randRotate(-45.0f, 45.0f);
-  Human* closestHuman = getNearestHuman(humans);
 
-  // Calculate the distance to the closest human if one exists
-  if (closestHuman != nullptr) {
-    glm::vec2 humanPosition = closestHuman->getPosition();
-    closestDistance = glm::distance(humanPosition, _position);
+  // The human field already knows the walking distance to the nearest human and
+  // which way to go around the walls to get there, but only chase them if they can
+  // be seen
+  glm::vec2 chaseDirection(0.0f);
+  if (humanField.getDistance(_position) < CHASE_DISTANCE) {
+    int target = humanField.getNearestSource(_position);
+    if (target != -1 && lineOfSight.canSee(_position, humans[target]->getPosition())) {
+      chaseDirection = humanField.getDirection(_position);
+    }
   }
 
-  if (closestHuman != nullptr && closestDistance < CHASE_DISTANCE) {
-    m_direction = glm::normalize(closestHuman->getPosition() - _position);
+  if (chaseDirection != glm::vec2(0.0f)) {
+    m_direction = chaseDirection;
     _position += m_direction * _speed * deltaTime;
   }
   else {
@@ -70,63 +76,5 @@ void Zombie::update(const std::vector<std::string>& levelData,
     }
   }
 
-  collideWithLevel(levelData);
-}
-
-Human* Zombie::getNearestHuman(std::vector<Human*>& humans) {
-  Human* closestHuman = nullptr;
-  float smallestDistance = 9999999;
-  for (int i = 0; i < humans.size(); i++) {
-    glm::vec2 distVec = humans[i]->getPosition() - _position;
-    float distance = glm::length(distVec);
-    if (distance < smallestDistance) {
-      smallestDistance = distance;
-      closestHuman = humans[i];
-    }
-  }
-  return closestHuman;
-}
-
-//Human* Zombie::getNearestHuman(std::vector<Human*>& humans, const std::vector<std::string>& levelData) {
-//  Human* closestHuman = nullptr;
-//  float smallestDistance = 9999999.0f;
-//
-//  for (int i = 0; i < humans.size(); i++) {
-//    glm::vec2 distVec = humans[i]->getPosition() - _position;
-//    float distance = glm::length(distVec);
-//
-//    if (distance < smallestDistance) {
-//      // Check if there's a clear line of sight
-//      if (hasLineOfSight(_position, humans[i]->getPosition(), levelData)) {
-//        smallestDistance = distance;
-//        closestHuman = humans[i];
-//      }
-//    }
-//  }
-//
-//  return closestHuman;
-//}
-
-bool Zombie::hasLineOfSight(const glm::vec2& start, const glm::vec2& end, const std::vector<std::string>& levelData) {
-  glm::vec2 dir = end - start;
-  float distance = glm::length(dir);
-  dir = glm::normalize(dir);
-
-  for (float i = 0; i < distance; i += 1.0f) {  // Check every 1 unit
-    glm::vec2 checkPos = start + dir * i;
-    int tileX = static_cast<int>(checkPos.x / TILE_WIDTH);
-    int tileY = static_cast<int>(checkPos.y / TILE_WIDTH);
-
-    // Check if we're out of bounds
-    if (tileX < 0 || tileX >= levelData[0].size() || tileY < 0 || tileY >= levelData.size()) {
-      return false;
-    }
-
-    // Check if there's a wall at this position
-    if (levelData[tileY][tileX] != '.') {
-      return false;
-    }
-  }
-
-  return true;
+  collideWithLevel(level);
 }
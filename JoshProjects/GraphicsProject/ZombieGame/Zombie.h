@@ -14,14 +14,15 @@ public:
 
   void init(float speed, glm::vec2 pos);
 
-  virtual void update(const std::vector<std::string>& levelData,
+  virtual void update(const Level& level,
     std::vector<Human*>& humans,
     std::vector<Zombie*>& zombies,
+    const FlowField& humanField,
+    const FlowField& zombieField,
+    LineOfSight& lineOfSight,
     float deltaTime) override;
 
 private:
-  Human* getNearestHuman(std::vector<Human*>& humans);
-  bool hasLineOfSight(const glm::vec2& start, const glm::vec2& end, const std::vector<std::string>& levelData);
   int _frames;                         
   int _nextUpdateFrame;
 };
@@ -1,9 +1,16 @@
 //Main.cpp
 
 #include <iostream>
+#include <cstring>
 #include "MainGame.h"
+#include "Benchmark.h"
 
 int main(int argc, char* argv[]) {
+  // "--benchmark" times the agent collision passes headless instead of starting the game
+  if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0) {
+    return runBenchmark(argc - 2, argv + 2);
+  }
+
   MainGame mainGame;
   mainGame.run();
 
@@ -9,19 +9,19 @@ Box::~Box() {
 
 }
 b2Vec2 Box::getPosition() {
-    b2Vec2 position = b2Body_GetPosition(m_ID);
-    std::cout << "X: " << position.x << "  Y: " << position.y << std::endl;
-    return position;
+    return b2Body_GetPosition(m_ID);
 }
 
-void Box::init(b2WorldId* world, const glm::vec2& position, const glm::vec2& dimensions, Bengine::GLTexture texture, Bengine::ColorRGBA8 color, bool fixedRotation) {
+void Box::init(b2WorldId* world, const glm::vec2& position, const glm::vec2& dimensions, Bengine::GLTexture texture, Bengine::ColorRGBA8 color, bool fixedRotation, bool isAwake, float angle) {
     m_dimensions = dimensions;
     m_color = color;
     m_texture = texture;
     b2BodyDef bodyDef = b2DefaultBodyDef();
     bodyDef.type = b2_dynamicBody;
     bodyDef.position = b2Vec2(position.x, position.y);
+    bodyDef.rotation = b2MakeRot(angle);
     bodyDef.fixedRotation = fixedRotation;
+    bodyDef.isAwake = isAwake;
     m_ID = b2CreateBody(*world, &bodyDef);
 
     b2Polygon dynamicBox = b2MakeBox(dimensions.x / 2.0f, dimensions.y / 2.0f);
@@ -32,6 +32,11 @@ void Box::init(b2WorldId* world, const glm::vec2& position, const glm::vec2& dim
     b2CreatePolygonShape(m_ID, &shapeDef, &dynamicBox);
 }
 
+void Box::destroy() {
+    b2DestroyBody(m_ID);
+    m_ID = b2_nullBodyId;
+}
+
 void Box::draw(Bengine::SpriteBatch& spriteBatch) {
     glm::vec4 destRect;
     destRect.x = (getPosition().x - ((0.5) * getDimensions().x));
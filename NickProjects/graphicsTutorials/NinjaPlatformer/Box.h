@@ -10,7 +10,10 @@ public:
     Box();
     ~Box();
 
-    void init(b2WorldId* world, const glm::vec2& position, const glm::vec2& dimensions, Bengine::GLTexture texture, Bengine::ColorRGBA8 color, bool fixedRotation);
+    void init(b2WorldId* world, const glm::vec2& position, const glm::vec2& dimensions, Bengine::GLTexture texture, Bengine::ColorRGBA8 color, bool fixedRotation, bool isAwake = true, float angle = 0.0f);
+
+    // Removes the body from the world, the box can be init again afterwards
+    void destroy();
 
     void draw(Bengine::SpriteBatch& spriteBatch);
 
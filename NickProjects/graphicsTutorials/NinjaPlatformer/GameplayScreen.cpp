@@ -33,21 +33,6 @@ void GameplayScreen::onEntry() {
     m_world = b2CreateWorld(&worldDef);
 
 
-    b2BodyDef groundBodyDef = b2DefaultBodyDef();
-    groundBodyDef.position = b2Vec2(0.0f, -60.0f);
-    m_ground = b2CreateBody(m_world, &groundBodyDef);
-
-    b2Polygon const groundBox = b2MakeBox(50.0f, 10.0f);
-    b2ShapeDef groundShapeDef = b2DefaultShapeDef();
-    groundShapeDef.density = 1.0f;
-    groundShapeDef.friction = 0.2f;
-    // Enable contact events for the ground shape
-    groundShapeDef.enableContactEvents = true;
-    b2ShapeId groundShapeId = b2CreatePolygonShape(m_ground, &groundShapeDef, &groundBox);
-
-    // Pass the ground shape ID to the player
-    m_player.setGroundShapeId(groundShapeId);
-
     // Load the texture
     m_texture = Bengine::ResourceManager::getTexture("Textures/dirtBlock.png");
 
@@ -57,10 +42,9 @@ void GameplayScreen::onEntry() {
     textureColor.b = 255;
     textureColor.a = 255;
 
-    // Make a box
-    Box newBox;
-    newBox.init(&m_world, glm::vec2(0.0f, 14.0f), glm::vec2(3.0f, 3.0f), m_texture, textureColor, false);
-    m_boxes.push_back(newBox);
+    // Load the level, this only makes bodies for the sections around the player start
+    m_level.load("Levels/level1.txt");
+    m_level.init(&m_world, m_texture, textureColor);
 
     // Initialize spritebatch
     m_debugDraw.init();
@@ -78,8 +62,9 @@ void GameplayScreen::onEntry() {
     m_camera.init(m_window->getScreenWidth(), m_window->getScreenHeight());
     m_camera.setScale(8.0f);
 
-    // Init player
-    m_player.init(&m_world, glm::vec2(0.0f, 30.0f), glm::vec2(3.5f, 8.0f), textureColor);
+    // Init player, standing on the start tile
+    const glm::vec2 playerDims(3.5f, 8.0f);
+    m_player.init(&m_world, m_level.getStartPlayerPos() + glm::vec2(0.0f, playerDims.y / 2.0f), playerDims, textureColor);
 }
 
 void GameplayScreen::onExit() {
@@ -90,6 +75,15 @@ void GameplayScreen::update() {
     m_camera.update();
     checkInput();
 
+    // Stream level sections in and out around the player before stepping
+    b2Vec2 playerPos = b2Body_GetPosition(m_player.getID());
+    m_level.update(glm::vec2(playerPos.x, playerPos.y));
+    if (m_level.getNumLoadedSections() != m_numLoadedSections) {
+        m_numLoadedSections = m_level.getNumLoadedSections();
+        std::cout << "Level streaming: " << m_numLoadedSections << " sections loaded, "
+            << m_level.getNumActiveBodies() << " active bodies" << std::endl;
+    }
+
     //Update the physics simulation
     float timeStep = 1.0f / 60.0f;
     int subStepCount = 4;
@@ -99,7 +93,6 @@ void GameplayScreen::update() {
 }
 
 void GameplayScreen::draw() {
-    std::cout << "Draw\n";
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glClearColor(0.4f, 0.4f, 0.8f, 1.0f);
 
@@ -117,10 +110,8 @@ void GameplayScreen::draw() {
 
     m_spriteBatch.begin();
 
-    // Draw all the boxes
-    for (auto& b : m_boxes) {
-        b.draw(m_spriteBatch);
-    }
+    // Draw the loaded part of the level
+    m_level.draw(m_spriteBatch);
 
     m_player.draw(m_spriteBatch);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Box.h"
+#include "Level.h"
 #include "Player.h"
 #include <Box2D/box2d.h>
 #include <Bengine/IGameScreen.h>
@@ -43,9 +44,9 @@ private:
     Bengine::Window* m_window;
 
     Player m_player;
-    std::vector<Box> m_boxes;
+    Level m_level;
+    int m_numLoadedSections = 0; // Last count logged, to report when streaming changes it
     b2WorldId m_world = b2_nullWorldId;
-    b2BodyId m_ground = b2_nullBodyId;
 
     DebugDraw m_debugDraw;
     bool m_debugRenderEnabled = false;
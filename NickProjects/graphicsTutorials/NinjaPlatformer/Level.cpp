@@ -0,0 +1,286 @@
+#include "Level.h"
+
+#include <Bengine/BengineErrors.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    // Rows in the file go top to bottom but y goes up in the world, so tile y 0 is the
+    // last row. Anything past the end of a short row is empty.
+    char getTile(const std::vector<std::string>& rows, int x, int y) {
+        const std::string& row = rows[rows.size() - 1 - y];
+        if (x >= static_cast<int>(row.size())) {
+            return '.';
+        }
+        return row[x];
+    }
+
+    float getDistanceToSpan(float x, float minX, float maxX) {
+        return std::max(std::max(minX - x, x - maxX), 0.0f);
+    }
+}
+
+Level::Level() {
+
+}
+
+Level::~Level() {
+
+}
+
+void Level::load(const std::string& filePath) {
+    std::ifstream file;
+    file.open(filePath);
+
+    // Error checking
+    if (file.fail()) {
+        Bengine::fatalError("Failed to open " + filePath);
+    }
+
+    // Read the level data
+    std::vector<std::string> rows;
+    std::string tmp;
+    while (std::getline(file, tmp)) {
+        if (!tmp.empty() && tmp.back() == '\r') {
+            tmp.pop_back();
+        }
+        rows.push_back(tmp);
+    }
+    if (rows.empty()) {
+        Bengine::fatalError("No tiles in " + filePath);
+    }
+
+    int width = 0;
+    for (const std::string& row : rows) {
+        width = std::max(width, static_cast<int>(row.size()));
+    }
+    const int height = static_cast<int>(rows.size());
+
+    m_sections.clear();
+    m_numLoadedSections = 0;
+    const int numSections = (width + SECTION_COLUMNS - 1) / SECTION_COLUMNS;
+    m_sections.resize(numSections);
+
+    for (int s = 0; s < numSections; s++) {
+        Section& section = m_sections[s];
+        const int firstColumn = s * SECTION_COLUMNS;
+        const int endColumn = std::min(firstColumn + SECTION_COLUMNS, width);
+        section.minX = LEVEL_ORIGIN.x + firstColumn * TILE_SIZE;
+        section.maxX = LEVEL_ORIGIN.x + endColumn * TILE_SIZE;
+
+        for (int y = 0; y < height; y++) {
+            for (int x = firstColumn; x < endColumn; x++) {
+                const glm::vec2 tilePos = LEVEL_ORIGIN + glm::vec2(x, y) * TILE_SIZE;
+                switch (getTile(rows, x, y)) {
+                    case '#':
+                        section.groundTiles.emplace_back(tilePos.x, tilePos.y, TILE_SIZE, TILE_SIZE);
+                        break;
+                    case 'B':
+                        section.props.push_back({ tilePos + glm::vec2(TILE_SIZE * 0.5f), 0.0f, false });
+                        break;
+                    case '@':
+                        m_startPlayerPos = tilePos + glm::vec2(TILE_SIZE * 0.5f, 0.0f);
+                        break;
+                    case '.':
+                        break;
+                    default:
+                        std::printf("Unexpected symbol %c at (%d,%d)\n", getTile(rows, x, y), x, y);
+                        break;
+                }
+            }
+        }
+
+        mergeGround(rows, firstColumn, endColumn, section);
+    }
+
+    size_t numTiles = 0;
+    size_t numRects = 0;
+    for (const Section& section : m_sections) {
+        numTiles += section.groundTiles.size();
+        numRects += section.groundRects.size();
+    }
+    std::cout << "Loaded " << filePath << ": " << numSections << " sections, "
+        << numTiles << " ground tiles merged into " << numRects << " boxes" << std::endl;
+}
+
+void Level::mergeGround(const std::vector<std::string>& rows, int firstColumn, int endColumn, Section& section) {
+    const int width = endColumn - firstColumn;
+    const int height = static_cast<int>(rows.size());
+    std::vector<bool> merged(width * height, false);
+
+    auto isFree = [&](int x, int y) {
+        return getTile(rows, x, y) == '#' && !merged[y * width + (x - firstColumn)];
+    };
+
+    // Grow each rectangle along the row as far as it goes, then up for as long as the
+    // whole run above is ground too. Keeps the body count to a handful per section,
+    // and fewer seams for the player to catch on. Rectangles still stop at the section's
+    // edge, so there is a seam every SECTION_COLUMNS columns where two sections meet.
+    for (int y = 0; y < height; y++) {
+        for (int x = firstColumn; x < endColumn; x++) {
+            if (!isFree(x, y)) {
+                continue;
+            }
+            int endX = x + 1;
+            while (endX < endColumn && isFree(endX, y)) {
+                endX++;
+            }
+            int endY = y + 1;
+            while (endY < height) {
+                bool isRowFree = true;
+                for (int i = x; i < endX; i++) {
+                    if (!isFree(i, endY)) {
+                        isRowFree = false;
+                        break;
+                    }
+                }
+                if (!isRowFree) {
+                    break;
+                }
+                endY++;
+            }
+
+            for (int j = y; j < endY; j++) {
+                for (int i = x; i < endX; i++) {
+                    merged[j * width + (i - firstColumn)] = true;
+                }
+            }
+            section.groundRects.emplace_back(LEVEL_ORIGIN.x + x * TILE_SIZE, LEVEL_ORIGIN.y + y * TILE_SIZE,
+                (endX - x) * TILE_SIZE, (endY - y) * TILE_SIZE);
+        }
+    }
+}
+
+void Level::init(b2WorldId* world, Bengine::GLTexture texture, Bengine::ColorRGBA8 color) {
+    m_world = world;
+    m_texture = texture;
+    m_color = color;
+    update(m_startPlayerPos);
+}
+
+void Level::update(const glm::vec2& playerPosition) {
+    // Boxes get pushed across section edges, so each one moves to the section it's over
+    // now. Otherwise it would unload with the ground it started on, or keep falling once
+    // the ground under it is gone.
+    for (Section& section : m_sections) {
+        if (!section.isLoaded) {
+            continue;
+        }
+        for (size_t i = 0; i < section.boxes.size();) {
+            Section& owner = getSectionAt(section.boxes[i].getPosition().x);
+            if (&owner == &section) {
+                i++;
+                continue;
+            }
+            moveBox(section.boxes[i], owner);
+            section.boxes[i] = section.boxes.back();
+            section.boxes.pop_back();
+        }
+    }
+
+    for (Section& section : m_sections) {
+        float distance = getDistanceToSpan(playerPosition.x, section.minX, section.maxX);
+        if (!section.isLoaded && distance < STREAM_DISTANCE) {
+            loadSection(section);
+        } else if (section.isLoaded && distance > STREAM_DISTANCE + STREAM_HYSTERESIS) {
+            unloadSection(section);
+        }
+    }
+}
+
+void Level::draw(Bengine::SpriteBatch& spriteBatch) {
+    const glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
+    for (Section& section : m_sections) {
+        if (!section.isLoaded) {
+            continue;
+        }
+        for (const glm::vec4& destRect : section.groundTiles) {
+            spriteBatch.draw(destRect, uvRect, m_texture.id, 0.0f, m_color, 0.0f);
+        }
+        for (Box& box : section.boxes) {
+            box.draw(spriteBatch);
+        }
+    }
+}
+
+int Level::getNumActiveBodies() const {
+    int numBodies = 0;
+    for (const Section& section : m_sections) {
+        if (section.isLoaded) {
+            numBodies += static_cast<int>(section.boxes.size());
+            if (!section.groundRects.empty()) {
+                numBodies++;
+            }
+        }
+    }
+    return numBodies;
+}
+
+void Level::loadSection(Section& section) {
+    section.isLoaded = true;
+    m_numLoadedSections++;
+
+    // All of the section's ground is one static body, with a box shape per merged rectangle
+    if (!section.groundRects.empty()) {
+        b2BodyDef groundBodyDef = b2DefaultBodyDef();
+        groundBodyDef.position = b2Vec2(section.minX, LEVEL_ORIGIN.y);
+        section.groundBody = b2CreateBody(*m_world, &groundBodyDef);
+
+        b2ShapeDef groundShapeDef = b2DefaultShapeDef();
+        groundShapeDef.density = 1.0f;
+        groundShapeDef.friction = 0.2f;
+        for (const glm::vec4& rect : section.groundRects) {
+            b2Vec2 center = b2Vec2(rect.x + rect.z * 0.5f - section.minX, rect.y + rect.w * 0.5f - LEVEL_ORIGIN.y);
+            b2Polygon groundBox = b2MakeOffsetBox(rect.z * 0.5f, rect.w * 0.5f, center, b2Rot_identity);
+            b2CreatePolygonShape(section.groundBody, &groundShapeDef, &groundBox);
+        }
+    }
+
+    for (const Prop& prop : section.props) {
+        spawnBox(section, prop);
+    }
+    section.props.clear();
+}
+
+void Level::unloadSection(Section& section) {
+    section.isLoaded = false;
+    m_numLoadedSections--;
+
+    if (B2_IS_NON_NULL(section.groundBody)) {
+        b2DestroyBody(section.groundBody);
+        section.groundBody = b2_nullBodyId;
+    }
+
+    std::vector<Box> boxes;
+    boxes.swap(section.boxes);
+    for (Box& box : boxes) {
+        moveBox(box, getSectionAt(box.getPosition().x));
+    }
+}
+
+void Level::moveBox(Box& box, Section& owner) {
+    if (owner.isLoaded) {
+        owner.boxes.push_back(box);
+        return;
+    }
+    // Nothing to stand on in there, so it waits as a prop until the section loads
+    b2Vec2 position = box.getPosition();
+    owner.props.push_back({ glm::vec2(position.x, position.y), b2Rot_GetAngle(b2Body_GetRotation(box.getID())), b2Body_IsAwake(box.getID()) });
+    box.destroy();
+}
+
+void Level::spawnBox(Section& section, const Prop& prop) {
+    // Props start asleep unless they were moving when they unloaded, so a pile of boxes
+    // costs nothing to simulate until something bumps into it
+    Box box;
+    box.init(m_world, prop.position, glm::vec2(TILE_SIZE), m_texture, m_color, false, prop.isAwake, prop.angle);
+    section.boxes.push_back(box);
+}
+
+Level::Section& Level::getSectionAt(float x) {
+    int index = static_cast<int>(std::floor((x - LEVEL_ORIGIN.x) / (SECTION_COLUMNS * TILE_SIZE)));
+    index = std::min(std::max(index, 0), static_cast<int>(m_sections.size()) - 1);
+    return m_sections[index];
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Box.h"
+#include <Box2D/box2d.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include <Bengine/SpriteBatch.h>
+#include <Bengine/GLTexture.h>
+
+const float TILE_SIZE = 3.0f;
+// Bottom left corner of the level in world units, keeps the start in front of the camera
+const glm::vec2 LEVEL_ORIGIN(-51.0f, -60.0f);
+
+// A platformer stage loaded from a text file. '#' is ground, 'B' a box that can be
+// pushed around and '@' where the player starts. The stage is cut into sections a
+// fixed number of columns wide, and only sections near the player have bodies.
+class Level
+{
+public:
+    Level();
+    ~Level();
+
+    // Reads the tiles and merges each section's ground into as few boxes as possible.
+    // Doesn't create any bodies yet.
+    void load(const std::string& filePath);
+
+    // Sets what the sections are created in and drawn with, then loads the ones around
+    // the player start
+    void init(b2WorldId* world, Bengine::GLTexture texture, Bengine::ColorRGBA8 color);
+
+    // Creates the sections that came within range of the player and destroys the ones
+    // that moved out of range
+    void update(const glm::vec2& playerPosition);
+
+    // Draws the loaded sections, which always cover the screen around the player
+    void draw(Bengine::SpriteBatch& spriteBatch);
+
+    // Bottom middle of the '@' tile, where the player's feet go
+    glm::vec2 getStartPlayerPos() const { return m_startPlayerPos; }
+    int getNumLoadedSections() const { return m_numLoadedSections; }
+    int getNumActiveBodies() const;
+
+private:
+    static const int SECTION_COLUMNS = 32;
+    // Sections load once their nearest edge is this close to the player, and unload
+    // once it's STREAM_HYSTERESIS further, so walking along an edge doesn't thrash
+    static constexpr float STREAM_DISTANCE = 150.0f;
+    static constexpr float STREAM_HYSTERESIS = 30.0f;
+
+    struct Prop {
+        glm::vec2 position;
+        float angle;
+        bool isAwake;
+    };
+
+    struct Section {
+        float minX;
+        float maxX;
+        std::vector<glm::vec4> groundRects; // Merged ground, x y width height
+        std::vector<glm::vec4> groundTiles; // Every ground tile, for drawing
+        std::vector<Prop> props;            // Boxes in this section while it isn't loaded
+        std::vector<Box> boxes;             // Boxes in this section while it is
+        b2BodyId groundBody = b2_nullBodyId;
+        bool isLoaded = false;
+    };
+
+    void loadSection(Section& section);
+    void unloadSection(Section& section);
+    void spawnBox(Section& section, const Prop& prop);
+    // Hands a box with a body to owner, which keeps the body if it's loaded and turns
+    // it back into a prop if not
+    void moveBox(Box& box, Section& owner);
+    Section& getSectionAt(float x);
+
+    // Greedily merges the ground tiles of columns [firstColumn, endColumn) into rectangles
+    void mergeGround(const std::vector<std::string>& rows, int firstColumn, int endColumn, Section& section);
+
+    std::vector<Section> m_sections;
+    int m_numLoadedSections = 0;
+    glm::vec2 m_startPlayerPos = glm::vec2(0.0f);
+
+    b2WorldId* m_world = nullptr;
+    Bengine::GLTexture m_texture;
+    Bengine::ColorRGBA8 m_color;
+};
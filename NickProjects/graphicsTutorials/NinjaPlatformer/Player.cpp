@@ -41,12 +41,17 @@ void Player::update(Bengine::InputManager& inputManager) {
     int contactCount = b2Body_GetContactData(getID(), contacts, 8);
 
     for (int i = 0; i < contactCount; ++i) {
-        // Get the shape IDs from the contact
-        b2ShapeId shape1 = contacts[i].shapeIdA;
-        b2ShapeId shape2 = contacts[i].shapeIdB;
-
-        // Check if either shape is the ground shape
-        if (B2_ID_EQUALS(shape1, m_groundShapeId) || B2_ID_EQUALS(shape2, m_groundShapeId)) {
+        if (contacts[i].manifold.pointCount == 0) {
+            continue;
+        }
+        // The normal points from shape A to shape B, so flip it when we're shape A to get
+        // the push on the player. Anything pushing up counts as ground, so level pieces
+        // and boxes all work without the player knowing about them.
+        float normalY = contacts[i].manifold.normal.y;
+        if (B2_ID_EQUALS(b2Shape_GetBody(contacts[i].shapeIdA), getID())) {
+            normalY = -normalY;
+        }
+        if (normalY > 0.5f) {
             m_isGrounded = true;
             break;
         }
@@ -610,7 +610,9 @@ void BlockManager::generateChunk(int chunkX, int chunkY, Chunk& chunk) {
     }
 
     // Create a 2D grid to map ore positions directly
-    std::vector<std::vector<BlockID>> oreMap(CHUNK_WIDTH, std::vector<BlockID>(CHUNK_WIDTH, BlockID::COUNT));
+    // Lives on the stack, this runs for every generated chunk
+    BlockID oreMap[CHUNK_WIDTH][CHUNK_WIDTH];
+    std::fill(&oreMap[0][0], &oreMap[0][0] + CHUNK_WIDTH * CHUNK_WIDTH, BlockID::COUNT);
 
     // Generate ore veins and directly mark affected blocks in the oreMap
     PROFILE_SCOPE("generateChunk: ChunkOreVeins");